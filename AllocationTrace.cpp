@@ -0,0 +1,214 @@
+#include "AllocationTrace.hpp"
+#include "MemoryUtility.hpp"
+#include <fstream>
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	namespace
+	{
+		struct FileHeader
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint64_t eventCount;
+		};
+	}
+
+	static_assert(sizeof(AllocationEvent) == 24, "AllocationEvent is part of the file format");
+
+	/////////// AllocationTrace /////////////
+
+	AllocationTrace::AllocationTrace()
+		: mEvents(), mBlockCount(0)
+	{}
+
+	AllocationTrace::~AllocationTrace()
+	{}
+
+	void AllocationTrace::Add(const AllocationEvent& event)
+	{
+		mEvents.push_back(event);
+
+		if (AllocationEvent::ALLOCATE == event.type)
+		{
+			mBlockCount = std::max(mBlockCount, (std::size_t)event.id + 1);
+		}
+	}
+
+	void AllocationTrace::Clear()
+	{
+		mEvents.clear();
+		mBlockCount = 0;
+	}
+
+	const std::vector<AllocationEvent>& AllocationTrace::Events() const
+	{
+		return mEvents;
+	}
+
+	std::size_t AllocationTrace::Size() const
+	{
+		return mEvents.size();
+	}
+
+	std::size_t AllocationTrace::BlockCount() const
+	{
+		return mBlockCount;
+	}
+
+	bool AllocationTrace::Save(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (false == file.is_open())
+		{
+			return false;
+		}
+
+		FileHeader header;
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.eventCount = mEvents.size();
+
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)mEvents.data(), mEvents.size() * sizeof(AllocationEvent));
+
+		return file.good();
+	}
+
+	bool AllocationTrace::Load(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (false == file.is_open())
+		{
+			return false;
+		}
+
+		FileHeader header;
+		if (false == file.read((char*)&header, sizeof(header)).good() ||
+			FILE_MAGIC != header.magic || FILE_VERSION != header.version)
+		{
+			return false;
+		}
+
+		std::vector<AllocationEvent> events(header.eventCount);
+		if (false == file.read((char*)events.data(), events.size() * sizeof(AllocationEvent)).good())
+		{
+			return false;
+		}
+
+		Clear();
+		mEvents.reserve(events.size());
+		for (const AllocationEvent& event : events)
+		{
+			Add(event);
+		}
+
+		return true;
+	}
+
+	std::size_t AllocationTrace::Alignment(const AllocationEvent& event)
+	{
+		return (0 == event.alignmentLog2) ? 0 : ((std::size_t)1 << event.alignmentLog2);
+	}
+
+	/////////// TracingAllocator /////////////
+
+	TracingAllocator::TracingAllocator(Allocator& allocator, AllocationTrace& trace)
+		: Allocator(allocator.TotalSize()), mAllocator(allocator), mTrace(trace), mMutex()
+		, mLiveBlocks(), mThreads(), mNextId(0), mStartTime(std::chrono::steady_clock::now())
+	{}
+
+	TracingAllocator::~TracingAllocator()
+	{}
+
+	void TracingAllocator::Init()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mAllocator.Init();
+		mLiveBlocks.clear();
+		UpdateStatistics();
+	}
+
+	void TracingAllocator::Reset()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mAllocator.Reset();
+		mLiveBlocks.clear();
+		UpdateStatistics();
+
+		// every live block is gone, the replay has to reset too
+		Record(AllocationEvent::RESET, 0, 0, 0);
+	}
+
+	void* TracingAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		void* ptr = mAllocator.Allocate(size, alignment);
+		UpdateStatistics();
+
+		// failed allocations are not recorded, there is nothing to free later
+		if (ptr)
+		{
+			const LiveBlock block = { mNextId++, (std::uint32_t)size };
+			mLiveBlocks[ptr] = block;
+
+			Record(AllocationEvent::ALLOCATE, block.id, block.size, alignment);
+		}
+
+		return ptr;
+	}
+
+	void TracingAllocator::Free(void* ptr)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mAllocator.Free(ptr);
+		UpdateStatistics();
+
+		auto it = mLiveBlocks.find(ptr);
+		if (it != mLiveBlocks.end())
+		{
+			Record(AllocationEvent::FREE, it->second.id, it->second.size, 0);
+			mLiveBlocks.erase(it);
+		}
+	}
+
+	float TracingAllocator::Fragmentation()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		return mAllocator.Fragmentation();
+	}
+
+	void TracingAllocator::Record(const AllocationEvent::Type type, const std::uint32_t id, const std::uint32_t size, const std::size_t alignment)
+	{
+		// threads are numbered in order of appearance
+		const std::thread::id threadId = std::this_thread::get_id();
+		auto it = mThreads.find(threadId);
+		if (it == mThreads.end())
+		{
+			it = mThreads.emplace(threadId, (std::uint16_t)mThreads.size()).first;
+		}
+
+		AllocationEvent event;
+		event.timestamp = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStartTime).count();
+		event.id = id;
+		event.size = size;
+		event.thread = it->second;
+		event.alignmentLog2 = (alignment > 1) ? (std::uint8_t)SDA::Log2(alignment) : 0;
+		event.type = type;
+
+		mTrace.Add(event);
+	}
+
+	void TracingAllocator::UpdateStatistics()
+	{
+		mUsed = mAllocator.Used();
+		mPeak = mAllocator.Peak();
+	}
+}
@@ -0,0 +1,124 @@
+#ifndef ALLOCATION_TRACE_HPP
+#define ALLOCATION_TRACE_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <cstdint> // fixed size types for the binary log
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <chrono>
+#include <mutex>
+
+/*
+AllocationTrace - a log of Allocate()/Free()/Reset() calls which can be saved to a compact
+binary file and replayed later against any allocator with MemoryBenchmark::Replay().
+
+TracingAllocator - records every call made through it in an AllocationTrace and forwards it
+to the wrapped allocator (not owned). Recording is guarded by a mutex, so it can be used
+from several threads, but it is meant for capturing traces, not for benchmarking.
+
+FILE FORMAT:
+- header: "SDAT" magic, version, event count
+- events: AllocationEvent records, 24 bytes each, little endian as written by the machine
+
+USAGES:
+	SDA::AllocationTrace trace;
+	SDA::TracingAllocator tracingAllocator(productionAllocator, trace);
+	... run the workload with tracingAllocator ...
+	trace.Save("workload.trace");
+
+	SDA::AllocationTrace loadedTrace;
+	loadedTrace.Load("workload.trace");
+	benchmark.Replay(freeListAllocator, loadedTrace);
+*/
+
+namespace SDA
+{
+	struct AllocationEvent
+	{
+		enum Type : std::uint8_t
+		{
+			ALLOCATE = 0,
+			FREE,
+			RESET
+		};
+
+		std::uint64_t timestamp; // nanoseconds since the start of the trace
+		std::uint32_t id; // the same for the Allocate() and the Free() of a block
+		std::uint32_t size;
+		std::uint16_t thread; // threads are numbered in order of appearance
+		std::uint8_t alignmentLog2; // alignment = 1 << alignmentLog2, 0 means no alignment
+		std::uint8_t type;
+	};
+
+	class AllocationTrace
+	{
+	public:
+		AllocationTrace();
+		virtual ~AllocationTrace();
+
+		void Add(const AllocationEvent& event);
+		void Clear();
+
+		const std::vector<AllocationEvent>& Events() const;
+		std::size_t Size() const;
+		// number of distinct block ids, needed by the replay to map ids to pointers
+		std::size_t BlockCount() const;
+
+		// return false if the file can't be written/read or it is not a trace
+		bool Save(const std::string& path) const;
+		bool Load(const std::string& path);
+
+		static std::size_t Alignment(const AllocationEvent& event);
+
+	private:
+		NON_COPY_AND_MOVE(AllocationTrace)
+
+		std::vector<AllocationEvent> mEvents;
+		std::size_t mBlockCount;
+
+		static const std::uint32_t FILE_MAGIC = 0x54414453; // "SDAT"
+		static const std::uint32_t FILE_VERSION = 1;
+	};
+
+	class TracingAllocator : public Allocator
+	{
+	public:
+		TracingAllocator(Allocator& allocator, AllocationTrace& trace);
+		virtual ~TracingAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		float Fragmentation();
+
+	private:
+		NON_COPY_AND_MOVE(TracingAllocator)
+
+		struct LiveBlock
+		{
+			std::uint32_t id;
+			std::uint32_t size;
+		};
+
+		// called under lock
+		void Record(const AllocationEvent::Type type, const std::uint32_t id, const std::uint32_t size, const std::size_t alignment);
+		void UpdateStatistics();
+
+		Allocator& mAllocator;
+		AllocationTrace& mTrace;
+		std::mutex mMutex;
+
+		std::unordered_map<void*, LiveBlock> mLiveBlocks;
+		std::unordered_map<std::thread::id, std::uint16_t> mThreads;
+		std::uint32_t mNextId;
+		std::chrono::steady_clock::time_point mStartTime;
+	};
+}
+
+#endif /* ALLOCATION_TRACE_HPP */
\ No newline at end of file
@@ -32,8 +32,12 @@ namespace SDA
 		}
 
 		std::size_t TotalSize() { return mTotalSize; }
-		std::size_t Used() { return mUsed; }
-		std::size_t Peak() { return mPeak; }
+		// virtual so the concurrent allocators can keep them in atomics
+		virtual std::size_t Used() { return mUsed; }
+		virtual std::size_t Peak() { return mPeak; }
+
+		// 0 = all the free memory is in one block, close to 1 = free memory is scattered in small blocks
+		virtual float Fragmentation() { return 0.0f; }
 
 		virtual void Init() = 0;
 		virtual void Reset() = 0;
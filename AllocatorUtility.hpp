@@ -0,0 +1,245 @@
+#ifndef ALLOCATOR_UTILITY_HPP
+#define ALLOCATOR_UTILITY_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <cstdint> // SIZE_MAX
+#include <new> // operator new, placement new, bad_alloc, bad_array_new_length
+#include <utility> // std::forward()
+#include <type_traits>
+#include <cstdlib> // malloc(), realloc(), free()
+#include <cstring> // memcpy()
+
+/*
+Helpers used by the containers to create their buffers and nodes through an Allocator.
+A nullptr allocator means the global heap (operator new/delete).
+If the allocator runs out of memory std::bad_alloc is thrown, like new does.
+*/
+
+namespace SDA
+{
+	inline void* AllocateMemory(Allocator* allocator, const std::size_t size, const std::size_t alignment)
+	{
+		if (nullptr == allocator)
+		{
+#ifdef __cpp_aligned_new
+			if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				return ::operator new(size, std::align_val_t(alignment));
+			}
+#endif
+
+			return ::operator new(size);
+		}
+
+		void* ptr = allocator->Allocate(size, alignment);
+		if (nullptr == ptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return ptr;
+	}
+
+	inline void FreeMemory(Allocator* allocator, void* ptr, const std::size_t alignment)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		if (nullptr == allocator)
+		{
+#ifdef __cpp_aligned_new
+			if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				::operator delete(ptr, std::align_val_t(alignment));
+				return;
+			}
+#endif
+
+			::operator delete(ptr);
+			return;
+		}
+
+		allocator->Free(ptr);
+	}
+
+	/* creates one object, like new T(args...) */
+	template <class T, class... Args>
+	T* New(Allocator* allocator, Args&&... args)
+	{
+		void* ptr = AllocateMemory(allocator, sizeof(T), alignof(T));
+
+		try
+		{
+			return new (ptr) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			FreeMemory(allocator, ptr, alignof(T));
+			throw;
+		}
+	}
+
+	/* destroys one object created with New() */
+	template <class T>
+	void Delete(Allocator* allocator, T* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		ptr->~T();
+		FreeMemory(allocator, ptr, alignof(T));
+	}
+
+	/* the bytes of count objects, throws std::bad_array_new_length like new T[count] when they don't fit in size_t */
+	template <class T>
+	std::size_t ArraySize(const std::size_t count)
+	{
+		if (count > SIZE_MAX / sizeof(T))
+		{
+			throw std::bad_array_new_length();
+		}
+
+		return count * sizeof(T);
+	}
+
+	/* creates an array of default constructed objects, like new T[count] */
+	template <class T>
+	T* NewArray(Allocator* allocator, const std::size_t count)
+	{
+		if (0 == count)
+		{
+			return nullptr;
+		}
+
+		T* ptr = static_cast<T*>(AllocateMemory(allocator, ArraySize<T>(count), alignof(T)));
+
+		std::size_t i = 0;
+		try
+		{
+			for (; i < count; ++i)
+			{
+				new (ptr + i) T();
+			}
+		}
+		catch (...)
+		{
+			// destroy what was created so far
+			while (i > 0)
+			{
+				ptr[--i].~T();
+			}
+			FreeMemory(allocator, ptr, alignof(T));
+			throw;
+		}
+
+		return ptr;
+	}
+
+	/* destroys an array created with NewArray() */
+	template <class T>
+	void DeleteArray(Allocator* allocator, T* ptr, const std::size_t count)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ptr[i].~T();
+		}
+		FreeMemory(allocator, ptr, alignof(T));
+	}
+
+	/* the global heap arrays go through malloc(), so they can grow with realloc() */
+	template <class T>
+	constexpr bool UsesCHeap(Allocator* allocator)
+	{
+		return (nullptr == allocator) && (alignof(T) <= alignof(std::max_align_t));
+	}
+
+	/* raw memory for count objects, nothing is constructed (the containers use placement new) */
+	template <class T>
+	T* AllocateArray(Allocator* allocator, const std::size_t count)
+	{
+		if (0 == count)
+		{
+			return nullptr;
+		}
+
+		if (UsesCHeap<T>(allocator))
+		{
+			void* ptr = std::malloc(ArraySize<T>(count));
+			if (nullptr == ptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<T*>(ptr);
+		}
+
+		return static_cast<T*>(AllocateMemory(allocator, ArraySize<T>(count), alignof(T)));
+	}
+
+	/* frees memory from AllocateArray(), the objects must be destroyed before */
+	template <class T>
+	void FreeArray(Allocator* allocator, T* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		if (UsesCHeap<T>(allocator))
+		{
+			std::free(ptr);
+			return;
+		}
+
+		FreeMemory(allocator, ptr, alignof(T));
+	}
+
+	/*
+	   grows memory from AllocateArray() holding count trivially copyable objects to newCount objects.
+	   The global heap may extend the block in place or remap its pages (realloc()),
+	   an Allocator has no realloc, so the objects are copied with one memcpy().
+	*/
+	template <class T>
+	T* ReallocateArray(Allocator* allocator, T* ptr, const std::size_t count, const std::size_t newCount)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "memcpy() relocation needs a trivially copyable type");
+
+		if (0 == newCount)
+		{
+			FreeArray(allocator, ptr);
+			return nullptr;
+		}
+
+		if (UsesCHeap<T>(allocator))
+		{
+			void* newPtr = std::realloc(ptr, ArraySize<T>(newCount));
+			if (nullptr == newPtr)
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<T*>(newPtr);
+		}
+
+		T* newPtr = AllocateArray<T>(allocator, newCount);
+		if (ptr)
+		{
+			std::memcpy(newPtr, ptr, (count < newCount ? count : newCount) * sizeof(T));
+			FreeArray(allocator, ptr);
+		}
+
+		return newPtr;
+	}
+}
+
+#endif /* ALLOCATOR_UTILITY_HPP */
\ No newline at end of file
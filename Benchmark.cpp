@@ -0,0 +1,549 @@
+#include "Benchmark.hpp"
+#include "Clock.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <regex>
+#include <algorithm> // sort, max
+#include <cmath> // abs
+#include <cstdlib> // strtoull
+#include <cstring> // strncmp
+#include <ctime>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h> // sched_setaffinity()
+#endif
+
+namespace SDA
+{
+	namespace
+	{
+		// a benchmark that never calls KeepRunning() would grow forever
+		const std::size_t MAX_ITERATION_COUNT = 1000000000;
+
+		struct Benchmark
+		{
+			std::string name;
+			BenchmarkFunc func;
+		};
+
+		struct BenchmarkOptions
+		{
+			BenchmarkOptions()
+				: filter(".*"), sizes(), cpu(-1), jsonPath(), minTime(50), repetitionCount(5), isList(false)
+			{
+				sizes.push_back(16);
+				sizes.push_back(1024);
+				sizes.push_back(65536);
+			}
+
+			std::string filter;
+			std::vector<std::size_t> sizes;
+			int cpu;
+			std::string jsonPath;
+			std::uint64_t minTime; // miliseconds
+			std::size_t repetitionCount;
+			bool isList;
+		};
+
+		struct BenchmarkResult
+		{
+			std::string name;
+			std::size_t size;
+			std::size_t iterationCount;
+			std::size_t itemsPerIteration;
+			std::vector<double> timePerIteration; // nanoseconds, one per repetition
+			double medianTimePerIteration;
+			double madTimePerIteration;
+			std::string skipReason;
+			LatencyHistogram latencies; // of the repetitions, empty if the benchmark records none
+		};
+
+		// registered by static variables, so it has to be created on first use
+		std::vector<Benchmark>& Benchmarks()
+		{
+			static std::vector<Benchmark> benchmarks;
+
+			return benchmarks;
+		}
+
+		double Median(std::vector<double> values)
+		{
+			if (values.empty())
+			{
+				return 0.0;
+			}
+
+			std::sort(values.begin(), values.end());
+
+			const std::size_t middle = values.size() / 2;
+			return (values.size() % 2) ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+		}
+
+		// median absolute deviation
+		double MAD(const std::vector<double>& values, const double median)
+		{
+			std::vector<double> deviations;
+			deviations.reserve(values.size());
+			for (const double value : values)
+			{
+				deviations.push_back(std::abs(value - median));
+			}
+
+			return Median(deviations);
+		}
+
+		std::string EscapeJSON(const std::string& text)
+		{
+			std::string escaped;
+			for (const char c : text)
+			{
+				if ('"' == c || '\\' == c)
+				{
+					escaped += '\\';
+				}
+				escaped += c;
+			}
+
+			return escaped;
+		}
+
+		// "--name=value", returns false if the argument is not this option
+		bool ParseOption(const char* argument, const char* name, std::string& value)
+		{
+			const std::size_t length = strlen(name);
+			if (0 != strncmp(argument, name, length) || '=' != argument[length])
+			{
+				return false;
+			}
+
+			value = argument + length + 1;
+			return true;
+		}
+
+		bool ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+		{
+			for (int index = 1; index < argc; ++index)
+			{
+				const char* argument = argv[index];
+				std::string value;
+
+				if (ParseOption(argument, "--filter", value))
+				{
+					options.filter = value;
+				}
+				else if (ParseOption(argument, "--sizes", value))
+				{
+					options.sizes.clear();
+
+					std::stringstream stream(value);
+					std::string size;
+					while (std::getline(stream, size, ','))
+					{
+						options.sizes.push_back((std::size_t)strtoull(size.c_str(), nullptr, 10));
+					}
+				}
+				else if (ParseOption(argument, "--cpu", value))
+				{
+					options.cpu = atoi(value.c_str());
+				}
+				else if (ParseOption(argument, "--json", value))
+				{
+					options.jsonPath = value;
+				}
+				else if (ParseOption(argument, "--min-time", value))
+				{
+					options.minTime = strtoull(value.c_str(), nullptr, 10);
+				}
+				else if (ParseOption(argument, "--repetitions", value))
+				{
+					options.repetitionCount = std::max((std::size_t)1, (std::size_t)strtoull(value.c_str(), nullptr, 10));
+				}
+				else if (0 == strcmp(argument, "--list"))
+				{
+					options.isList = true;
+				}
+				else
+				{
+					std::cout << "Usage: " << argv[0] << " [--filter=<regex>] [--sizes=16,1024,...] [--cpu=<index>]"
+						<< " [--json=<path>] [--min-time=<ms>] [--repetitions=<count>] [--list]" << std::endl;
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool PinToCpu(const int cpu)
+		{
+#ifdef _WIN32
+			return 0 != SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+#elif defined(__linux__)
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(cpu, &cpuSet);
+
+			return 0 == sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+#else
+			// not supported (e.g. macOS has only affinity hints)
+			return false;
+#endif
+		}
+
+		// returns the elapsed time in nanoseconds
+		std::uint64_t RunOnce(const Benchmark& benchmark, const std::size_t size, const std::size_t iterationCount, BenchmarkResult& result)
+		{
+			BenchmarkState state(size, iterationCount);
+			benchmark.func(state);
+
+			result.itemsPerIteration = state.ItemsPerIteration();
+			result.latencies.Merge(state.Latencies());
+			if (state.IsSkipped())
+			{
+				result.skipReason = state.SkipReason();
+			}
+
+			return state.ElapsedTime();
+		}
+
+		void Run(const Benchmark& benchmark, const std::size_t size, const BenchmarkOptions& options, BenchmarkResult& result)
+		{
+			result.name = benchmark.name;
+			result.size = size;
+			result.iterationCount = 1;
+			result.itemsPerIteration = 0;
+			result.medianTimePerIteration = 0.0;
+			result.madTimePerIteration = 0.0;
+
+			// grow the iteration count until a run lasts the min time (also the warmup)
+			const std::uint64_t minTime = options.minTime * 1000000;
+			for (;;)
+			{
+				const std::uint64_t elapsedTime = RunOnce(benchmark, size, result.iterationCount, result);
+				if (false == result.skipReason.empty())
+				{
+					return;
+				}
+
+				if (elapsedTime >= minTime || result.iterationCount >= MAX_ITERATION_COUNT)
+				{
+					break;
+				}
+
+				// aim a bit above the min time, but never more than 10 times more iterations
+				const double scale = (elapsedTime > 0) ? 1.2 * (double)minTime / (double)elapsedTime : 10.0;
+				result.iterationCount = (std::size_t)((double)result.iterationCount * std::min(std::max(scale, 1.5), 10.0));
+			}
+
+			// only the repetitions are reported, not the warmup
+			result.latencies.Reset();
+
+			for (std::size_t repetition = 0; repetition < options.repetitionCount; ++repetition)
+			{
+				const std::uint64_t elapsedTime = RunOnce(benchmark, size, result.iterationCount, result);
+				result.timePerIteration.push_back((double)elapsedTime / (double)result.iterationCount);
+			}
+
+			result.medianTimePerIteration = Median(result.timePerIteration);
+			result.madTimePerIteration = MAD(result.timePerIteration, result.medianTimePerIteration);
+		}
+
+		void PrintResult(const BenchmarkResult& result)
+		{
+			std::stringstream name;
+			name << result.name << "/" << result.size;
+
+			std::cout << std::left << std::setw(48) << name.str() << std::right;
+			if (false == result.skipReason.empty())
+			{
+				std::cout << "skipped: " << result.skipReason << std::endl;
+				return;
+			}
+
+			std::cout << std::fixed << std::setprecision(1)
+				<< std::setw(16) << result.medianTimePerIteration
+				<< std::setw(12) << result.madTimePerIteration
+				<< std::setw(12) << result.iterationCount;
+			if (result.itemsPerIteration > 0)
+			{
+				std::cout << std::setw(12) << result.medianTimePerIteration / (double)result.itemsPerIteration;
+			}
+			std::cout << std::defaultfloat << std::endl;
+
+			if (result.latencies.Count() > 0)
+			{
+				std::cout << "    latency(ns): p50 " << result.latencies.Percentile(0.5)
+					<< ", p99 " << result.latencies.Percentile(0.99)
+					<< ", p99.9 " << result.latencies.Percentile(0.999)
+					<< ", max " << result.latencies.Max() << std::endl;
+			}
+		}
+
+		void WriteResults(std::ostream& out, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options)
+		{
+			char date[32] = { 0 };
+			const std::time_t now = std::time(nullptr);
+			std::tm localTime;
+#ifdef _WIN32
+			localtime_s(&localTime, &now); // std::localtime() is deprecated by the SDL checks
+#else
+			localtime_r(&now, &localTime);
+#endif
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &localTime);
+
+			out << "{" << std::endl;
+			out << "\t\"context\": {" << std::endl;
+			out << "\t\t\"date\": \"" << date << "\"," << std::endl;
+			out << "\t\t\"cpu\": " << options.cpu << "," << std::endl;
+			out << "\t\t\"clock\": \"" << (TscClock::IsAvailable() ? "tsc" : "steady") << "\"," << std::endl;
+			out << "\t\t\"tsc_frequency\": " << TscClock::Frequency() << "," << std::endl;
+			out << "\t\t\"min_time_ms\": " << options.minTime << "," << std::endl;
+			out << "\t\t\"repetitions\": " << options.repetitionCount << std::endl;
+			out << "\t}," << std::endl;
+
+			out << "\t\"benchmarks\": [" << std::endl;
+			for (std::size_t index = 0; index < results.size(); ++index)
+			{
+				const BenchmarkResult& result = results[index];
+
+				out << "\t\t{" << std::endl;
+				out << "\t\t\t\"name\": \"" << EscapeJSON(result.name) << "\"," << std::endl;
+				out << "\t\t\t\"size\": " << result.size << "," << std::endl;
+				if (false == result.skipReason.empty())
+				{
+					out << "\t\t\t\"skipped\": \"" << EscapeJSON(result.skipReason) << "\"" << std::endl;
+				}
+				else
+				{
+					out << "\t\t\t\"iterations\": " << result.iterationCount << "," << std::endl;
+					out << "\t\t\t\"time_per_iteration_ns\": [";
+					for (std::size_t repetition = 0; repetition < result.timePerIteration.size(); ++repetition)
+					{
+						out << (repetition ? ", " : "") << result.timePerIteration[repetition];
+					}
+					out << "]," << std::endl;
+					out << "\t\t\t\"median_ns\": " << result.medianTimePerIteration << "," << std::endl;
+					out << "\t\t\t\"mad_ns\": " << result.madTimePerIteration << "," << std::endl;
+					out << "\t\t\t\"items_per_iteration\": " << result.itemsPerIteration << "," << std::endl;
+					out << "\t\t\t\"median_ns_per_item\": "
+						<< ((result.itemsPerIteration > 0) ? result.medianTimePerIteration / (double)result.itemsPerIteration : 0.0);
+					if (result.latencies.Count() > 0)
+					{
+						out << "," << std::endl;
+						out << "\t\t\t\"latency_ns\": { \"count\": " << result.latencies.Count()
+							<< ", \"p50\": " << result.latencies.Percentile(0.5)
+							<< ", \"p99\": " << result.latencies.Percentile(0.99)
+							<< ", \"p999\": " << result.latencies.Percentile(0.999)
+							<< ", \"max\": " << result.latencies.Max() << " }";
+					}
+					out << std::endl;
+				}
+				out << "\t\t}" << ((index + 1 < results.size()) ? "," : "") << std::endl;
+			}
+			out << "\t]" << std::endl;
+			out << "}" << std::endl;
+		}
+	}
+
+	/////////// BenchmarkState /////////////
+
+	BenchmarkState::BenchmarkState(const std::size_t size, const std::size_t iterationCount)
+		: mSize(size), mIterationCount(iterationCount), mIteration(0), mItemsPerIteration(0)
+		, mStartTime(0), mElapsedTime(0), mIsRunning(false), mIsSkipped(false), mSkipReason(), mLatencies()
+	{}
+
+	BenchmarkState::~BenchmarkState()
+	{}
+
+	std::size_t BenchmarkState::Size() const
+	{
+		return mSize;
+	}
+
+	bool BenchmarkState::KeepRunning()
+	{
+		if (0 == mIteration)
+		{
+			mIsRunning = true;
+			mStartTime = TscClock::Now();
+		}
+
+		if (mIteration < mIterationCount && false == mIsSkipped)
+		{
+			++mIteration;
+			return true;
+		}
+
+		if (mIsRunning)
+		{
+			mElapsedTime += TscClock::Now() - mStartTime;
+			mIsRunning = false;
+		}
+
+		return false;
+	}
+
+	void BenchmarkState::PauseTiming()
+	{
+		if (mIsRunning)
+		{
+			mElapsedTime += TscClock::Now() - mStartTime;
+			mIsRunning = false;
+		}
+	}
+
+	void BenchmarkState::ResumeTiming()
+	{
+		if (false == mIsRunning)
+		{
+			mIsRunning = true;
+			mStartTime = TscClock::Now();
+		}
+	}
+
+	void BenchmarkState::SetItemsPerIteration(const std::size_t itemCount)
+	{
+		mItemsPerIteration = itemCount;
+	}
+
+	void BenchmarkState::Skip(const std::string& reason)
+	{
+		mIsSkipped = true;
+		mSkipReason = reason;
+	}
+
+	void BenchmarkState::RecordLatency(const std::uint64_t latency)
+	{
+		mLatencies.Record(latency);
+	}
+
+	std::size_t BenchmarkState::ItemsPerIteration() const
+	{
+		return mItemsPerIteration;
+	}
+
+	bool BenchmarkState::IsSkipped() const
+	{
+		return mIsSkipped;
+	}
+
+	const std::string& BenchmarkState::SkipReason() const
+	{
+		return mSkipReason;
+	}
+
+	std::uint64_t BenchmarkState::ElapsedTime() const
+	{
+		return mElapsedTime;
+	}
+
+	const LatencyHistogram& BenchmarkState::Latencies() const
+	{
+		return mLatencies;
+	}
+
+	/////////// Registration /////////////
+
+	template <>
+	std::string BenchmarkValue<std::string>(const std::size_t index)
+	{
+		// long enough to be allocated on the heap, like most of the real keys
+		std::string value = "benchmark_value_";
+		value += std::to_string(index);
+
+		return value;
+	}
+
+	bool RegisterBenchmark(const std::string& name, const BenchmarkFunc& func)
+	{
+		Benchmark benchmark;
+		benchmark.name = name;
+		benchmark.func = func;
+
+		Benchmarks().push_back(benchmark);
+
+		return true;
+	}
+
+	int RunBenchmarks(int argc, char** argv)
+	{
+		BenchmarkOptions options;
+		if (false == ParseOptions(argc, argv, options))
+		{
+			return 1;
+		}
+
+		std::regex filter;
+		try
+		{
+			filter = std::regex(options.filter);
+		}
+		catch (const std::regex_error&)
+		{
+			std::cout << "Invalid filter: " << options.filter << std::endl;
+			return 1;
+		}
+
+		std::vector<const Benchmark*> benchmarks;
+		for (const Benchmark& benchmark : Benchmarks())
+		{
+			if (std::regex_search(benchmark.name, filter))
+			{
+				benchmarks.push_back(&benchmark);
+			}
+		}
+
+		if (options.isList)
+		{
+			for (const Benchmark* benchmark : benchmarks)
+			{
+				std::cout << benchmark->name << std::endl;
+			}
+			return 0;
+		}
+
+		if (options.cpu >= 0 && false == PinToCpu(options.cpu))
+		{
+			std::cout << "Can't pin to CPU " << options.cpu << std::endl;
+		}
+
+		// the TSC calibration busy waits, it must not land in the first measurement
+		TscClock::IsAvailable();
+
+		std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+			<< std::setw(16) << "Time(ns)"
+			<< std::setw(12) << "MAD(ns)"
+			<< std::setw(12) << "Iterations"
+			<< std::setw(12) << "Item(ns)" << std::endl;
+
+		std::vector<BenchmarkResult> results;
+		for (const Benchmark* benchmark : benchmarks)
+		{
+			for (const std::size_t size : options.sizes)
+			{
+				BenchmarkResult result;
+				Run(*benchmark, size, options, result);
+				PrintResult(result);
+
+				results.push_back(result);
+			}
+		}
+
+		if (false == options.jsonPath.empty())
+		{
+			std::ofstream file(options.jsonPath, std::ios::trunc);
+			if (false == file.is_open())
+			{
+				std::cout << "Can't write " << options.jsonPath << std::endl;
+				return 1;
+			}
+
+			WriteResults(file, results, options);
+		}
+
+		return 0;
+	}
+}
@@ -0,0 +1,146 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include "ClassHelper.h"
+#include "LatencyHistogram.hpp"
+#include <cstddef> // size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+/*
+Benchmark runner - the containers and algorithms are measured by registered benchmarks
+(see ContainerBenchmarks.cpp) instead of the TEST_* blocks of SDA.cpp.
+
+Every benchmark runs once per size (BenchmarkState::Size()), the iteration count is grown until
+one repetition lasts at least the min time, then the repetitions are timed with TscClock
+and the median time per iteration / per item is reported.
+The element type is part of the name, SDA_BENCHMARK_TEMPLATE registers one benchmark per type.
+A benchmark can also record the latency of single operations (RecordLatency()),
+their p50/p99/p99.9/max over the repetitions are reported too, e.g. to see the reallocation spikes.
+
+COMMAND LINE:
+	--filter=<regex>       only the benchmarks with a matching name, e.g. "Vector/.*<int>"
+	--sizes=16,1024,65536  the sizes every benchmark is run with
+	--cpu=<index>          pins the process to one CPU
+	--json=<path>          saves the results as JSON
+	--min-time=<ms>        minimum duration of a repetition (default 50)
+	--repetitions=<count>  (default 5)
+	--list                 prints the registered benchmarks
+
+BUILDING ON LINUX:
+	g++ -std=c++17 -O2 -pthread -I. *.cpp -o SDA
+	./SDA --filter="Vector" --sizes=1024,1048576 --cpu=2 --json=results.json
+
+USAGES:
+	template <class T>
+	void VectorPushBack(SDA::BenchmarkState& state)
+	{
+		while (state.KeepRunning())
+		{
+			SDA::Vector<T> vec;
+			for (std::size_t i = 0; i < state.Size(); ++i)
+				vec.PushBack(SDA::BenchmarkValue<T>(i));
+			SDA::DoNotOptimize(vec);
+		}
+		state.SetItemsPerIteration(state.Size());
+	}
+	SDA_BENCHMARK_TEMPLATE("Vector/PushBack", VectorPushBack, int);
+*/
+
+namespace SDA
+{
+	class BenchmarkState
+	{
+	public:
+		BenchmarkState(const std::size_t size, const std::size_t iterationCount);
+		virtual ~BenchmarkState();
+
+		// the benchmark parameter (element count)
+		std::size_t Size() const;
+
+		// true while iterations are left, the time is measured between the first and the last call
+		bool KeepRunning();
+
+		// excludes the setup work done inside the loop
+		void PauseTiming();
+		void ResumeTiming();
+
+		// e.g. the element count, gives the time per item
+		void SetItemsPerIteration(const std::size_t itemCount);
+		// the benchmark makes no sense for this size (e.g. O(n^2) at 1M)
+		void Skip(const std::string& reason);
+		// the duration of one operation in nanoseconds, e.g. measured with TscClock::Now()
+		void RecordLatency(const std::uint64_t latency);
+
+		std::size_t ItemsPerIteration() const;
+		bool IsSkipped() const;
+		const std::string& SkipReason() const;
+		std::uint64_t ElapsedTime() const; // nanoseconds
+		const LatencyHistogram& Latencies() const;
+
+	private:
+		NON_COPY_AND_MOVE(BenchmarkState)
+
+		std::size_t mSize;
+		std::size_t mIterationCount;
+		std::size_t mIteration;
+		std::size_t mItemsPerIteration;
+		std::uint64_t mStartTime;
+		std::uint64_t mElapsedTime;
+		bool mIsRunning;
+		bool mIsSkipped;
+		std::string mSkipReason;
+		LatencyHistogram mLatencies;
+	};
+
+	typedef std::function<void(BenchmarkState& state)> BenchmarkFunc;
+
+	// returns true, so it can initialize a static variable
+	bool RegisterBenchmark(const std::string& name, const BenchmarkFunc& func);
+
+	// parses the command line and runs the matching benchmarks, returns the exit code
+	int RunBenchmarks(int argc, char** argv);
+
+	// keeps the compiler from removing a computation whose result is never used
+	template <class T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	// distinct values for every element type the benchmarks are registered with
+	template <class T>
+	T BenchmarkValue(const std::size_t index)
+	{
+		return static_cast<T>(index);
+	}
+
+	template <>
+	std::string BenchmarkValue<std::string>(const std::size_t index);
+
+	// the type names shown in the benchmark names
+	template <class T> inline const char* BenchmarkTypeName() { return "T"; }
+	template <> inline const char* BenchmarkTypeName<int>() { return "int"; }
+	template <> inline const char* BenchmarkTypeName<std::int64_t>() { return "int64"; }
+	template <> inline const char* BenchmarkTypeName<double>() { return "double"; }
+	template <> inline const char* BenchmarkTypeName<std::string>() { return "string"; }
+}
+
+#define SDA_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define SDA_BENCHMARK_CONCAT(a, b) SDA_BENCHMARK_CONCAT_IMPL(a, b)
+
+#define SDA_BENCHMARK(name, func) \
+	static const bool SDA_BENCHMARK_CONCAT(sdaBenchmark, __LINE__) = SDA::RegisterBenchmark(name, func)
+
+#define SDA_BENCHMARK_TEMPLATE(name, func, type) \
+	static const bool SDA_BENCHMARK_CONCAT(sdaBenchmark, __LINE__) = \
+		SDA::RegisterBenchmark(std::string(name) + "<" + SDA::BenchmarkTypeName<type>() + ">", func<type>)
+
+#endif /* BENCHMARK_HPP */
\ No newline at end of file
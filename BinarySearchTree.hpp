@@ -6,6 +6,8 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include "Utility.hpp"
+#include "AllocatorUtility.hpp"
 
 /*
 BinarySearchTree - a type of collection/container to store elements of the same type hierachicaly
@@ -65,12 +67,9 @@ Note that we can always get inorder traversal by sorting the only given traversa
 #define BT_ITERATIVE
 #endif
 
-#ifdef BT_RECURSIVE
 #include <stack>
-#endif
-#ifdef BT_ITERATIVE
 #include <queue>
-#endif
+#include <functional>
 
 
 namespace SDA
@@ -87,7 +86,7 @@ namespace SDA
 		{}
 
 		BinarySearchTreeNode(const BinarySearchTreeNode<T>& node)
-			: key(node.key), parentPtr(node.parentPtr), leftPtr(node.nextPtr), rightPtr(node.rightPtr)
+			: key(node.key), parentPtr(node.parentPtr), leftPtr(node.leftPtr), rightPtr(node.rightPtr)
 		{}
 
 		~BinarySearchTreeNode()
@@ -97,12 +96,10 @@ namespace SDA
 			rightPtr = nullptr;
 		}
 
-		Swap(const BinarySearchTreeNode<T>& node)
+		// only the keys, the nodes stay linked where they are
+		void Swap(BinarySearchTreeNode<T>& node)
 		{
 			SDA::Swap(key, node.key);
-			SDA::Swap(parentPtr, node.parentPtr);
-			SDA::Swap(leftPtr, node.leftPtr);
-			SDA::Swap(rightPtr, node.rightPtr);
 		}
 
 		T key;
@@ -113,9 +110,8 @@ namespace SDA
 	class BinarySearchTree
 	{
 	public:
-		bool default_func(BinarySearchTreeNode<T>* nodePtr) { return true; };
-
-		BinarySearchTree();
+		// nullptr allocator means the global heap
+		BinarySearchTree(Allocator* allocator = nullptr);
 		BinarySearchTree(const BinarySearchTree<T>& tree);
 		BinarySearchTree(BinarySearchTree<T>&& tree);
 		virtual ~BinarySearchTree();
@@ -123,9 +119,9 @@ namespace SDA
 		BinarySearchTree<T>& operator =(const BinarySearchTree<T>& tree);
 		BinarySearchTree<T>& operator =(BinarySearchTree<T>&& tree);
 
-		// adds a new node with key and returns the new node
+		// adds a new node with key to the subtree and returns the root of the subtree
 		BinarySearchTreeNode<T>* AddNode(BinarySearchTreeNode<T>* nodePtr, const T& key);
-		// deletes a node with key and returns the new root node 
+		// deletes the node with key from the subtree and returns the new root of the subtree
 		BinarySearchTreeNode<T>* DeleteNode(BinarySearchTreeNode<T>* nodePtr, const T& key);
 
 		void RemoveNode(BinarySearchTreeNode<T>* nodePtr);
@@ -139,10 +135,10 @@ namespace SDA
 		// Breadth First Traversal (variant of BFS)
 		void LevelOrderTrversal(const std::function<bool(BinarySearchTreeNode<T>* nodePtr, bool isLastNode)>& func); // visiting each level of the tree
 
-		// Depth First Traversals
-		void InorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = default_func); // Left, Root, Right
-		void PreorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = default_func); // Root, Left, Right
-		void PostorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = default_func); // Left, Right, Root
+		// Depth First Traversals, func returns true to stop the traversal
+		void InorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = nullptr); // Left, Root, Right
+		void PreorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = nullptr); // Root, Left, Right
+		void PostorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = nullptr); // Left, Right, Root
 
 		size_t Height(BinarySearchTreeNode<T>* nodePtr);
 		size_t Depth(BinarySearchTreeNode<T>* nodePtr);
@@ -150,12 +146,18 @@ namespace SDA
 
 		bool IsLeaf(BinarySearchTreeNode<T>* nodePtr);
 
+		BinarySearchTreeNode<T>* Root();
+
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const BinarySearchTree<T>& tree);
 		void Move(BinarySearchTree<T>&& tree);
 		void Destroy();
 
 		BinarySearchTreeNode<T>* mRootPtr;
+
+		Allocator* mAllocator; // not owned
 	};
 
 
@@ -168,20 +170,22 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	BinarySearchTree<T>::BinarySearchTree()
-		: mRootPtr(nullptr)
+	BinarySearchTree<T>::BinarySearchTree(Allocator* allocator)
+		: mRootPtr(nullptr), mAllocator(allocator)
 	{}
 
 	template <class T>
 	BinarySearchTree<T>::BinarySearchTree(const BinarySearchTree<T>& tree)
+		: mRootPtr(nullptr), mAllocator(tree.mAllocator) // the copy uses the same allocator
 	{
 		Copy(tree);
 	}
 
 	template <class T>
 	BinarySearchTree<T>::BinarySearchTree(BinarySearchTree<T>&& tree)
+		: mRootPtr(nullptr), mAllocator(tree.mAllocator)
 	{
-		Move(tree);
+		Move(std::move(tree));
 	}
 
 	template <class T>
@@ -197,22 +201,25 @@ namespace SDA
 		{
 			Destroy();
 
-			auto copyR = [](BinarySearchTreeNode<T>* nodePtr) -> BinarySearchTreeNode<T> *
+			// a lambda can't call itself, std::function can
+			std::function<BinarySearchTreeNode<T>*(BinarySearchTreeNode<T>*)> copyR = [this, &copyR](BinarySearchTreeNode<T>* nodePtr) -> BinarySearchTreeNode<T>*
 			{
 				if (nodePtr == nullptr)
 					return nullptr;
 
-				BinarySearchTreeNode<T>* newNodePtr = new BinaryTreeNode<T>(nodePtr->data);
-				BinarySearchTreeNode<T>* leftPtr = copyR(nodePtr->leftPtr);
-				BinarySearchTreeNode<T>* leftPtr = copyR(nodePtr->rightPtr);
+				BinarySearchTreeNode<T>* newNodePtr = SDA::New<BinarySearchTreeNode<T>>(mAllocator, nodePtr->key);
+				newNodePtr->leftPtr = copyR(nodePtr->leftPtr);
+				newNodePtr->rightPtr = copyR(nodePtr->rightPtr);
 
-				BinarySearchTreeNode->leftPtr = leftPtr;
-				BinarySearchTreeNode->rightPtr = rightPtr;
+				if (newNodePtr->leftPtr)
+					newNodePtr->leftPtr->parentPtr = newNodePtr;
+				if (newNodePtr->rightPtr)
+					newNodePtr->rightPtr->parentPtr = newNodePtr;
 
 				return newNodePtr;
 			};
 
-			copyR(tree.mRootPtr);
+			mRootPtr = copyR(tree.mRootPtr);
 		}
 	}
 
@@ -223,6 +230,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of tree
+			mAllocator = tree.mAllocator;
+
 			mRootPtr = tree.mRootPtr;
 			tree.mRootPtr = nullptr;
 		}
@@ -231,9 +241,11 @@ namespace SDA
 	template <class T>
 	void BinarySearchTree<T>::Destroy()
 	{
-		PostorderTraversal([this](BinaryTreeNode<T>* nodePtr) -> bool
+		// the children are removed before their parent
+		PostorderTraversal([this](BinarySearchTreeNode<T>* nodePtr) -> bool
 			{
 				RemoveNode(nodePtr);
+				return false;
 			});
 
 		mRootPtr = nullptr;
@@ -250,25 +262,46 @@ namespace SDA
 	template <class T>
 	BinarySearchTree<T>& BinarySearchTree<T>::operator =(BinarySearchTree<T>&& tree)
 	{
-		Move(tree);
+		Move(std::move(tree));
 
 		return *this;
 	}
 
+	template <class T>
+	BinarySearchTreeNode<T>* BinarySearchTree<T>::Root()
+	{
+		return mRootPtr;
+	}
+
+	template <class T>
+	Allocator* BinarySearchTree<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	BinarySearchTreeNode<T>* BinarySearchTree<T>::AddNode(BinarySearchTreeNode<T>* nodePtr, const T& key)
 	{
-		if (nodePtr == nullptr) // add the root node
+		if (nodePtr == nullptr) // the new leaf
 		{
-			mRootPtr = new BinarySearchTreeNode<T>(key);
-			return mRootPtr;
+			BinarySearchTreeNode<T>* newNodePtr = SDA::New<BinarySearchTreeNode<T>>(mAllocator, key);
+
+			if (mRootPtr == nullptr) // add the root node
+				mRootPtr = newNodePtr;
+
+			return newNodePtr;
 		}
 
 		if (key < nodePtr->key)
+		{
 			nodePtr->leftPtr = AddNode(nodePtr->leftPtr, key);
-		
-		if (key > nodePtr->key)
+			nodePtr->leftPtr->parentPtr = nodePtr;
+		}
+		else if (key > nodePtr->key)
+		{
 			nodePtr->rightPtr = AddNode(nodePtr->rightPtr, key);
+			nodePtr->rightPtr->parentPtr = nodePtr;
+		}
 
 		// unchanged (same key)
 		return nodePtr;
@@ -297,7 +330,7 @@ namespace SDA
 		nodePtr->leftPtr = nullptr;
 		nodePtr->rightPtr = nullptr;
 
-		delete nodePtr;
+		SDA::Delete(mAllocator, nodePtr);
 	}
 
 	template <class T>
@@ -306,37 +339,45 @@ namespace SDA
 		if (nodePtr == nullptr)
 			return nodePtr;
 
-		BinarySearchTreeNode<T>* nodeToDeletePtr = FindNode(nodePtr, key);
-		// the keys are the same
-
-		// node has only one child
+		if (key < nodePtr->key)
+		{
+			nodePtr->leftPtr = DeleteNode(nodePtr->leftPtr, key);
+			return nodePtr;
+		}
 
-		if (nodeToDeletePtr->leftPtr == nullptr)
+		if (key > nodePtr->key)
 		{
-			BinarySearchTreeNode<T>* newRootPtr = nodeToDeletePtr->rightPtr;
+			nodePtr->rightPtr = DeleteNode(nodePtr->rightPtr, key);
+			return nodePtr;
+		}
 
-			RemoveNode(nodeToDeletePtr);
+		// the keys are the same
 
-			return newRootPtr;
-		}
-		else if (nodeToDeletePtr->rightPtr == nullptr)
+		// node has at most one child, the child takes its place
+		if (nodePtr->leftPtr == nullptr || nodePtr->rightPtr == nullptr)
 		{
-			BinarySearchTreeNode<T>*  newRootPtr = nodeToDeletePtr->rightPtr;
+			BinarySearchTreeNode<T>* newRootPtr = nodePtr->leftPtr ? nodePtr->leftPtr : nodePtr->rightPtr;
+
+			if (newRootPtr)
+				newRootPtr->parentPtr = nodePtr->parentPtr;
 
-			RemoveNode(nodeToDeletePtr);
+			if (nodePtr == mRootPtr)
+				mRootPtr = newRootPtr;
+
+			RemoveNode(nodePtr);
 
 			return newRootPtr;
 		}
 
 		// node has 2 children
 		// 1) we find the inorder succesor (smallest in the right subtree) 
-		BinarySearchTreeNode<T>* succNodePtr = FindMinKeyNode(nodeToDeletePtr->rightPtr);
+		BinarySearchTreeNode<T>* succNodePtr = FindMinKeyNode(nodePtr->rightPtr);
 
 		// 2) Swap node an the found succesor
-		nodeToDeletePtr->Swap(*succNodePtr);
+		nodePtr->Swap(*succNodePtr);
 
-		// 3) Delete the succesor
-		RemoveNode(succNodePtr);
+		// 3) Delete the succesor (it has the key now)
+		nodePtr->rightPtr = DeleteNode(nodePtr->rightPtr, key);
 
 		return nodePtr;
 	}
@@ -348,9 +389,9 @@ namespace SDA
 			return nodePtr;
 
 		if (key > nodePtr->key)
-			return SearchNode(nodePtr->rightPtr, key);
+			return FindNode(nodePtr->rightPtr, key);
 
-		return SearchNode(nodePtr->leftPtr, key);
+		return FindNode(nodePtr->leftPtr, key);
 	}
 
 	template <class T>
@@ -378,17 +419,15 @@ namespace SDA
 		std::queue<BinarySearchTreeNode<T>*> queue;
 		BinarySearchTreeNode<T>* nodePtr = nullptr;
 
-		queue.push(mRootPtr);
+		if (mRootPtr)
+			queue.push(mRootPtr);
 		while (false == queue.empty())
 		{
 			nodePtr = queue.front();
 			queue.pop();
 
-			bool ret;
-			if (func)
-				ret = func(nodePtr, queue.size() == 1);
-
-			if (ret) return;
+			if (func && func(nodePtr, queue.empty()))
+				return;
 
 			if (nodePtr->leftPtr)
 				queue.push(nodePtr->leftPtr);
@@ -400,94 +439,84 @@ namespace SDA
 
 	// Depth First Traversals
 	template <class T>
-	void BinarySearchTree<T>::InorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = default_func) // Left, Root, Right
+	void BinarySearchTree<T>::InorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func) // Left, Root, Right
 	{
 		// ONLY RECURSIVE SOLUTION
 
-		auto InOrderR = [](BinarySearchTreeNode<T>* nodePtr)
+		// a lambda can't call itself, std::function can; returns true when the traversal stops
+		std::function<bool(BinarySearchTreeNode<T>*)> InOrderR = [&func, &InOrderR](BinarySearchTreeNode<T>* nodePtr) -> bool
 		{
-			if (nodePtr)
-			{
-				InOrderR(nodePtr->leftPtr);
+			if (nodePtr == nullptr)
+				return false;
 
-				bool ret;
-				if (func)
-					ret = func(nodePtr);
+			if (InOrderR(nodePtr->leftPtr))
+				return true;
 
-				if (ret) return;
+			if (func && func(nodePtr))
+				return true;
 
-				InOrderR(nodePtr->rightPtr);
-			}
+			return InOrderR(nodePtr->rightPtr);
 		};
 
 		InOrderR(mRootPtr);
 	}
 
 	template <class T>
-	void BinarySearchTree<T>::PreorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = default_func) // Root, Left, Right
+	void BinarySearchTree<T>::PreorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func) // Root, Left, Right
 	{
-#ifdef BT_RECURSIVE
-		auto PreOrderR = [](BinarySearchTreeNode<T>* nodePtr)
+#if defined(BT_RECURSIVE)
+		std::function<bool(BinarySearchTreeNode<T>*)> PreOrderR = [&func, &PreOrderR](BinarySearchTreeNode<T>* nodePtr) -> bool
 		{
-			if (nodePtr)
-			{
-				bool ret;
-				if (func)
-					ret = func(nodePtr);
+			if (nodePtr == nullptr)
+				return false;
 
-				if (ret) return;
+			if (func && func(nodePtr))
+				return true;
 
-				PreOrderR(nodePtr->leftPtr);
-				PreOrderR(nodePtr->rightPtr);
-			}
+			return PreOrderR(nodePtr->leftPtr) || PreOrderR(nodePtr->rightPtr);
 		};
 
 		PreOrderR(mRootPtr);
-#elif BT_ITERATIVE
+#elif defined(BT_ITERATIVE)
 		/* We use a stack to process nodes */
 
 		std::stack<BinarySearchTreeNode<T>*> stack;
 		BinarySearchTreeNode<T>* nodePtr = nullptr;
 
-		stack.push(mRootPtr);
+		if (mRootPtr)
+			stack.push(mRootPtr);
 		while (false == stack.empty())
 		{
 			nodePtr = stack.top();
 			stack.pop();
 
-			bool ret;
-			if (func)
-				ret = func(nodePtr);
+			if (func && func(nodePtr))
+				return;
 
-			if (ret) return;
+			// the right child is pushed first, so the left one is processed first
+			if (nodePtr->rightPtr)
+				stack.push(nodePtr->rightPtr);
 
 			if (nodePtr->leftPtr)
 				stack.push(nodePtr->leftPtr);
-
-			if (nodePtr->rightPtr)
-				stack.push(nodePtr->rightPtr);
 		}
 #endif // 
 	}
 
 	template <class T>
-	void BinarySearchTree<T>::PostorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func = default_func) // Left, Right, Root
+	void BinarySearchTree<T>::PostorderTraversal(const std::function<bool(BinarySearchTreeNode<T>*)>& func) // Left, Right, Root
 	{
 		// ONLY RECURSIVE SOLUTION
 
-		auto PostOrderR = [](BinarySearchTreeNode<T>* nodePtr)
+		std::function<bool(BinarySearchTreeNode<T>*)> PostOrderR = [&func, &PostOrderR](BinarySearchTreeNode<T>* nodePtr) -> bool
 		{
-			if (nodePtr)
-			{
-				PostOrderR(nodePtr->leftPtr);
-				PostOrderR(nodePtr->rightPtr);
-			}
+			if (nodePtr == nullptr)
+				return false;
 
-			bool ret;
-			if (func)
-				ret = func(nodePtr);
+			if (PostOrderR(nodePtr->leftPtr) || PostOrderR(nodePtr->rightPtr))
+				return true;
 
-			if (ret) return;
+			return func && func(nodePtr);
 		};
 
 		PostOrderR(mRootPtr);
@@ -496,11 +525,11 @@ namespace SDA
 	template <class T>
 	size_t BinarySearchTree<T>::Height(BinarySearchTreeNode<T>* nodePtr)
 	{
-		assert(nodePtr == nullptr);
+		assert(nodePtr != nullptr);
 
 		// ONLY RECURSIVE SOLUTION
 
-		auto HeightR = [](BinarySearchTreeNode<T>* nodePtr) -> int
+		std::function<int(BinarySearchTreeNode<T>*)> HeightR = [&HeightR](BinarySearchTreeNode<T>* nodePtr) -> int
 		{
 			if (nodePtr == nullptr) return -1;
 
@@ -510,29 +539,20 @@ namespace SDA
 			return 1 + (leftH > rightH ? leftH : rightH);
 		};
 
-		HeightR(nodePtr);
+		return (size_t)HeightR(nodePtr);
 	}
 
 	template <class T>
 	size_t BinarySearchTree<T>::Depth(BinarySearchTreeNode<T>* nodePtr)
 	{
-		assert(nodePtr == nullptr);
+		assert(nodePtr != nullptr);
 
 		// ONLY RECURSVE SOLUTION
 
 		if (nodePtr == mRootPtr)
 			return 0;
 
-		auto DepthR = [](BinarySearchTreeNode<T>* nodePtr) -> int
-		{
-			if (nodePtr == nullptr) return -1;
-
-			int depthP = DepthR(nodePtr->parentPtr);
-
-			return (1 + depthP);
-		};
-
-		DepthR(nodePtr);
+		return 1 + Depth(nodePtr->parentPtr);
 	}
 
 	template <class T>
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 BinaryTree - a type of collection/container to store elements of the same type hierachicaly
@@ -124,7 +125,8 @@ namespace SDA
 			BT_COUNT
 		};
 
-		BinaryTree();
+		// nullptr allocator means the global heap
+		BinaryTree(Allocator* allocator = nullptr);
 		BinaryTree(const BinaryTree<T>& tree);
 		BinaryTree(BinaryTree<T>&& tree);
 		virtual ~BinaryTree();
@@ -152,12 +154,16 @@ namespace SDA
 
 		bool IsLeaf(BinaryTreeNode<T>* nodePtr);
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const BinaryTree<T>& tree);
 		void Move(BinaryTree<T>&& tree);
 		void Destroy();
 
 		BinaryTreeNode<T>* mRootPtr;
+
+		Allocator* mAllocator; // not owned
 	};
 
 
@@ -170,18 +176,20 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	BinaryTree<T>::BinaryTree()
-		: mRootPtr(nullptr)
+	BinaryTree<T>::BinaryTree(Allocator* allocator)
+		: mRootPtr(nullptr), mAllocator(allocator)
 	{}
 
 	template <class T>
 	BinaryTree<T>::BinaryTree(const BinaryTree<T>& tree)
+		: mRootPtr(nullptr), mAllocator(tree.mAllocator) // the copy uses the same allocator
 	{
 		Copy(tree);
 	}
 
 	template <class T>
 	BinaryTree<T>::BinaryTree(BinaryTree<T>&& tree)
+		: mRootPtr(nullptr), mAllocator(tree.mAllocator)
 	{
 		Move(tree);
 	}
@@ -199,12 +207,12 @@ namespace SDA
 		{
 			Destroy();
 
-			auto copyR = [](BinaryTreeNode<T>* nodePtr) -> BinaryTreeNode<T>*
+			auto copyR = [this](BinaryTreeNode<T>* nodePtr) -> BinaryTreeNode<T>*
 			{
 				if (nodePtr == nullptr)
 					return nullptr;
 
-				BinaryTreeNode<T>* newNodePtr = new BinaryTreeNode<T>(nodePtr->data);
+				BinaryTreeNode<T>* newNodePtr = SDA::New<BinaryTreeNode<T>>(mAllocator, nodePtr->data);
 				BinaryTreeNode<T>* leftPtr = copyR(nodePtr->leftPtr);
 				BinaryTreeNode<T>* leftPtr = copyR(nodePtr->rightPtr);
 
@@ -225,6 +233,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of tree
+			mAllocator = tree.mAllocator;
+
 			mRootPtr = tree.mRootPtr;
 			tree.mRootPtr = nullptr;
 		}
@@ -257,12 +268,18 @@ namespace SDA
 		return *this;
 	}
 
+	template <class T>
+	Allocator* BinaryTree<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	void BinaryTree<T>::AddNode(BinaryTreeNode<T>* parentPtr, BT_DIR dir, const T& val)
 	{
 		assert(dir < BT_DIR::BT_COUNT);
 
-		BinaryTreeNode<T>* newNodePtr = new BinaryTreeNode<T>(val);
+		BinaryTreeNode<T>* newNodePtr = SDA::New<BinaryTreeNode<T>>(mAllocator, val);
 
 		if (parentPtr == nullptr) // add the root node
 		{
@@ -328,7 +345,7 @@ namespace SDA
 		nodePtr->leftPtr = nullptr;
 		nodePtr->rightPtr = nullptr;
 
-		delete nodePtr;
+		SDA::Delete(mAllocator, nodePtr);
 	}
 
 	template <class T>
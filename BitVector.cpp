@@ -0,0 +1,561 @@
+#include "BitVector.hpp"
+#include "AllocatorUtility.hpp"
+#include <algorithm> // min
+#include <cstring> // memcpy(), memset(), memcmp()
+#include <utility> // std::move()
+
+namespace SDA
+{
+	BitVector::BitVector(Allocator* allocator)
+		: mWords(nullptr), mWordCapacity(0), mSize(0)
+		, mRankBlocks(allocator), mHasRankSelect(false), mAllocator(allocator)
+	{}
+
+	BitVector::BitVector(size_t size, bool value, Allocator* allocator)
+		: BitVector(allocator)
+	{
+		Resize(size, value);
+	}
+
+	BitVector::BitVector(const BitVector& bits)
+		: BitVector(bits.mAllocator) // the copy uses the same allocator
+	{
+		Copy(bits);
+	}
+
+	BitVector::BitVector(BitVector&& bits) noexcept
+		: BitVector(bits.mAllocator)
+	{
+		Move(std::move(bits));
+	}
+
+	BitVector::~BitVector()
+	{
+		Destroy();
+	}
+
+	BitVector& BitVector::operator =(const BitVector& bits)
+	{
+		Copy(bits);
+
+		return *this;
+	}
+
+	BitVector& BitVector::operator =(BitVector&& bits) noexcept
+	{
+		Move(std::move(bits));
+
+		return *this;
+	}
+
+	void BitVector::Copy(const BitVector& bits)
+	{
+		if (this != &bits)
+		{
+			// the current words are kept if there are enough
+			const size_t wordCount = WordsFor(bits.mSize);
+			ReserveWords(wordCount);
+
+			if (wordCount > 0)
+			{
+				std::memcpy(mWords, bits.mWords, wordCount * sizeof(std::uint64_t));
+			}
+			mSize = bits.mSize;
+
+			mRankBlocks = bits.mRankBlocks;
+			mHasRankSelect = bits.mHasRankSelect;
+		}
+	}
+
+	void BitVector::Move(BitVector&& bits)
+	{
+		if (this != &bits)
+		{
+			// delete the old words
+			Destroy();
+
+			// just copy the pointer, the words are freed with the allocator of bits
+			mWords = bits.mWords;
+			mWordCapacity = bits.mWordCapacity;
+			mSize = bits.mSize;
+			mAllocator = bits.mAllocator;
+
+			mRankBlocks = std::move(bits.mRankBlocks);
+			mHasRankSelect = bits.mHasRankSelect;
+
+			// bits is invalidated after move
+			bits.mWords = nullptr;
+			bits.mWordCapacity = 0;
+			bits.mSize = 0;
+			bits.mHasRankSelect = false;
+		}
+	}
+
+	void BitVector::Destroy()
+	{
+		SDA::FreeArray(mAllocator, mWords);
+
+		mWords = nullptr;
+		mWordCapacity = 0;
+		mSize = 0;
+		InvalidateRankSelect();
+	}
+
+	bool BitVector::operator ==(const BitVector& bits) const
+	{
+		// the tail bits are always 0, the words can be compared
+		return (mSize == bits.mSize) &&
+			(0 == mSize || 0 == std::memcmp(mWords, bits.mWords, WordsFor(mSize) * sizeof(std::uint64_t)));
+	}
+
+	bool BitVector::operator !=(const BitVector& bits) const
+	{
+		return false == (*this == bits);
+	}
+
+	void BitVector::SetRange(size_t first, size_t last)
+	{
+		assert(first <= last && last <= mSize);
+
+		if (first == last)
+		{
+			return;
+		}
+
+		const size_t firstWord = WordIndex(first);
+		const size_t lastWord = WordIndex(last - 1);
+		// the bits from first to the end of its word, and from the start of the last word to last
+		const std::uint64_t firstMask = ~(BitMask(first) - 1);
+		const std::uint64_t lastMask = ~(std::uint64_t)0 >> (WORD_BITS - 1 - ((last - 1) & (WORD_BITS - 1)));
+
+		if (firstWord == lastWord)
+		{
+			mWords[firstWord] |= firstMask & lastMask;
+		}
+		else
+		{
+			mWords[firstWord] |= firstMask;
+			for (size_t word = firstWord + 1; word < lastWord; ++word)
+			{
+				mWords[word] = ~(std::uint64_t)0;
+			}
+			mWords[lastWord] |= lastMask;
+		}
+
+		InvalidateRankSelect();
+	}
+
+	void BitVector::ResetRange(size_t first, size_t last)
+	{
+		assert(first <= last && last <= mSize);
+
+		if (first == last)
+		{
+			return;
+		}
+
+		const size_t firstWord = WordIndex(first);
+		const size_t lastWord = WordIndex(last - 1);
+		const std::uint64_t firstMask = ~(BitMask(first) - 1);
+		const std::uint64_t lastMask = ~(std::uint64_t)0 >> (WORD_BITS - 1 - ((last - 1) & (WORD_BITS - 1)));
+
+		if (firstWord == lastWord)
+		{
+			mWords[firstWord] &= ~(firstMask & lastMask);
+		}
+		else
+		{
+			mWords[firstWord] &= ~firstMask;
+			for (size_t word = firstWord + 1; word < lastWord; ++word)
+			{
+				mWords[word] = 0;
+			}
+			mWords[lastWord] &= ~lastMask;
+		}
+
+		InvalidateRankSelect();
+	}
+
+	void BitVector::SetAll()
+	{
+		const size_t wordCount = WordsFor(mSize);
+		if (wordCount > 0)
+		{
+			std::memset(mWords, 0xFF, wordCount * sizeof(std::uint64_t));
+		}
+
+		ClearTail();
+		InvalidateRankSelect();
+	}
+
+	void BitVector::ResetAll()
+	{
+		const size_t wordCount = WordsFor(mSize);
+		if (wordCount > 0)
+		{
+			std::memset(mWords, 0, wordCount * sizeof(std::uint64_t));
+		}
+
+		InvalidateRankSelect();
+	}
+
+	void BitVector::FlipAll()
+	{
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			mWords[word] = ~mWords[word];
+		}
+
+		ClearTail();
+		InvalidateRankSelect();
+	}
+
+	BitVector& BitVector::operator &=(const BitVector& bits)
+	{
+		assert(mSize == bits.mSize);
+
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			mWords[word] &= bits.mWords[word];
+		}
+
+		InvalidateRankSelect();
+
+		return *this;
+	}
+
+	BitVector& BitVector::operator |=(const BitVector& bits)
+	{
+		assert(mSize == bits.mSize);
+
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			mWords[word] |= bits.mWords[word];
+		}
+
+		InvalidateRankSelect();
+
+		return *this;
+	}
+
+	BitVector& BitVector::operator ^=(const BitVector& bits)
+	{
+		assert(mSize == bits.mSize);
+
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			mWords[word] ^= bits.mWords[word];
+		}
+
+		InvalidateRankSelect();
+
+		return *this;
+	}
+
+	BitVector& BitVector::AndNot(const BitVector& bits)
+	{
+		assert(mSize == bits.mSize);
+
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			mWords[word] &= ~bits.mWords[word];
+		}
+
+		InvalidateRankSelect();
+
+		return *this;
+	}
+
+	size_t BitVector::Count() const
+	{
+		size_t count = 0;
+
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			count += PopCount(mWords[word]);
+		}
+
+		return count;
+	}
+
+	bool BitVector::Any() const
+	{
+		return NOT_FOUND != FindFirst();
+	}
+
+	bool BitVector::None() const
+	{
+		return NOT_FOUND == FindFirst();
+	}
+
+	bool BitVector::All() const
+	{
+		return Count() == mSize;
+	}
+
+	size_t BitVector::FindFirst() const
+	{
+		const size_t wordCount = WordsFor(mSize);
+		for (size_t word = 0; word < wordCount; ++word)
+		{
+			if (mWords[word] != 0)
+			{
+				return (word << WORD_SHIFT) + CountTrailingZeros(mWords[word]);
+			}
+		}
+
+		return NOT_FOUND;
+	}
+
+	size_t BitVector::FindNext(size_t index) const
+	{
+		const size_t first = index + 1;
+		if (first >= mSize)
+		{
+			return NOT_FOUND;
+		}
+
+		// the bits before first are masked out in its word
+		size_t word = WordIndex(first);
+		std::uint64_t bits = mWords[word] & ~(BitMask(first) - 1);
+
+		const size_t wordCount = WordsFor(mSize);
+		while (0 == bits)
+		{
+			if (++word == wordCount)
+			{
+				return NOT_FOUND;
+			}
+			bits = mWords[word];
+		}
+
+		return (word << WORD_SHIFT) + CountTrailingZeros(bits);
+	}
+
+	void BitVector::BuildRankSelect()
+	{
+		const size_t wordCount = WordsFor(mSize);
+		const size_t blockCount = (wordCount + RANK_BLOCK_WORDS - 1) / RANK_BLOCK_WORDS;
+
+		// one more entry with the total, so the rank of Size() needs no special case
+		mRankBlocks.Resize(0);
+		mRankBlocks.Reserve(blockCount + 1);
+
+		std::uint64_t count = 0;
+		for (size_t block = 0; block < blockCount; ++block)
+		{
+			mRankBlocks.PushBack(count);
+
+			const size_t lastWord = std::min((block + 1) * RANK_BLOCK_WORDS, wordCount);
+			for (size_t word = block * RANK_BLOCK_WORDS; word < lastWord; ++word)
+			{
+				count += PopCount(mWords[word]);
+			}
+		}
+		mRankBlocks.PushBack(count);
+
+		mHasRankSelect = true;
+	}
+
+	bool BitVector::HasRankSelect() const
+	{
+		return mHasRankSelect;
+	}
+
+	size_t BitVector::Rank(size_t index) const
+	{
+		assert(mHasRankSelect);
+		assert(index <= mSize);
+
+		if (index == 0)
+		{
+			return 0;
+		}
+
+		// the block count, then the whole words of the block, then the bits before index in its word
+		const size_t lastWord = WordIndex(index);
+		const size_t block = lastWord / RANK_BLOCK_WORDS;
+
+		size_t count = (size_t)mRankBlocks[block];
+		for (size_t word = block * RANK_BLOCK_WORDS; word < lastWord; ++word)
+		{
+			count += PopCount(mWords[word]);
+		}
+
+		if (index & (WORD_BITS - 1))
+		{
+			count += PopCount(mWords[lastWord] & (BitMask(index) - 1));
+		}
+
+		return count;
+	}
+
+	size_t BitVector::Select(size_t rank) const
+	{
+		assert(mHasRankSelect);
+
+		// the last entry is the total
+		if (rank >= mRankBlocks.Back())
+		{
+			return NOT_FOUND;
+		}
+
+		// the last block whose count is <= rank
+		size_t low = 0;
+		size_t high = mRankBlocks.Size() - 1;
+		while (high - low > 1)
+		{
+			const size_t middle = low + (high - low) / 2;
+			if (mRankBlocks[middle] <= rank)
+			{
+				low = middle;
+			}
+			else
+			{
+				high = middle;
+			}
+		}
+
+		// then the word, then the bit in the word
+		size_t remaining = rank - (size_t)mRankBlocks[low];
+		const size_t lastWord = std::min((low + 1) * RANK_BLOCK_WORDS, WordsFor(mSize));
+		for (size_t word = low * RANK_BLOCK_WORDS; word < lastWord; ++word)
+		{
+			std::uint64_t bits = mWords[word];
+			const size_t count = PopCount(bits);
+			if (remaining < count)
+			{
+				return (word << WORD_SHIFT) + SelectInWord(bits, remaining);
+			}
+			remaining -= count;
+		}
+
+		return NOT_FOUND;
+	}
+
+	size_t BitVector::SelectInWord(std::uint64_t word, size_t rank)
+	{
+		// the popcount of every byte (SWAR), then the running sums: byte k holds the bits set in bytes [0, k]
+		std::uint64_t byteCounts = word - ((word >> 1) & 0x5555555555555555ULL);
+		byteCounts = (byteCounts & 0x3333333333333333ULL) + ((byteCounts >> 2) & 0x3333333333333333ULL);
+		byteCounts = (byteCounts + (byteCounts >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		const std::uint64_t byteSums = byteCounts * 0x0101010101010101ULL;
+
+		// the first byte whose running sum passes rank
+		size_t byte = 0;
+		while (((byteSums >> (byte * 8)) & 0xFF) <= rank)
+		{
+			++byte;
+		}
+
+		// at most 7 bits are cleared in that byte
+		std::uint64_t bits = (word >> (byte * 8)) & 0xFF;
+		for (size_t remaining = rank - (byte ? (size_t)((byteSums >> (byte * 8 - 8)) & 0xFF) : 0); remaining > 0; --remaining)
+		{
+			bits &= bits - 1;
+		}
+
+		return byte * 8 + CountTrailingZeros(bits);
+	}
+
+	size_t BitVector::Size() const
+	{
+		return mSize;
+	}
+
+	bool BitVector::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	void BitVector::PushBack(bool value)
+	{
+		if (WordsFor(mSize + 1) > mWordCapacity)
+		{
+			// if empty resize for 1 word, otherwise double the capacity
+			ReserveWords(mWordCapacity == 0 ? 1 : mWordCapacity * 2);
+		}
+
+		// a new word has to start cleared
+		if (0 == (mSize & (WORD_BITS - 1)))
+		{
+			mWords[WordIndex(mSize)] = 0;
+		}
+
+		++mSize;
+		Assign(mSize - 1, value);
+	}
+
+	void BitVector::Resize(size_t size, bool value)
+	{
+		const size_t oldSize = mSize;
+		const size_t oldWordCount = WordsFor(oldSize);
+		const size_t wordCount = WordsFor(size);
+
+		if (wordCount > mWordCapacity)
+		{
+			ReserveWords(std::max(wordCount, mWordCapacity * 2));
+		}
+
+		// the new words start cleared, the tail of the old last word is already 0
+		if (wordCount > oldWordCount)
+		{
+			std::memset(mWords + oldWordCount, 0, (wordCount - oldWordCount) * sizeof(std::uint64_t));
+		}
+
+		mSize = size;
+
+		if (size > oldSize && value)
+		{
+			SetRange(oldSize, size);
+		}
+
+		ClearTail();
+		InvalidateRankSelect();
+	}
+
+	size_t BitVector::WordCount() const
+	{
+		return WordsFor(mSize);
+	}
+
+	const std::uint64_t* BitVector::GetWords() const
+	{
+		return mWords;
+	}
+
+	Allocator* BitVector::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
+	void BitVector::ReserveWords(size_t wordCount)
+	{
+		if (wordCount > mWordCapacity)
+		{
+			// one realloc() or memcpy()
+			mWords = SDA::ReallocateArray<std::uint64_t>(mAllocator, mWords, WordsFor(mSize), wordCount);
+			mWordCapacity = wordCount;
+		}
+	}
+
+	void BitVector::ClearTail()
+	{
+		const size_t tailBits = mSize & (WORD_BITS - 1);
+		if (tailBits)
+		{
+			mWords[WordIndex(mSize)] &= BitMask(mSize) - 1;
+		}
+	}
+
+	void BitVector::InvalidateRankSelect()
+	{
+		mHasRankSelect = false;
+	}
+}
@@ -0,0 +1,241 @@
+#ifndef BIT_VECTOR_HPP
+#define BIT_VECTOR_HPP
+
+#include "Allocator.hpp"
+#include "Vector.hpp"
+#include <cstddef> // size_t
+#include <cstdint>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h> // __popcnt64(), _BitScanForward64()
+#endif
+
+/*
+BitVector - a vector of bits packed in 64 bit words, like std::vector<bool>,
+but the bulk operations (set/clear of ranges, AND/OR/XOR, count, find) work on whole words:
+64 bits per instruction, the count is the hardware popcount and the search skips the empty words.
+gcc/clang use the popcnt instruction only when it is enabled (-mpopcnt or -march=native),
+otherwise PopCount() is a SWAR bit trick.
+The bits after Size() in the last word are always 0.
+
+Rank/select (optional): BuildRankSelect() stores the number of set bits before every block of 512 bits,
+then Rank(i) is O(1) and Select(k) is O(log(n / 512)). Any modification invalidates them.
+
+TIME COMPLEXITY:
+- Test/Set/Reset/Flip a bit = O(1)
+- Count, AND/OR/XOR, SetAll/ClearAll = O(n / 64)
+- FindFirst/FindNext = O(distance / 64)
+- Rank = O(1), Select = O(log(n / 512)) after BuildRankSelect() (O(n / 64))
+
+SPACE COMPLEXITY:
+- O(n / 8) bytes, plus n / 64 bytes for rank/select
+
+USAGES:
+ - the visited set of the graph traversals
+ - sets of small integers (ids), with fast intersection/union
+ - bitmap indexes, rank/select for succinct structures
+*/
+
+namespace SDA
+{
+	class BitVector
+	{
+	public:
+		static const size_t NOT_FOUND = (size_t)-1;
+		static const size_t WORD_BITS = 64;
+
+		// nullptr allocator means the global heap
+		BitVector(Allocator* allocator = nullptr);
+		BitVector(size_t size, bool value = false, Allocator* allocator = nullptr);
+		BitVector(const BitVector& bits);
+		BitVector(BitVector&& bits) noexcept;
+		virtual ~BitVector();
+
+		BitVector& operator =(const BitVector& bits);
+		BitVector& operator =(BitVector&& bits) noexcept;
+
+		bool operator ==(const BitVector& bits) const;
+		bool operator !=(const BitVector& bits) const;
+
+		bool operator [](size_t index) const;
+		bool Test(size_t index) const;
+		void Set(size_t index);
+		void Reset(size_t index);
+		void Flip(size_t index);
+		void Assign(size_t index, bool value);
+
+		// the bits [first, last)
+		void SetRange(size_t first, size_t last);
+		void ResetRange(size_t first, size_t last);
+		void SetAll();
+		void ResetAll();
+		void FlipAll();
+
+		// the same size is required
+		BitVector& operator &=(const BitVector& bits);
+		BitVector& operator |=(const BitVector& bits);
+		BitVector& operator ^=(const BitVector& bits);
+		// this & ~bits, e.g. the not yet visited ones
+		BitVector& AndNot(const BitVector& bits);
+
+		// the number of set bits (popcount)
+		size_t Count() const;
+		bool Any() const;
+		bool None() const;
+		bool All() const;
+
+		// the index of the first set bit, NOT_FOUND if none
+		size_t FindFirst() const;
+		// the index of the first set bit after index, NOT_FOUND if none
+		size_t FindNext(size_t index) const;
+
+		// prepares Rank() and Select(), they are valid until the next modification
+		void BuildRankSelect();
+		bool HasRankSelect() const;
+		// the number of set bits in [0, index)
+		size_t Rank(size_t index) const;
+		// the index of the set bit with the given rank (0 based), NOT_FOUND if there are not enough
+		size_t Select(size_t rank) const;
+
+		size_t Size() const;
+		bool IsEmpty() const;
+
+		void PushBack(bool value);
+		void Resize(size_t size, bool value = false);
+
+		size_t WordCount() const;
+		const std::uint64_t* GetWords() const;
+
+		Allocator* GetAllocator() const;
+
+		static size_t PopCount(std::uint64_t word);
+		// the index of the lowest set bit, word must not be 0
+		static size_t CountTrailingZeros(std::uint64_t word);
+
+	private:
+		void Copy(const BitVector& bits);
+		void Move(BitVector&& bits);
+		void Destroy();
+
+		void ReserveWords(size_t wordCount);
+		// clears the bits after mSize in the last word
+		void ClearTail();
+		void InvalidateRankSelect();
+		// the index of the set bit with the given rank in word, it must have more than rank set bits
+		static size_t SelectInWord(std::uint64_t word, size_t rank);
+
+		static size_t WordIndex(size_t index);
+		static std::uint64_t BitMask(size_t index);
+		static size_t WordsFor(size_t size);
+
+		std::uint64_t* mWords; // raw memory, [0, WordsFor(mSize)) are used
+		size_t mWordCapacity;
+		size_t mSize; // bits
+
+		Vector<std::uint64_t> mRankBlocks; // the set bits before every block
+		bool mHasRankSelect;
+
+		Allocator* mAllocator; // not owned
+
+		static const size_t WORD_SHIFT = 6;
+		static const size_t RANK_BLOCK_WORDS = 8; // 512 bits, one cache line
+	};
+
+	/////////// the per bit operations are inlined /////////////
+
+	inline size_t BitVector::WordIndex(size_t index)
+	{
+		return index >> WORD_SHIFT;
+	}
+
+	inline std::uint64_t BitVector::BitMask(size_t index)
+	{
+		return (std::uint64_t)1 << (index & (WORD_BITS - 1));
+	}
+
+	inline size_t BitVector::WordsFor(size_t size)
+	{
+		return (size + WORD_BITS - 1) >> WORD_SHIFT;
+	}
+
+	inline bool BitVector::operator [](size_t index) const
+	{
+		return Test(index);
+	}
+
+	inline bool BitVector::Test(size_t index) const
+	{
+		assert(index < mSize);
+
+		return 0 != (mWords[WordIndex(index)] & BitMask(index));
+	}
+
+	inline void BitVector::Set(size_t index)
+	{
+		assert(index < mSize);
+
+		mWords[WordIndex(index)] |= BitMask(index);
+		mHasRankSelect = false;
+	}
+
+	inline void BitVector::Reset(size_t index)
+	{
+		assert(index < mSize);
+
+		mWords[WordIndex(index)] &= ~BitMask(index);
+		mHasRankSelect = false;
+	}
+
+	inline void BitVector::Flip(size_t index)
+	{
+		assert(index < mSize);
+
+		mWords[WordIndex(index)] ^= BitMask(index);
+		mHasRankSelect = false;
+	}
+
+	inline void BitVector::Assign(size_t index, bool value)
+	{
+		value ? Set(index) : Reset(index);
+	}
+
+	inline size_t BitVector::PopCount(std::uint64_t word)
+	{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__POPCNT__)
+		// the popcnt instruction (-mpopcnt, -march=native), without it gcc calls a slow library function
+		return (size_t)__builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return (size_t)__popcnt64(word);
+#else
+		// SWAR popcount, a few shifts, adds and one multiplication
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (size_t)((word * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	inline size_t BitVector::CountTrailingZeros(std::uint64_t word)
+	{
+		assert(word != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+		return (size_t)__builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index = 0;
+		_BitScanForward64(&index, word);
+		return (size_t)index;
+#else
+		size_t index = 0;
+		while (0 == (word & 1))
+		{
+			word >>= 1;
+			++index;
+		}
+		return index;
+#endif
+	}
+}
+
+#endif /* BIT_VECTOR_HPP */
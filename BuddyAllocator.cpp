@@ -0,0 +1,257 @@
+#include "BuddyAllocator.hpp"
+#include "MemoryUtility.hpp"
+#include <cstdlib> // malloc(), free()
+#include <cstring> // memset()
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	BuddyAllocator::BuddyAllocator()
+		: Allocator(), mRawBuffer(nullptr), mMemoryBuffer(nullptr), mMinBlockSize(DEFAULT_MIN_BLOCK_SIZE)
+		, mMinBlockLog(0), mMaxOrder(0), mFreeBitmap(nullptr), mBlockOrders(nullptr)
+	{
+		std::fill(mFreeLists, mFreeLists + MAX_ORDER_COUNT, nullptr);
+		std::fill(mBitmapOffsets, mBitmapOffsets + MAX_ORDER_COUNT, 0);
+	}
+
+	BuddyAllocator::BuddyAllocator(const std::size_t totalSize, const std::size_t minBlockSize)
+		: Allocator(totalSize), mRawBuffer(nullptr), mMemoryBuffer(nullptr), mMinBlockSize(minBlockSize)
+		, mMinBlockLog(SDA::Log2(minBlockSize)), mMaxOrder(0), mFreeBitmap(nullptr), mBlockOrders(nullptr)
+	{
+		assert(SDA::IsPowerOfTwo(totalSize) && "Total size must be a power of two");
+		assert(SDA::IsPowerOfTwo(minBlockSize) && "Min block size must be a power of two");
+		assert(minBlockSize >= sizeof(FreeBlock) && "Min block size is too small");
+		assert(totalSize >= minBlockSize);
+
+		mMaxOrder = SDA::Log2(totalSize) - mMinBlockLog;
+
+		std::fill(mFreeLists, mFreeLists + MAX_ORDER_COUNT, nullptr);
+		std::fill(mBitmapOffsets, mBitmapOffsets + MAX_ORDER_COUNT, 0);
+	}
+
+	BuddyAllocator::~BuddyAllocator()
+	{
+		free(mRawBuffer);
+		free(mFreeBitmap);
+		free(mBlockOrders);
+
+		mRawBuffer = nullptr;
+		mMemoryBuffer = nullptr;
+		mFreeBitmap = nullptr;
+		mBlockOrders = nullptr;
+	}
+
+	void BuddyAllocator::Init()
+	{
+		free(mRawBuffer);
+		free(mFreeBitmap);
+		free(mBlockOrders);
+
+		// align the buffer so the blocks are aligned to their size (up to BUFFER_ALIGNMENT)
+		mRawBuffer = malloc(mTotalSize + BUFFER_ALIGNMENT);
+		mMemoryBuffer = (void*)((std::size_t)mRawBuffer + SDA::CalculateMemoryPadding((std::size_t)mRawBuffer, BUFFER_ALIGNMENT));
+
+		// order k has 2^(maxOrder - k) blocks, one bit each
+		std::size_t bitCount = 0;
+		for (std::size_t order = 0; order <= mMaxOrder; ++order)
+		{
+			mBitmapOffsets[order] = bitCount;
+			bitCount += (std::size_t)1 << (mMaxOrder - order);
+		}
+
+		const std::size_t wordCount = (bitCount + 63) / 64;
+		mFreeBitmap = (std::uint64_t*)malloc(wordCount * sizeof(std::uint64_t));
+
+		mBlockOrders = (unsigned char*)malloc(mTotalSize / mMinBlockSize);
+
+		Reset();
+	}
+
+	void BuddyAllocator::Reset()
+	{
+		mUsed = 0;
+		mPeak = 0;
+
+		std::fill(mFreeLists, mFreeLists + MAX_ORDER_COUNT, nullptr);
+
+		if (nullptr == mMemoryBuffer)
+		{
+			return;
+		}
+
+		const std::size_t bitCount = mBitmapOffsets[mMaxOrder] + 1;
+		memset(mFreeBitmap, 0, ((bitCount + 63) / 64) * sizeof(std::uint64_t));
+
+		// the whole buffer is one free block of the max order
+		PushFreeBlock(0, mMaxOrder);
+	}
+
+	void* BuddyAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+		assert(alignment <= BUFFER_ALIGNMENT && "Alignment not supported");
+
+		// blocks are aligned to their size
+		const std::size_t requiredSize = SDA::NextPowerOfTwo(std::max(std::max(size, alignment), mMinBlockSize));
+		if (requiredSize > mTotalSize)
+		{
+			return nullptr;
+		}
+
+		const std::size_t requiredOrder = SDA::Log2(requiredSize) - mMinBlockLog;
+
+		// find the smallest free block big enough
+		std::size_t order = requiredOrder;
+		while (order <= mMaxOrder && nullptr == mFreeLists[order])
+		{
+			++order;
+		}
+
+		if (order > mMaxOrder)
+		{
+			return nullptr;
+		}
+
+		const std::size_t offset = (std::size_t)mFreeLists[order] - (std::size_t)mMemoryBuffer;
+		RemoveFreeBlock(offset, order);
+
+		// split the block, the upper halves become free buddies
+		while (order > requiredOrder)
+		{
+			--order;
+			PushFreeBlock(offset + BlockSize(order), order);
+		}
+
+		mBlockOrders[offset >> mMinBlockLog] = (unsigned char)requiredOrder;
+
+		mUsed += requiredSize;
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)((std::size_t)mMemoryBuffer + offset);
+	}
+
+	void BuddyAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		assert((std::size_t)ptr >= (std::size_t)mMemoryBuffer &&
+			(std::size_t)ptr < (std::size_t)mMemoryBuffer + mTotalSize && "Pointer not owned by this allocator");
+
+		std::size_t offset = (std::size_t)ptr - (std::size_t)mMemoryBuffer;
+		std::size_t order = mBlockOrders[offset >> mMinBlockLog];
+
+		mUsed -= BlockSize(order);
+
+		// merge with the buddy as long as it is free
+		while (order < mMaxOrder)
+		{
+			const std::size_t buddyOffset = offset ^ BlockSize(order);
+
+			if (false == IsFreeBlock(buddyOffset, order))
+			{
+				break;
+			}
+
+			RemoveFreeBlock(buddyOffset, order);
+
+			offset = std::min(offset, buddyOffset);
+			++order;
+		}
+
+		PushFreeBlock(offset, order);
+	}
+
+	float BuddyAllocator::Fragmentation()
+	{
+		const std::size_t totalFree = mTotalSize - mUsed;
+		if (0 == totalFree)
+		{
+			return 0.0f;
+		}
+
+		// the largest free block is in the highest non empty free list
+		std::size_t largestFree = 0;
+		for (std::size_t order = mMaxOrder + 1; order > 0; --order)
+		{
+			if (mFreeLists[order - 1])
+			{
+				largestFree = BlockSize(order - 1);
+				break;
+			}
+		}
+
+		return 1.0f - static_cast<float>(largestFree) / totalFree;
+	}
+
+	std::size_t BuddyAllocator::MinBlockSize() const
+	{
+		return mMinBlockSize;
+	}
+
+	void BuddyAllocator::PushFreeBlock(const std::size_t offset, const std::size_t order)
+	{
+		FreeBlock* block = (FreeBlock*)((std::size_t)mMemoryBuffer + offset);
+		block->previous = nullptr;
+		block->next = mFreeLists[order];
+
+		if (mFreeLists[order])
+		{
+			mFreeLists[order]->previous = block;
+		}
+		mFreeLists[order] = block;
+
+		SetFreeBit(offset, order, true);
+	}
+
+	void BuddyAllocator::RemoveFreeBlock(const std::size_t offset, const std::size_t order)
+	{
+		FreeBlock* block = (FreeBlock*)((std::size_t)mMemoryBuffer + offset);
+
+		if (block->previous)
+		{
+			block->previous->next = block->next;
+		}
+		else
+		{
+			mFreeLists[order] = block->next;
+		}
+
+		if (block->next)
+		{
+			block->next->previous = block->previous;
+		}
+
+		SetFreeBit(offset, order, false);
+	}
+
+	bool BuddyAllocator::IsFreeBlock(const std::size_t offset, const std::size_t order) const
+	{
+		const std::size_t bit = mBitmapOffsets[order] + (offset >> (mMinBlockLog + order));
+
+		return (mFreeBitmap[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	void BuddyAllocator::SetFreeBit(const std::size_t offset, const std::size_t order, bool isFree)
+	{
+		const std::size_t bit = mBitmapOffsets[order] + (offset >> (mMinBlockLog + order));
+		const std::uint64_t mask = (std::uint64_t)1 << (bit % 64);
+
+		if (isFree)
+		{
+			mFreeBitmap[bit / 64] |= mask;
+		}
+		else
+		{
+			mFreeBitmap[bit / 64] &= ~mask;
+		}
+	}
+
+	std::size_t BuddyAllocator::BlockSize(const std::size_t order) const
+	{
+		return mMinBlockSize << order;
+	}
+}
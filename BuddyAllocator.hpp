@@ -0,0 +1,84 @@
+#ifndef BUDDY_ALLOCATOR_HPP
+#define BUDDY_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+/*
+BuddyAllocator - the buffer (a power of two) is recursively split in halves (buddies).
+A block of order k has the size: minBlockSize * 2^k.
+Every order has a free list and a bitmap with the free blocks of that order,
+so the buddy of a block is found and checked in O(1) (its offset differs by one bit).
+The order of the allocated blocks is kept in a side table, no per-block header is needed.
+
+TIME COMPLEXITY:
+- Allocate = O(log n) - a bigger block is split until it has the required order
+- Free = O(log n) - the block is merged with its free buddy as long as possible
+
+ADVANTAGES:
+- fast merging, low external fragmentation
+- blocks are naturally aligned to their size
+
+DISADVANTAGES:
+- internal fragmentation, every size is rounded up to a power of two
+
+USAGES:
+- power of two sized buffers e.g. the capacities of Vector, FixedQueue, FixedStack
+*/
+
+namespace SDA
+{
+	class BuddyAllocator : public Allocator
+	{
+	public:
+		BuddyAllocator();
+		BuddyAllocator(const std::size_t totalSize, const std::size_t minBlockSize = DEFAULT_MIN_BLOCK_SIZE);
+		virtual ~BuddyAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		float Fragmentation();
+
+		std::size_t MinBlockSize() const;
+
+	private:
+		NON_COPY_AND_MOVE(BuddyAllocator)
+
+		struct FreeBlock
+		{
+			FreeBlock* previous;
+			FreeBlock* next;
+		};
+
+		void PushFreeBlock(const std::size_t offset, const std::size_t order);
+		void RemoveFreeBlock(const std::size_t offset, const std::size_t order);
+		bool IsFreeBlock(const std::size_t offset, const std::size_t order) const;
+		void SetFreeBit(const std::size_t offset, const std::size_t order, bool isFree);
+
+		std::size_t BlockSize(const std::size_t order) const;
+
+		void* mRawBuffer; // not aligned buffer returned by malloc()
+		void* mMemoryBuffer;
+		std::size_t mMinBlockSize;
+		std::size_t mMinBlockLog;
+		std::size_t mMaxOrder;
+
+		std::uint64_t* mFreeBitmap; // the free bits of all the orders
+		unsigned char* mBlockOrders; // the order of every allocated block, indexed by min block
+
+		static const std::size_t MAX_ORDER_COUNT = 64;
+
+		FreeBlock* mFreeLists[MAX_ORDER_COUNT];
+		std::size_t mBitmapOffsets[MAX_ORDER_COUNT];
+
+		static const std::size_t DEFAULT_MIN_BLOCK_SIZE = 32;
+		static const std::size_t BUFFER_ALIGNMENT = 4096; // the max supported alignment
+	};
+}
+
+#endif /* BUDDY_ALLOCATOR_HPP */
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "CAllocator.hpp"
+#include <cstdlib> // malloc(), free()
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	namespace
+	{
+		// keeps the user pointer max aligned, like the one returned by malloc()
+		const std::size_t HEADER_SIZE = alignof(std::max_align_t);
+	}
+
+	CAllocator::CAllocator()
+		: Allocator()
+	{}
+
+	CAllocator::~CAllocator()
+	{}
+
+	void CAllocator::Init()
+	{
+		Reset();
+	}
+
+	void CAllocator::Reset()
+	{
+		// the blocks are owned by the caller, we only reset the statistics
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void* CAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+		assert(alignment <= HEADER_SIZE && "Alignment not supported by malloc()");
+
+		void* block = malloc(HEADER_SIZE + size);
+		if (nullptr == block)
+		{
+			return nullptr;
+		}
+
+		*(std::size_t*)block = size;
+
+		mUsed += size;
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)((std::size_t)block + HEADER_SIZE);
+	}
+
+	void CAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		void* block = (void*)((std::size_t)ptr - HEADER_SIZE);
+
+		mUsed -= *(std::size_t*)block;
+
+		free(block);
+	}
+}
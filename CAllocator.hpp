@@ -0,0 +1,32 @@
+#ifndef C_ALLOCATOR_HPP
+#define C_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+
+/*
+CAllocator - forwards everything to malloc()/free().
+Used as the baseline when benchmarking the custom allocators.
+A small header keeps the size of each block so Used()/Peak() can be reported.
+*/
+
+namespace SDA
+{
+	class CAllocator : public Allocator
+	{
+	public:
+		CAllocator();
+		virtual ~CAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+	private:
+		NON_COPY_AND_MOVE(CAllocator)
+	};
+}
+
+#endif /* C_ALLOCATOR_HPP */
\ No newline at end of file
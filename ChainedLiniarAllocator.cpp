@@ -0,0 +1,187 @@
+#include "ChainedLiniarAllocator.hpp"
+#include "MemoryUtility.hpp"
+#include <cstdlib> // malloc(), free()
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	ChainedLiniarAllocator::ChainedLiniarAllocator()
+		: Allocator(), mCurrentBlock(nullptr), mOffset(0), mUsedBefore(0), mBlockCount(0)
+		, mInitialBlockSize(0), mMaxTotalSize(0)
+	{}
+
+	ChainedLiniarAllocator::ChainedLiniarAllocator(const std::size_t initialBlockSize, const std::size_t maxTotalSize)
+		: Allocator(), mCurrentBlock(nullptr), mOffset(0), mUsedBefore(0), mBlockCount(0)
+		, mInitialBlockSize(initialBlockSize), mMaxTotalSize(maxTotalSize)
+	{
+		assert(initialBlockSize > sizeof(Block) && "Initial block size is too small");
+		assert((0 == maxTotalSize || maxTotalSize >= initialBlockSize) && "Max total size is too small");
+	}
+
+	ChainedLiniarAllocator::~ChainedLiniarAllocator()
+	{
+		FreeBlocks(nullptr);
+	}
+
+	void ChainedLiniarAllocator::Init()
+	{
+		FreeBlocks(nullptr);
+
+		mOffset = 0;
+		mUsedBefore = 0;
+		mUsed = 0;
+		mPeak = 0;
+
+		// the first block, the next ones are chained on demand
+		mCurrentBlock = (Block*)malloc(mInitialBlockSize);
+		if (mCurrentBlock)
+		{
+			mCurrentBlock->previous = nullptr;
+			mCurrentBlock->size = mInitialBlockSize;
+
+			mTotalSize = mInitialBlockSize;
+			mBlockCount = 1;
+			mOffset = sizeof(Block);
+		}
+	}
+
+	void ChainedLiniarAllocator::Reset()
+	{
+		// keep only the largest block
+		Block* largestBlock = mCurrentBlock;
+		for (Block* block = mCurrentBlock; block; block = block->previous)
+		{
+			if (block->size > largestBlock->size)
+			{
+				largestBlock = block;
+			}
+		}
+
+		FreeBlocks(largestBlock);
+
+		mOffset = sizeof(Block);
+		mUsedBefore = 0;
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void* ChainedLiniarAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+
+		if (nullptr == mCurrentBlock)
+		{
+			return nullptr;
+		}
+
+		std::size_t currentAddress = (std::size_t)mCurrentBlock + mOffset;
+
+		// in case alignment is needed we find the correct padding
+		std::size_t padding = 0;
+		if ((alignment > 0) && (currentAddress % alignment != 0))
+		{
+			padding = SDA::CalculateMemoryPadding(currentAddress, alignment);
+		}
+
+		// the current block is full, chain a new one
+		if (mOffset + padding + size > mCurrentBlock->size)
+		{
+			if (false == Grow(size, alignment))
+			{
+				return nullptr;
+			}
+
+			currentAddress = (std::size_t)mCurrentBlock + mOffset;
+
+			padding = 0;
+			if ((alignment > 0) && (currentAddress % alignment != 0))
+			{
+				padding = SDA::CalculateMemoryPadding(currentAddress, alignment);
+			}
+		}
+
+		const std::size_t nextAvailableAddress = currentAddress + padding;
+
+		mOffset += (size + padding);
+		// the block headers aren't user allocations, Used() counts only the allocations and their padding like LiniarAllocator
+		mUsed = mUsedBefore + mOffset - sizeof(Block);
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)nextAvailableAddress;
+	}
+
+	void ChainedLiniarAllocator::Free(void* /* ptr */)
+	{
+		// nothing to do, the memory is given back only by Reset()
+		// so the containers can use this allocator as an arena
+	}
+
+	std::size_t ChainedLiniarAllocator::BlockCount() const
+	{
+		return mBlockCount;
+	}
+
+	bool ChainedLiniarAllocator::Grow(const std::size_t size, const std::size_t alignment)
+	{
+		// geometric growth, but big enough for the requested allocation
+		const std::size_t requiredSize = sizeof(Block) + size + alignment;
+		std::size_t blockSize = std::max(mCurrentBlock->size * ORDER_OF_GROWTH, requiredSize);
+
+		if (mMaxTotalSize > 0)
+		{
+			// what is left until the limit
+			const std::size_t availableSize = (mTotalSize < mMaxTotalSize) ? mMaxTotalSize - mTotalSize : 0;
+			if (availableSize < requiredSize)
+			{
+				return false;
+			}
+
+			blockSize = std::min(blockSize, availableSize);
+		}
+
+		Block* block = (Block*)malloc(blockSize);
+		if (nullptr == block)
+		{
+			return false;
+		}
+
+		block->previous = mCurrentBlock;
+		block->size = blockSize;
+
+		mUsedBefore += mOffset - sizeof(Block);
+		mTotalSize += blockSize;
+		++mBlockCount;
+
+		mCurrentBlock = block;
+		mOffset = sizeof(Block);
+
+		return true;
+	}
+
+	void ChainedLiniarAllocator::FreeBlocks(Block* keptBlock)
+	{
+		Block* block = mCurrentBlock;
+		while (block)
+		{
+			Block* previous = block->previous;
+			if (block != keptBlock)
+			{
+				free(block);
+			}
+			block = previous;
+		}
+
+		mCurrentBlock = keptBlock;
+		mTotalSize = 0;
+		mBlockCount = 0;
+
+		if (keptBlock)
+		{
+			keptBlock->previous = nullptr;
+
+			mTotalSize = keptBlock->size;
+			mBlockCount = 1;
+		}
+	}
+}
@@ -0,0 +1,64 @@
+#ifndef CHAINED_LINIAR_ALLOCATOR_HPP
+#define CHAINED_LINIAR_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+
+/*
+ChainedLiniarAllocator - a LiniarAllocator that grows instead of running out of memory.
+When the current block is full a new one is chained, every block is ORDER_OF_GROWTH times
+bigger than the previous one (optionally limited by a max total size).
+Reset() keeps only the largest block, so after a few resets the allocator
+settles on one block big enough for the whole workload.
+
+TIME COMPLEXITY:
+- Allocate = O(1), a new block is allocated only O(log n) times
+- Reset = O(number of blocks)
+
+TotalSize() is the size of all the chained blocks.
+*/
+
+namespace SDA
+{
+	class ChainedLiniarAllocator : public Allocator
+	{
+	public:
+		ChainedLiniarAllocator();
+		// maxTotalSize = 0 means no limit
+		ChainedLiniarAllocator(const std::size_t initialBlockSize, const std::size_t maxTotalSize = 0);
+		virtual ~ChainedLiniarAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		std::size_t BlockCount() const;
+
+	private:
+		NON_COPY_AND_MOVE(ChainedLiniarAllocator)
+
+		// stored at the beginning of every block
+		struct Block
+		{
+			Block* previous;
+			std::size_t size; // header included
+		};
+
+		bool Grow(const std::size_t size, const std::size_t alignment);
+		void FreeBlocks(Block* keptBlock);
+
+		Block* mCurrentBlock;
+		std::size_t mOffset; // in the current block
+		std::size_t mUsedBefore; // used in the previous blocks, headers excluded
+		std::size_t mBlockCount;
+
+		std::size_t mInitialBlockSize;
+		std::size_t mMaxTotalSize;
+
+		static const std::size_t ORDER_OF_GROWTH = 2;
+	};
+}
+
+#endif /* CHAINED_LINIAR_ALLOCATOR_HPP */
\ No newline at end of file
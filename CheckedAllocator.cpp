@@ -0,0 +1,287 @@
+#include "CheckedAllocator.hpp"
+#include "VirtualMemory.hpp"
+#include "MemoryUtility.hpp"
+#include <cstring> // memset()
+#include <cstdlib> // abort()
+#include <algorithm> // max
+#include <iostream>
+#include <cassert>
+
+namespace SDA
+{
+	namespace
+	{
+		inline std::size_t AlignUp(const std::size_t value, const std::size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		// the first byte which is not the pattern, nullptr if all are good
+		const std::uint8_t* FindMismatch(const std::uint8_t* begin, const std::size_t size, const std::uint8_t pattern)
+		{
+			for (const std::uint8_t* byte = begin; byte < begin + size; ++byte)
+			{
+				if (pattern != *byte)
+				{
+					return byte;
+				}
+			}
+
+			return nullptr;
+		}
+	}
+
+	CheckedAllocator::CheckedAllocator(Allocator& allocator, const CheckedAllocatorOptions& options)
+		: Allocator(allocator.TotalSize()), mAllocator(allocator), mOptions(options)
+		, mLiveBlocks(), mErrorCount(0)
+	{
+		assert(0 == mOptions.redZoneSize % alignof(Header) && "The red zone must keep the header aligned");
+	}
+
+	CheckedAllocator::~CheckedAllocator()
+	{
+		// the guard pages are ours, the rest belongs to the wrapped allocator
+		for (const auto& liveBlock : mLiveBlocks)
+		{
+			delete GetHeader(liveBlock.first)->pages;
+		}
+	}
+
+	void CheckedAllocator::Init()
+	{
+		for (const auto& liveBlock : mLiveBlocks)
+		{
+			delete GetHeader(liveBlock.first)->pages;
+		}
+		mLiveBlocks.clear();
+
+		mAllocator.Init();
+
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void CheckedAllocator::Reset()
+	{
+		Validate();
+
+		// the wrapped allocator drops all the blocks at once, we only poison them
+		for (const auto& liveBlock : mLiveBlocks)
+		{
+			Header* header = GetHeader(liveBlock.first);
+			header->block = nullptr;
+
+			Release(liveBlock.first, header);
+		}
+		mLiveBlocks.clear();
+
+		mAllocator.Reset();
+
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void* CheckedAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+		assert((0 == alignment || SDA::IsPowerOfTwo(alignment)) && "Alignment must be a power of 2");
+
+		const std::size_t redZoneSize = mOptions.redZoneSize;
+		const std::size_t blockAlignment = std::max(alignment, alignof(Header));
+
+		// header + front red zone, the user pointer keeps the alignment
+		const std::size_t frontSize = AlignUp(sizeof(Header) + redZoneSize, blockAlignment);
+
+		void* block = nullptr;
+		VirtualMemoryArena* pages = nullptr;
+		std::size_t address = 0;
+
+		if (mOptions.guardPages)
+		{
+			const std::size_t pageSize = VirtualMemoryArena::PageSize();
+			const std::size_t dataSize = AlignUp(frontSize + size, pageSize);
+
+			// only the data pages are committed, the last page stays inaccessible
+			VirtualMemoryOptions options;
+			options.commitGranularity = pageSize;
+
+			pages = new VirtualMemoryArena();
+			if (false == pages->Reserve(dataSize + pageSize, options) || false == pages->Commit(dataSize))
+			{
+				delete pages;
+				return nullptr;
+			}
+
+			block = pages->Base();
+
+			// the block ends as close as the alignment allows to the guard page
+			address = ((std::size_t)block + dataSize - size) & ~(blockAlignment - 1);
+		}
+		else
+		{
+			block = mAllocator.Allocate(frontSize + size + redZoneSize, blockAlignment);
+			if (nullptr == block)
+			{
+				return nullptr;
+			}
+
+			address = (std::size_t)block + frontSize;
+		}
+
+		void* ptr = (void*)address;
+
+		Header* header = GetHeader(ptr);
+		header->magic = ALLOCATED_MAGIC;
+		header->size = size;
+		header->block = block;
+		header->pages = pages;
+
+		memset((void*)(address - redZoneSize), RED_ZONE_PATTERN, redZoneSize);
+		memset((void*)(address + size), RED_ZONE_PATTERN, BackRedZoneSize(ptr, header));
+
+		if (mOptions.poison)
+		{
+			memset(ptr, ALLOCATED_PATTERN, size);
+		}
+
+		mLiveBlocks[ptr] = size;
+
+		mUsed += size;
+		mPeak = std::max(mPeak, mUsed);
+
+		return ptr;
+	}
+
+	void CheckedAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		// we don't touch the memory, the pointer may be anything
+		auto it = mLiveBlocks.find(ptr);
+		if (it == mLiveBlocks.end())
+		{
+			ReportError("Free() of a block which is not live (double free or not allocated by this allocator)", ptr);
+			return;
+		}
+
+		Header* header = GetHeader(ptr);
+		IsCorrupted(ptr, header);
+
+		mUsed -= it->second;
+		mLiveBlocks.erase(it);
+
+		Release(ptr, header);
+	}
+
+	float CheckedAllocator::Fragmentation()
+	{
+		return mAllocator.Fragmentation();
+	}
+
+	std::size_t CheckedAllocator::Validate()
+	{
+		std::size_t corruptedCount = 0;
+		for (const auto& liveBlock : mLiveBlocks)
+		{
+			if (IsCorrupted(liveBlock.first, GetHeader(liveBlock.first)))
+			{
+				++corruptedCount;
+			}
+		}
+
+		return corruptedCount;
+	}
+
+	std::size_t CheckedAllocator::LiveBlockCount() const
+	{
+		return mLiveBlocks.size();
+	}
+
+	std::size_t CheckedAllocator::ErrorCount() const
+	{
+		return mErrorCount;
+	}
+
+	bool CheckedAllocator::IsCorrupted(void* ptr, const Header* header)
+	{
+		const std::size_t address = (std::size_t)ptr;
+		const std::size_t redZoneSize = mOptions.redZoneSize;
+
+		if (ALLOCATED_MAGIC != header->magic || mLiveBlocks[ptr] != header->size)
+		{
+			ReportError("Block header overwritten (buffer underflow)", ptr);
+			return true;
+		}
+
+		if (FindMismatch((const std::uint8_t*)(address - redZoneSize), redZoneSize, RED_ZONE_PATTERN))
+		{
+			ReportError("Front red zone overwritten (buffer underflow)", ptr);
+			return true;
+		}
+
+		if (FindMismatch((const std::uint8_t*)(address + header->size), BackRedZoneSize(ptr, header), RED_ZONE_PATTERN))
+		{
+			ReportError("Back red zone overwritten (buffer overflow)", ptr);
+			return true;
+		}
+
+		return false;
+	}
+
+	void CheckedAllocator::Release(void* ptr, Header* header)
+	{
+		const std::size_t address = (std::size_t)ptr;
+		const std::size_t redZoneSize = mOptions.redZoneSize;
+
+		void* block = header->block;
+		VirtualMemoryArena* pages = header->pages;
+
+		if (mOptions.poison)
+		{
+			memset((void*)(address - redZoneSize), FREED_PATTERN, redZoneSize + header->size + BackRedZoneSize(ptr, header));
+		}
+		header->magic = FREED_MAGIC;
+
+		if (pages)
+		{
+			// unmapped, any later access crashes
+			delete pages;
+		}
+		else if (block)
+		{
+			mAllocator.Free(block);
+		}
+	}
+
+	void CheckedAllocator::ReportError(const char* error, void* ptr)
+	{
+		++mErrorCount;
+
+		if (mOptions.onError)
+		{
+			mOptions.onError(error, ptr);
+			return;
+		}
+
+		std::cerr << "CheckedAllocator: " << error << " at " << ptr << std::endl;
+		std::abort();
+	}
+
+	CheckedAllocator::Header* CheckedAllocator::GetHeader(void* ptr) const
+	{
+		return (Header*)((std::size_t)ptr - mOptions.redZoneSize - sizeof(Header));
+	}
+
+	std::size_t CheckedAllocator::BackRedZoneSize(void* ptr, const Header* header) const
+	{
+		if (header->pages)
+		{
+			return (std::size_t)header->pages->Base() + header->pages->Committed() - ((std::size_t)ptr + header->size);
+		}
+
+		return mOptions.redZoneSize;
+	}
+}
@@ -0,0 +1,138 @@
+#ifndef CHECKED_ALLOCATOR_HPP
+#define CHECKED_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+/*
+CheckedAllocator - finds memory misuse in code running on any Allocator (not owned).
+
+- red zones: every block is surrounded by canary bytes, checked on Free(), Reset() and Validate()
+- poisoning: new blocks are filled with ALLOCATED_PATTERN, freed/reset blocks with FREED_PATTERN,
+  so reads of uninitialized or freed memory show up as 0xCDCD.../0xDDDD...
+- double/invalid Free() are detected, the live blocks are tracked
+- guard pages (optional): every block gets its own pages from the OS (VirtualMemoryArena)
+  and ends right before an inaccessible page, so an overflow crashes at the faulting instruction.
+  The wrapped allocator is not used for these blocks, so it is slow and memory hungry,
+  meant to find the culprit once the canaries reported a corruption.
+
+Not thread safe, wrap it in a LockedAllocator if needed.
+Every error is reported to onError, by default it is printed and the program is aborted.
+
+DebugAllocator - the CheckedAllocator when SDA_ALLOCATOR_CHECKS is defined, otherwise only a
+reference to the allocator, so the checks cost nothing when they are compiled out.
+
+USAGES:
+	SDA::LiniarAllocator arena(1 << 20);
+	SDA::DebugAllocator debugArena(arena);
+	SDA::Vector<int> vec(&debugArena.Get());
+*/
+
+namespace SDA
+{
+	class VirtualMemoryArena;
+
+	struct CheckedAllocatorOptions
+	{
+		typedef std::function<void(const char* error, void* ptr)> OnErrorFunc;
+
+		CheckedAllocatorOptions()
+			: poison(true), guardPages(false), redZoneSize(DEFAULT_RED_ZONE_SIZE), onError()
+		{}
+
+		bool poison;
+		bool guardPages;
+		std::size_t redZoneSize;
+		OnErrorFunc onError; // empty = print and abort
+
+		static const std::size_t DEFAULT_RED_ZONE_SIZE = 16;
+	};
+
+	class CheckedAllocator : public Allocator
+	{
+	public:
+		CheckedAllocator(Allocator& allocator, const CheckedAllocatorOptions& options = CheckedAllocatorOptions());
+		virtual ~CheckedAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		float Fragmentation();
+
+		// checks the red zones of all the live blocks, returns the number of corrupted blocks
+		std::size_t Validate();
+
+		std::size_t LiveBlockCount() const;
+		std::size_t ErrorCount() const;
+
+		static const std::uint8_t ALLOCATED_PATTERN = 0xCD;
+		static const std::uint8_t FREED_PATTERN = 0xDD;
+		static const std::uint8_t RED_ZONE_PATTERN = 0xFD;
+
+	private:
+		NON_COPY_AND_MOVE(CheckedAllocator)
+
+		// stored right before the front red zone
+		struct Header
+		{
+			std::uint32_t magic;
+			std::size_t size; // user size
+			void* block; // what the wrapped allocator returned
+			VirtualMemoryArena* pages; // guard pages only
+		};
+
+		bool IsCorrupted(void* ptr, const Header* header);
+		// poisons and gives the block back
+		void Release(void* ptr, Header* header);
+		void ReportError(const char* error, void* ptr);
+
+		Header* GetHeader(void* ptr) const;
+		// the back red zone ends at the guard page for the guard pages blocks
+		std::size_t BackRedZoneSize(void* ptr, const Header* header) const;
+
+		Allocator& mAllocator;
+		CheckedAllocatorOptions mOptions;
+
+		std::unordered_map<void*, std::size_t> mLiveBlocks; // user pointer -> size
+		std::size_t mErrorCount;
+
+		static const std::uint32_t ALLOCATED_MAGIC = 0xA110CA7E;
+		static const std::uint32_t FREED_MAGIC = 0xF4EEDF4E;
+	};
+
+	class DebugAllocator
+	{
+	public:
+		DebugAllocator(Allocator& allocator, const CheckedAllocatorOptions& options = CheckedAllocatorOptions())
+#ifdef SDA_ALLOCATOR_CHECKS
+			: mAllocator(allocator, options)
+#else
+			: mAllocator(allocator)
+#endif
+		{
+#ifndef SDA_ALLOCATOR_CHECKS
+			(void)options; // the checks are compiled out
+#endif
+		}
+
+		// the allocator the code should use
+		Allocator& Get() { return mAllocator; }
+
+	private:
+		NON_COPY_AND_MOVE(DebugAllocator)
+
+#ifdef SDA_ALLOCATOR_CHECKS
+		CheckedAllocator mAllocator;
+#else
+		Allocator& mAllocator;
+#endif
+	};
+}
+
+#endif /* CHECKED_ALLOCATOR_HPP */
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 CircularSinglyLinkedList - a type of collection/container to store elements of the same type
@@ -69,7 +70,8 @@ namespace SDA
 	class CircularSinglyLinkedList
 	{
 	public:
-		CircularSinglyLinkedList();
+		// nullptr allocator means the global heap
+		CircularSinglyLinkedList(Allocator* allocator = nullptr);
 		CircularSinglyLinkedList(const CircularSinglyLinkedList<T>& list);
 		CircularSinglyLinkedList(CircularSinglyLinkedList<T>&& list);
 		virtual ~CircularSinglyLinkedList();
@@ -92,6 +94,8 @@ namespace SDA
 		void Reverse();
 		void InsertionSort();
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const CircularSinglyLinkedList<T>& list);
 		void Move(CircularSinglyLinkedList<T>&& list);
@@ -99,6 +103,8 @@ namespace SDA
 
 		CircularSinglyLinkedList<T>* mHeadPtr;
 		size_t mSize;
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -108,18 +114,20 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	CircularSinglyLinkedList<T>::CircularSinglyLinkedList()
-		: mHeadPtr(nullptr), mSize(0)
+	CircularSinglyLinkedList<T>::CircularSinglyLinkedList(Allocator* allocator)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(allocator)
 	{}
 
 	template <class T>
 	CircularSinglyLinkedList<T>::CircularSinglyLinkedList(const CircularSinglyLinkedList<T>& list)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(list.mAllocator) // the copy uses the same allocator
 	{
 		Copy(list);
 	}
 
 	template <class T>
 	CircularSinglyLinkedList<T>::CircularSinglyLinkedList(CircularSinglyLinkedList<T>&& list)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(list.mAllocator)
 	{
 		Move(list);
 	}
@@ -157,6 +165,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of list
+			mAllocator = list.mAllocator;
+
 			mSize = list.mSize;
 
 			mHeadPtr = list.mHeadPtr;
@@ -171,12 +182,12 @@ namespace SDA
 		while (crrNode && (crrNodePtr->nextPtr != mHeadPtr))
 		{
 			mHeadPtr = crrNodePtr->nextPtr;
-			delete crrNodePtr;
+			SDA::Delete(mAllocator, crrNodePtr);
 			crrNodePtr = mHeadPtr;
 		}
 
 		if (crrNodePtr)
-			delete crrNodePtr;
+			SDA::Delete(mAllocator, crrNodePtr);
 
 		mHeadPtr = nullptr;
 		mSize = 0;
@@ -198,6 +209,12 @@ namespace SDA
 		return *this;
 	}
 
+	template <class T>
+	Allocator* CircularSinglyLinkedList<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	CircularSinglyLinkedListNode<T>* CircularSinglyLinkedList<T>::First() const
 	{
@@ -213,7 +230,7 @@ namespace SDA
 	template <class T>
 	void CircularSinglyLinkedList<T>::InsertFirst(const T& val)
 	{
-		CircularSinglyLinkedListNode<T>* newNodePtr = new CircularSinglyLinkedListNode<T>(val);
+		CircularSinglyLinkedListNode<T>* newNodePtr = SDA::New<CircularSinglyLinkedListNode<T>>(mAllocator, val);
 
 		// we can insert even if the lsit is empty
 
@@ -234,7 +251,7 @@ namespace SDA
 	template <class T>
 	void CircularSinglyLinkedList<T>::InsertLast(const T& val)
 	{
-		CircularSinglyLinkedListNode<T>* newNodePtr = new CircularSinglyLinkedListNode<T>(val);
+		CircularSinglyLinkedListNode<T>* newNodePtr = SDA::New<CircularSinglyLinkedListNode<T>>(mAllocator, val);
 
 		if (mHeadPtr)
 		{
@@ -272,7 +289,7 @@ namespace SDA
 		}
 		else // in between
 		{
-			CircularSinglyLinkedListNode<T>* newNodePtr = new CircularSinglyLinkedListNode<T>(val);
+			CircularSinglyLinkedListNode<T>* newNodePtr = SDA::New<CircularSinglyLinkedListNode<T>>(mAllocator, val);
 
 			size_t idx = -1; // we start with an an index before to arrive at the node before the one we must insert the new node 
 			CircularSinglyLinkedListNode<T>* beforeNode = nullptr;
@@ -306,7 +323,7 @@ namespace SDA
 		mHeadPtr = mHeadPtr->nextPtr;
 
 		nodeToDeletePtr->nextPtr = nullptr;
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -342,7 +359,7 @@ namespace SDA
 		}
 
 		nodeToDeletePtr->nextPtr = nullptr;
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -379,7 +396,7 @@ namespace SDA
 			}
 
 			nodeToDeletePtr->nextPtr = nullptr;
-			delete nodeToDeletePtr;
+			SDA::Delete(mAllocator, nodeToDeletePtr);
 			--mSize;
 		}
 	}
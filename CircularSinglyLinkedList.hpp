@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 SinglyLinkedList - a type of collection/container to store elements of the same type
@@ -79,7 +80,8 @@ namespace SDA
 	class SinglyLinkedList
 	{
 	public:
-		SinglyLinkedList();
+		// nullptr allocator means the global heap
+		SinglyLinkedList(Allocator* allocator = nullptr);
 		SinglyLinkedList(const SinglyLinkedList<T>& list);
 		SinglyLinkedList(SinglyLinkedList<T>&& list);
 		virtual ~SinglyLinkedList();
@@ -102,6 +104,8 @@ namespace SDA
 		void Reverse();
 		void InsertionSort();
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const SinglyLinkedList<T>& list);
 		void Move(SinglyLinkedList<T>&& list);
@@ -109,6 +113,8 @@ namespace SDA
 
 		SinglyLinkedListNode<T>* mHeadPtr;
 		size_t mSize;
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -118,18 +124,20 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	SinglyLinkedList<T>::SinglyLinkedList()
-		: mHeadPtr(nullptr), mSize(0)
+	SinglyLinkedList<T>::SinglyLinkedList(Allocator* allocator)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(allocator)
 	{}
 
 	template <class T>
 	SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList<T>& list)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(list.mAllocator) // the copy uses the same allocator
 	{
 		Copy(list);
 	}
 
 	template <class T>
 	SinglyLinkedList<T>::SinglyLinkedList(SinglyLinkedList<T>&& list)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(list.mAllocator)
 	{
 		Move(list);
 	}
@@ -162,6 +170,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of list
+			mAllocator = list.mAllocator;
+
 			mSize = list.mSize;
 
 			mHeadPtr = list.mHeadPtr;
@@ -176,7 +187,7 @@ namespace SDA
 		while (crrNode != nullptr)
 		{
 			mHeadPtr = crrNode->nextPtr;
-			delete crrNode;
+			SDA::Delete(mAllocator, crrNode);
 			crrNode = mHeadPtr;
 		}
 
@@ -200,6 +211,12 @@ namespace SDA
 		return *this;
 	}
 
+	template <class T>
+	Allocator* SinglyLinkedList<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	SinglyLinkedListNode<T>* SinglyLinkedList<T>::First() const
 	{
@@ -215,7 +232,7 @@ namespace SDA
 	template <class T>
 	void SinglyLinkedList<T>::InsertFirst(const T& val)
 	{
-		SinglyLinkedListNode<T>* newNodePtr = new SinglyLinkedListNode<T>(val);
+		SinglyLinkedListNode<T>* newNodePtr = SDA::New<SinglyLinkedListNode<T>>(mAllocator, val);
 
 		// we can insert even if the lsit is empty
 
@@ -231,7 +248,7 @@ namespace SDA
 	template <class T>
 	void SinglyLinkedList<T>::InsertLast(const T& val)
 	{
-		SinglyLinkedListNode<T>* newNodePtr = new SinglyLinkedListNode<T>(val);
+		SinglyLinkedListNode<T>* newNodePtr = SDA::New<SinglyLinkedListNode<T>>(mAllocator, val);
 
 		if (mHeadPtr)
 		{
@@ -267,7 +284,7 @@ namespace SDA
 		}
 		else // in between
 		{
-			SinglyLinkedListNode<T>* newNodePtr = new SinglyLinkedListNode<T>(val);
+			SinglyLinkedListNode<T>* newNodePtr = SDA::New<SinglyLinkedListNode<T>>(mAllocator, val);
 
 			size_t idx = -1; // we start with an an index before to arrive at the node before the one we must insert the new node 
 			SinglyLinkedListNode<T>* beforeNode = nullptr;
@@ -300,7 +317,7 @@ namespace SDA
 
 		mHeadPtr = mHeadPtr->nextPtr;
 
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -333,7 +350,7 @@ namespace SDA
 			crrNodePtr->nextPtr = nullptr;
 		}
 
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -369,7 +386,7 @@ namespace SDA
 				++idx;
 			}
 
-			delete nodeToDeletePtr;
+			SDA::Delete(mAllocator, nodeToDeletePtr);
 			--mSize;
 		}
 	}
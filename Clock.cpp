@@ -0,0 +1,121 @@
+#include "Clock.hpp"
+
+#if SDA_HAS_TSC && !defined(_MSC_VER)
+#include <cpuid.h> // __get_cpuid()
+#endif
+
+namespace SDA
+{
+	namespace
+	{
+		bool CpuId(const unsigned int leaf, unsigned int registers[4])
+		{
+#if SDA_HAS_TSC && defined(_MSC_VER)
+			int maxLeaf[4];
+			__cpuid(maxLeaf, (int)(leaf & 0x80000000));
+			if ((unsigned int)maxLeaf[0] < leaf)
+			{
+				return false;
+			}
+
+			__cpuid((int*)registers, (int)leaf);
+			return true;
+#elif SDA_HAS_TSC
+			return 0 != __get_cpuid(leaf, &registers[0], &registers[1], &registers[2], &registers[3]);
+#else
+			return false;
+#endif
+		}
+	}
+
+	bool TscClock::IsAvailable()
+	{
+		return GetCalibration().isAvailable;
+	}
+
+	double TscClock::Frequency()
+	{
+		return GetCalibration().frequency;
+	}
+
+	const TscClock::Calibration& TscClock::GetCalibration()
+	{
+		static const Calibration calibration = Calibrate();
+
+		return calibration;
+	}
+
+	TscClock::Calibration TscClock::Calibrate()
+	{
+		Calibration calibration;
+		calibration.isAvailable = false;
+		calibration.frequency = 0.0;
+		calibration.nanosecondsPerTick = 0.0;
+		calibration.baseTicks = 0;
+		calibration.baseNanoseconds = 0;
+
+		if (false == IsInvariant())
+		{
+			return calibration;
+		}
+
+		// the steady_clock read is bracketed by two TSC reads, the middle one is the closest
+		std::uint64_t ticksBefore = ReadTicksOrdered();
+		const std::uint64_t startNanoseconds = SteadyNow();
+		std::uint64_t ticksAfter = ReadTicksOrdered();
+		const std::uint64_t startTicks = ticksBefore + (ticksAfter - ticksBefore) / 2;
+
+		// busy wait, a sleep could be longer and the core could change its frequency
+		const std::uint64_t calibrationNanoseconds = (std::uint64_t)CALIBRATION_MILISECONDS * 1000000;
+		std::uint64_t endNanoseconds = SteadyNow();
+		while (endNanoseconds - startNanoseconds < calibrationNanoseconds)
+		{
+			endNanoseconds = SteadyNow();
+		}
+
+		ticksBefore = ReadTicksOrdered();
+		endNanoseconds = SteadyNow();
+		ticksAfter = ReadTicksOrdered();
+		const std::uint64_t endTicks = ticksBefore + (ticksAfter - ticksBefore) / 2;
+
+		if (endTicks <= startTicks)
+		{
+			return calibration;
+		}
+
+		const double frequency = (double)(endTicks - startTicks) * 1e9 / (double)(endNanoseconds - startNanoseconds);
+
+		// a TSC slower than 100MHz is not trusted
+		if (frequency < 1e8)
+		{
+			return calibration;
+		}
+
+		calibration.isAvailable = true;
+		calibration.frequency = frequency;
+		calibration.nanosecondsPerTick = 1e9 / frequency;
+		calibration.baseTicks = endTicks;
+		calibration.baseNanoseconds = endNanoseconds;
+
+		return calibration;
+	}
+
+	bool TscClock::IsInvariant()
+	{
+		unsigned int registers[4] = { 0, 0, 0, 0 };
+
+		// rdtscp: CPUID 0x80000001, EDX bit 27
+		if (false == CpuId(0x80000001, registers) || 0 == (registers[3] & (1u << 27)))
+		{
+			return false;
+		}
+
+		// invariant TSC: CPUID 0x80000007, EDX bit 8
+		if (false == CpuId(0x80000007, registers) || 0 == (registers[3] & (1u << 8)))
+		{
+			return false;
+		}
+
+		return true;
+	}
+}
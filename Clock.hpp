@@ -0,0 +1,121 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <cstdint>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h> // __rdtsc(), __rdtscp()
+#define SDA_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc(), __rdtscp()
+#define SDA_HAS_TSC 1
+#else
+#define SDA_HAS_TSC 0
+#endif
+
+/*
+TscClock - reads the CPU time stamp counter (rdtsc), a few nanoseconds per read
+instead of the 20-30ns of steady_clock / high_resolution_clock.
+
+The TSC frequency is calibrated once against steady_clock on the first use (a ~20ms busy wait,
+call IsAvailable() before the measurements to pay it earlier) and Now() returns nanoseconds
+on the steady_clock epoch, so both clocks can be mixed.
+The TSC is used only if the CPU says it is invariant (constant rate in every P/C-state,
+synchronized between the cores) and supports rdtscp, otherwise Now() falls back to steady_clock.
+
+ReadTicks() - rdtsc, may be reordered with the instructions around it
+ReadTicksOrdered() - rdtscp, waits for the previous instructions to finish,
+use it to end a measurement
+
+USAGES:
+	const std::uint64_t start = SDA::ClockNow(SDA::CLOCK_TSC);
+	...
+	const std::uint64_t elapsed = SDA::ClockNow(SDA::CLOCK_TSC) - start; // nanoseconds
+*/
+
+namespace SDA
+{
+	enum ClockSource
+	{
+		CLOCK_STEADY = 0,
+		CLOCK_TSC // steady_clock if the TSC can't be used
+	};
+
+	class TscClock
+	{
+	public:
+		// true if the TSC is invariant and calibrated
+		static bool IsAvailable();
+		// ticks per second, 0 if not available
+		static double Frequency();
+
+		static std::uint64_t ReadTicks();
+		static std::uint64_t ReadTicksOrdered();
+
+		// nanoseconds on the steady_clock epoch
+		static std::uint64_t Now();
+		static std::uint64_t SteadyNow();
+
+	private:
+		TscClock() = delete;
+
+		struct Calibration
+		{
+			bool isAvailable;
+			double frequency;
+			double nanosecondsPerTick;
+			std::uint64_t baseTicks;
+			std::uint64_t baseNanoseconds;
+		};
+
+		static const Calibration& GetCalibration();
+		static Calibration Calibrate();
+		static bool IsInvariant();
+
+		static const int CALIBRATION_MILISECONDS = 20;
+	};
+
+	inline std::uint64_t TscClock::ReadTicks()
+	{
+#if SDA_HAS_TSC
+		return __rdtsc();
+#else
+		return SteadyNow();
+#endif
+	}
+
+	inline std::uint64_t TscClock::ReadTicksOrdered()
+	{
+#if SDA_HAS_TSC
+		unsigned int processor;
+		return __rdtscp(&processor);
+#else
+		return SteadyNow();
+#endif
+	}
+
+	inline std::uint64_t TscClock::SteadyNow()
+	{
+		return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	inline std::uint64_t TscClock::Now()
+	{
+		static const Calibration& calibration = GetCalibration();
+
+		if (false == calibration.isAvailable)
+		{
+			return SteadyNow();
+		}
+
+		return calibration.baseNanoseconds + (std::int64_t)((double)(std::int64_t)(ReadTicks() - calibration.baseTicks) * calibration.nanosecondsPerTick);
+	}
+
+	inline std::uint64_t ClockNow(const ClockSource source)
+	{
+		return (CLOCK_TSC == source) ? TscClock::Now() : TscClock::SteadyNow();
+	}
+}
+
+#endif /* CLOCK_HPP */
\ No newline at end of file
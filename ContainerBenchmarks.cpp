@@ -0,0 +1,1377 @@
+#include "Benchmark.hpp"
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "SmallVector.hpp"
+#include "SegmentedVector.hpp"
+#include "SoAVector.hpp"
+#include "BitVector.hpp"
+#include "FixedQueue.hpp"
+#include "FixedStack.hpp"
+#include "DynamicQueue.hpp"
+#include "DynamicStack.hpp"
+#include "SinglyLinkedList.hpp"
+#include "DoublyLinkedList.hpp"
+#include "BinarySearchTree.hpp"
+#include "LiniarSet.hpp"
+#include "Graph.hpp"
+#include "Pair.hpp"
+#include "Sort.hpp"
+#include "Search.hpp"
+#include "Clock.hpp"
+#include <algorithm> // sort, shuffle
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+The registered benchmarks of the containers and algorithms, see Benchmark.hpp.
+Every container is measured with int, double and std::string elements (the way we use them),
+the O(n^2) ones are skipped above QUADRATIC_MAX_SIZE.
+*/
+
+namespace SDA
+{
+	template <> inline const char* BenchmarkTypeName<SDA::Vector<int>>() { return "Vector<int>"; }
+
+	// the (key, value) records of the sort benchmarks
+	typedef SDA::Pair<std::int64_t, std::int64_t> Int64Pair;
+	template <> inline const char* BenchmarkTypeName<Int64Pair>() { return "Pair<int64,int64>"; }
+
+	template <>
+	inline Int64Pair BenchmarkValue<Int64Pair>(const std::size_t index)
+	{
+		return Int64Pair((std::int64_t)index, (std::int64_t)index * 2);
+	}
+
+	namespace
+	{
+		const std::size_t QUADRATIC_MAX_SIZE = 4096;
+		const unsigned int RANDOM_SEED = 42; // same input for every run
+
+		// size distinct values in random order
+		template <class T>
+		SDA::Vector<T> RandomValues(const std::size_t size)
+		{
+			std::vector<std::size_t> indices(size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				indices[i] = i;
+			}
+
+			std::mt19937 generator(RANDOM_SEED);
+			std::shuffle(indices.begin(), indices.end(), generator);
+
+			SDA::Vector<T> values;
+			values.Reserve(size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				values.PushBack(BenchmarkValue<T>(indices[i]));
+			}
+
+			return values;
+		}
+
+		template <class T>
+		SDA::Vector<T> SortedValues(const std::size_t size)
+		{
+			SDA::Vector<T> values = RandomValues<T>(size);
+			std::sort(values.GetData(), values.GetData() + values.Size());
+
+			return values;
+		}
+
+		/////////// Vector /////////////
+
+		template <class T>
+		void VectorPushBack(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec;
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					vec.PushBack(values[i]);
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void VectorPushBackReserved(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec;
+				vec.Reserve(values.Size());
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					vec.PushBack(values[i]);
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void VectorIterate(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					DoNotOptimize(values[i]);
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void VectorCopy(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec(values);
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// doubles the capacity of a full vector, the items are the relocated elements
+		template <class T>
+		void VectorGrow(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				state.PauseTiming();
+				SDA::Vector<T> vec;
+				vec.Reserve(values.Size());
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					vec.PushBack(values[i]);
+				}
+				state.ResumeTiming();
+
+				vec.Reserve(2 * values.Size());
+				DoNotOptimize(vec);
+
+				// the destruction isn't part of the growth
+				state.PauseTiming();
+				vec = SDA::Vector<T>();
+				state.ResumeTiming();
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		/*
+		   The non trivial elements (std::string, Vector<int>) are built from
+		   (ELEMENT_LENGTH, fill), the same arguments for SDA::Vector and std::vector.
+		*/
+		const std::size_t ELEMENT_LENGTH = 32;
+
+		template <class T>
+		struct ElementFill;
+
+		template <>
+		struct ElementFill<std::string>
+		{
+			static char Get(const std::size_t index) { return static_cast<char>('a' + index % 26); }
+		};
+
+		template <>
+		struct ElementFill<SDA::Vector<int>>
+		{
+			static int Get(const std::size_t index) { return static_cast<int>(index); }
+		};
+
+		template <class T>
+		SDA::Vector<T> ElementValues(const std::size_t size)
+		{
+			SDA::Vector<T> values;
+			values.Reserve(size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				values.EmplaceBack(ELEMENT_LENGTH, ElementFill<T>::Get(i));
+			}
+
+			return values;
+		}
+
+		template <class T>
+		void VectorEmplaceBack(BenchmarkState& state)
+		{
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec;
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					vec.EmplaceBack(ELEMENT_LENGTH, ElementFill<T>::Get(i));
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void StdVectorEmplaceBack(BenchmarkState& state)
+		{
+			while (state.KeepRunning())
+			{
+				std::vector<T> vec;
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					vec.emplace_back(ELEMENT_LENGTH, ElementFill<T>::Get(i));
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// the elements are moved in, building the source isn't measured
+		template <class T>
+		void VectorPushBackMove(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = ElementValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				state.PauseTiming();
+				SDA::Vector<T> source(values);
+				state.ResumeTiming();
+
+				SDA::Vector<T> vec;
+				for (std::size_t i = 0; i < source.Size(); ++i)
+				{
+					vec.PushBack(std::move(source[i]));
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void StdVectorPushBackMove(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = ElementValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				state.PauseTiming();
+				SDA::Vector<T> source(values);
+				state.ResumeTiming();
+
+				std::vector<T> vec;
+				for (std::size_t i = 0; i < source.Size(); ++i)
+				{
+					vec.push_back(std::move(source[i]));
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// the middle insertion shifts the elements, skipped above QUADRATIC_MAX_SIZE
+		template <class T>
+		void VectorEmplaceMiddle(BenchmarkState& state)
+		{
+			if (state.Size() > QUADRATIC_MAX_SIZE)
+			{
+				state.Skip("O(n^2)");
+				return;
+			}
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec;
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					vec.Emplace(vec.Size() / 2, ELEMENT_LENGTH, ElementFill<T>::Get(i));
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void StdVectorEmplaceMiddle(BenchmarkState& state)
+		{
+			if (state.Size() > QUADRATIC_MAX_SIZE)
+			{
+				state.Skip("O(n^2)");
+				return;
+			}
+
+			while (state.KeepRunning())
+			{
+				std::vector<T> vec;
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					vec.emplace(vec.begin() + vec.size() / 2, ELEMENT_LENGTH, ElementFill<T>::Get(i));
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void VectorAppend(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = ElementValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec;
+				vec.Append(values.GetData(), values.GetData() + values.Size());
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void StdVectorAppend(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = ElementValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				std::vector<T> vec;
+				vec.insert(vec.end(), values.GetData(), values.GetData() + values.Size());
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBack", VectorPushBack, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBack", VectorPushBack, double);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBack", VectorPushBack, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBackReserved", VectorPushBackReserved, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBackReserved", VectorPushBackReserved, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/Iterate", VectorIterate, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/Iterate", VectorIterate, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/Copy", VectorCopy, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/Copy", VectorCopy, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/Grow", VectorGrow, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/Grow", VectorGrow, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/EmplaceBack", VectorEmplaceBack, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/EmplaceBack", VectorEmplaceBack, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("StdVector/EmplaceBack", StdVectorEmplaceBack, std::string);
+		SDA_BENCHMARK_TEMPLATE("StdVector/EmplaceBack", StdVectorEmplaceBack, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBackMove", VectorPushBackMove, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBackMove", VectorPushBackMove, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("StdVector/PushBackMove", StdVectorPushBackMove, std::string);
+		SDA_BENCHMARK_TEMPLATE("StdVector/PushBackMove", StdVectorPushBackMove, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("Vector/EmplaceMiddle", VectorEmplaceMiddle, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/EmplaceMiddle", VectorEmplaceMiddle, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("StdVector/EmplaceMiddle", StdVectorEmplaceMiddle, std::string);
+		SDA_BENCHMARK_TEMPLATE("StdVector/EmplaceMiddle", StdVectorEmplaceMiddle, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("Vector/Append", VectorAppend, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/Append", VectorAppend, SDA::Vector<int>);
+		SDA_BENCHMARK_TEMPLATE("StdVector/Append", StdVectorAppend, std::string);
+		SDA_BENCHMARK_TEMPLATE("StdVector/Append", StdVectorAppend, SDA::Vector<int>);
+
+		/////////// SmallVector /////////////
+
+		// Size() short lived vectors of SMALL_ELEMENTS elements, they fit in SMALL_INLINE_CAPACITY
+		const std::size_t SMALL_ELEMENTS = 6;
+		const std::size_t SMALL_INLINE_CAPACITY = 8;
+
+		template <class T>
+		void VectorShortLived(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(SMALL_ELEMENTS);
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					SDA::Vector<T> vec;
+					for (std::size_t j = 0; j < values.Size(); ++j)
+					{
+						vec.PushBack(values[j]);
+					}
+					DoNotOptimize(vec);
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void SmallVectorShortLived(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(SMALL_ELEMENTS);
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					SDA::SmallVector<T, SMALL_INLINE_CAPACITY> vec;
+					for (std::size_t j = 0; j < values.Size(); ++j)
+					{
+						vec.PushBack(values[j]);
+					}
+					DoNotOptimize(vec);
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// a small vector is built and moved into a container, like the results returned by value
+		template <class T>
+		void VectorMoveSmall(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(SMALL_ELEMENTS);
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<SDA::Vector<T>> vectors;
+				vectors.Reserve(state.Size());
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					SDA::Vector<T> vec;
+					vec.Append(values.GetData(), values.GetData() + values.Size());
+					vectors.PushBack(std::move(vec));
+				}
+				DoNotOptimize(vectors);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void SmallVectorMoveSmall(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(SMALL_ELEMENTS);
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<SDA::SmallVector<T, SMALL_INLINE_CAPACITY>> vectors;
+				vectors.Reserve(state.Size());
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					SDA::SmallVector<T, SMALL_INLINE_CAPACITY> vec;
+					vec.Append(values.GetData(), values.GetData() + values.Size());
+					vectors.PushBack(std::move(vec));
+				}
+				DoNotOptimize(vectors);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("Vector/ShortLived", VectorShortLived, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/ShortLived", VectorShortLived, std::string);
+		SDA_BENCHMARK_TEMPLATE("SmallVector/ShortLived", SmallVectorShortLived, int);
+		SDA_BENCHMARK_TEMPLATE("SmallVector/ShortLived", SmallVectorShortLived, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/MoveSmall", VectorMoveSmall, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/MoveSmall", VectorMoveSmall, std::string);
+		SDA_BENCHMARK_TEMPLATE("SmallVector/MoveSmall", SmallVectorMoveSmall, int);
+		SDA_BENCHMARK_TEMPLATE("SmallVector/MoveSmall", SmallVectorMoveSmall, std::string);
+
+		/////////// SegmentedVector /////////////
+
+		template <class T>
+		void SegmentedVectorPushBack(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::SegmentedVector<T> vec;
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					vec.PushBack(values[i]);
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// every PushBack() is timed, the doubling shows up in the tail latency
+		template <class T>
+		void VectorPushBackLatency(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::Vector<T> vec;
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					const std::uint64_t start = TscClock::Now();
+					vec.PushBack(values[i]);
+					state.RecordLatency(TscClock::Now() - start);
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void SegmentedVectorPushBackLatency(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::SegmentedVector<T> vec;
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					const std::uint64_t start = TscClock::Now();
+					vec.PushBack(values[i]);
+					state.RecordLatency(TscClock::Now() - start);
+				}
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void SegmentedVectorIndex(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::SegmentedVector<T> vec;
+			for (std::size_t i = 0; i < values.Size(); ++i)
+			{
+				vec.PushBack(values[i]);
+			}
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < vec.Size(); ++i)
+				{
+					DoNotOptimize(vec[i]);
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void SegmentedVectorIterate(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::SegmentedVector<T> vec;
+			for (std::size_t i = 0; i < values.Size(); ++i)
+			{
+				vec.PushBack(values[i]);
+			}
+
+			while (state.KeepRunning())
+			{
+				vec.ForEach([](const T& element)
+				{
+					DoNotOptimize(element);
+				});
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/PushBack", SegmentedVectorPushBack, int);
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/PushBack", SegmentedVectorPushBack, std::string);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBackLatency", VectorPushBackLatency, int);
+		SDA_BENCHMARK_TEMPLATE("Vector/PushBackLatency", VectorPushBackLatency, std::string);
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/PushBackLatency", SegmentedVectorPushBackLatency, int);
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/PushBackLatency", SegmentedVectorPushBackLatency, std::string);
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/Index", SegmentedVectorIndex, int);
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/Iterate", SegmentedVectorIterate, int);
+		SDA_BENCHMARK_TEMPLATE("SegmentedVector/Iterate", SegmentedVectorIterate, std::string);
+
+		/////////// SoAVector /////////////
+
+		// an order row, a scan reads only category and price (12 of the 40 bytes)
+		struct Record
+		{
+			std::int64_t id;
+			double price;
+			std::int32_t quantity;
+			std::int32_t category;
+			double weight;
+			std::int64_t timestamp;
+		};
+
+		typedef SDA::SoAVector<std::int64_t, double, std::int32_t, std::int32_t, double, std::int64_t> RecordColumns;
+
+		const std::int32_t CATEGORY_COUNT = 16;
+		const std::int32_t SELECTED_CATEGORY = 3;
+
+		Record MakeRecord(const std::size_t index, std::mt19937& generator)
+		{
+			Record record;
+			record.id = static_cast<std::int64_t>(index);
+			record.price = static_cast<double>(generator() % 10000) / 100.0;
+			record.quantity = static_cast<std::int32_t>(generator() % 100);
+			record.category = static_cast<std::int32_t>(generator() % CATEGORY_COUNT);
+			record.weight = static_cast<double>(generator() % 1000) / 10.0;
+			record.timestamp = static_cast<std::int64_t>(index) * 1000;
+
+			return record;
+		}
+
+		// sum of the prices of one category, Size() rows
+		void AoSFilterSum(BenchmarkState& state)
+		{
+			std::mt19937 generator(RANDOM_SEED);
+			SDA::Vector<Record> records;
+			records.Reserve(state.Size());
+			for (std::size_t i = 0; i < state.Size(); ++i)
+			{
+				records.PushBack(MakeRecord(i, generator));
+			}
+
+			while (state.KeepRunning())
+			{
+				double sum = 0.0;
+				const Record* data = records.GetData();
+				for (std::size_t i = 0; i < records.Size(); ++i)
+				{
+					sum += (data[i].category == SELECTED_CATEGORY) ? data[i].price : 0.0;
+				}
+				DoNotOptimize(sum);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void SoAFilterSum(BenchmarkState& state)
+		{
+			std::mt19937 generator(RANDOM_SEED);
+			RecordColumns records;
+			records.Reserve(state.Size());
+			for (std::size_t i = 0; i < state.Size(); ++i)
+			{
+				const Record record = MakeRecord(i, generator);
+				records.EmplaceBack(record.id, record.price, record.quantity, record.category, record.weight, record.timestamp);
+			}
+
+			while (state.KeepRunning())
+			{
+				double sum = 0.0;
+				records.ForEachOf<1, 3>([&sum](const double price, const std::int32_t category)
+				{
+					sum += (category == SELECTED_CATEGORY) ? price : 0.0;
+				});
+				DoNotOptimize(sum);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK("AoS/FilterSum", AoSFilterSum);
+		SDA_BENCHMARK("SoAVector/FilterSum", SoAFilterSum);
+
+		/////////// BitVector /////////////
+
+		// every third bit is set, in random order
+		void FillBits(SDA::BitVector& bits, std::vector<bool>& stdBits, const std::size_t size)
+		{
+			bits.Resize(size);
+			stdBits.assign(size, false);
+
+			std::mt19937 generator(RANDOM_SEED);
+			for (std::size_t i = 0; i < size / 3; ++i)
+			{
+				const std::size_t index = generator() % size;
+				bits.Set(index);
+				stdBits[index] = true;
+			}
+		}
+
+		void BitVectorSetTest(BenchmarkState& state)
+		{
+			SDA::BitVector bits(state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < state.Size(); i += 3)
+				{
+					bits.Set(i);
+				}
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					count += bits.Test(i);
+				}
+				DoNotOptimize(count);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void StdVectorBoolSetTest(BenchmarkState& state)
+		{
+			std::vector<bool> bits(state.Size(), false);
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < state.Size(); i += 3)
+				{
+					bits[i] = true;
+				}
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					count += bits[i];
+				}
+				DoNotOptimize(count);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void BitVectorCount(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+
+			while (state.KeepRunning())
+			{
+				DoNotOptimize(bits.Count());
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void StdVectorBoolCount(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+
+			while (state.KeepRunning())
+			{
+				DoNotOptimize(std::count(stdBits.begin(), stdBits.end(), true));
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// a |= b, then a &= b
+		void BitVectorAndOr(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+			SDA::BitVector other(bits);
+			other.FlipAll();
+
+			while (state.KeepRunning())
+			{
+				SDA::BitVector result(bits);
+				result |= other;
+				result &= bits;
+				DoNotOptimize(result);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void StdVectorBoolAndOr(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+			std::vector<bool> other(stdBits);
+			other.flip();
+
+			while (state.KeepRunning())
+			{
+				std::vector<bool> result(stdBits);
+				for (std::size_t i = 0; i < result.size(); ++i)
+				{
+					result[i] = result[i] || other[i];
+				}
+				for (std::size_t i = 0; i < result.size(); ++i)
+				{
+					result[i] = result[i] && stdBits[i];
+				}
+				DoNotOptimize(result);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// visits the set bits
+		void BitVectorFindNext(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = bits.FindFirst(); i != SDA::BitVector::NOT_FOUND; i = bits.FindNext(i))
+				{
+					DoNotOptimize(i);
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void StdVectorBoolFindNext(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < stdBits.size(); ++i)
+				{
+					if (stdBits[i])
+					{
+						DoNotOptimize(i);
+					}
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// Size() rank and select queries
+		void BitVectorRankSelect(BenchmarkState& state)
+		{
+			SDA::BitVector bits;
+			std::vector<bool> stdBits;
+			FillBits(bits, stdBits, state.Size());
+			bits.BuildRankSelect();
+			const std::size_t count = bits.Count();
+
+			// FillBits() sets size / 3 bits, none below 3, Select() needs one
+			if (0 == count)
+			{
+				state.Skip("no bit set");
+				return;
+			}
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < state.Size(); ++i)
+				{
+					DoNotOptimize(bits.Rank(i));
+					DoNotOptimize(bits.Select(i % count));
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK("BitVector/SetTest", BitVectorSetTest);
+		SDA_BENCHMARK("StdVectorBool/SetTest", StdVectorBoolSetTest);
+		SDA_BENCHMARK("BitVector/Count", BitVectorCount);
+		SDA_BENCHMARK("StdVectorBool/Count", StdVectorBoolCount);
+		SDA_BENCHMARK("BitVector/AndOr", BitVectorAndOr);
+		SDA_BENCHMARK("StdVectorBool/AndOr", StdVectorBoolAndOr);
+		SDA_BENCHMARK("BitVector/FindNext", BitVectorFindNext);
+		SDA_BENCHMARK("StdVectorBool/FindNext", StdVectorBoolFindNext);
+		SDA_BENCHMARK("BitVector/RankSelect", BitVectorRankSelect);
+
+		/////////// Queues /////////////
+
+		template <class T>
+		void FixedQueuePushPop(BenchmarkState& state)
+		{
+			// PopFront() shifts all the elements
+			if (state.Size() > QUADRATIC_MAX_SIZE)
+			{
+				state.Skip("O(n^2)");
+				return;
+			}
+
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::FixedQueue<T> queue(state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					queue.PushBack(values[i]);
+				}
+				while (false == queue.IsEmpty())
+				{
+					DoNotOptimize(queue.Front());
+					queue.PopFront();
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void DynamicQueuePushPop(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::DynamicQueue<T> queue;
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					queue.PushBack(values[i]);
+				}
+				while (queue.Size() > 0)
+				{
+					DoNotOptimize(queue.First()->data);
+					queue.PopFront();
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("FixedQueue/PushPop", FixedQueuePushPop, int);
+		SDA_BENCHMARK_TEMPLATE("FixedQueue/PushPop", FixedQueuePushPop, std::string);
+		SDA_BENCHMARK_TEMPLATE("DynamicQueue/PushPop", DynamicQueuePushPop, int);
+		SDA_BENCHMARK_TEMPLATE("DynamicQueue/PushPop", DynamicQueuePushPop, std::string);
+
+		/////////// Stacks /////////////
+
+		template <class T>
+		void FixedStackPushPop(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::FixedStack<T> stack(state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					stack.Push(values[i]);
+				}
+				while (false == stack.IsEmpty())
+				{
+					DoNotOptimize(stack.Top());
+					stack.Pop();
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void DynamicStackPushPop(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::DynamicStack<T> stack;
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					stack.Push(values[i]);
+				}
+				while (stack.Size() > 0)
+				{
+					DoNotOptimize(stack.Top()->data);
+					stack.Pop();
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("FixedStack/PushPop", FixedStackPushPop, int);
+		SDA_BENCHMARK_TEMPLATE("FixedStack/PushPop", FixedStackPushPop, std::string);
+		SDA_BENCHMARK_TEMPLATE("DynamicStack/PushPop", DynamicStackPushPop, int);
+		SDA_BENCHMARK_TEMPLATE("DynamicStack/PushPop", DynamicStackPushPop, std::string);
+
+		/////////// Lists /////////////
+
+		template <class T>
+		void SinglyLinkedListInsertErase(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::SinglyLinkedList<T> list;
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					list.InsertFirst(values[i]);
+				}
+				while (list.Size() > 0)
+				{
+					list.EraseFirst();
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void SinglyLinkedListTraverse(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::SinglyLinkedList<T> list;
+			for (std::size_t i = 0; i < values.Size(); ++i)
+			{
+				list.InsertFirst(values[i]);
+			}
+
+			while (state.KeepRunning())
+			{
+				for (SinglyLinkedListNode<T>* nodePtr = list.First(); nodePtr != nullptr; nodePtr = nodePtr->nextPtr)
+				{
+					DoNotOptimize(nodePtr->data);
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void DoublyLinkedListInsertErase(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::DoublyLinkedList<T> list;
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					list.InsertLast(values[i]);
+				}
+				while (list.Size() > 0)
+				{
+					list.EraseFirst();
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("SinglyLinkedList/InsertErase", SinglyLinkedListInsertErase, int);
+		SDA_BENCHMARK_TEMPLATE("SinglyLinkedList/InsertErase", SinglyLinkedListInsertErase, std::string);
+		SDA_BENCHMARK_TEMPLATE("SinglyLinkedList/Traverse", SinglyLinkedListTraverse, int);
+		SDA_BENCHMARK_TEMPLATE("DoublyLinkedList/InsertErase", DoublyLinkedListInsertErase, int);
+		SDA_BENCHMARK_TEMPLATE("DoublyLinkedList/InsertErase", DoublyLinkedListInsertErase, std::string);
+
+		/////////// BinarySearchTree /////////////
+
+		template <class T>
+		void BinarySearchTreeInsert(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::BinarySearchTree<T> tree;
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					tree.AddNode(tree.Root(), values[i]);
+				}
+				DoNotOptimize(tree);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void BinarySearchTreeFind(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::BinarySearchTree<T> tree;
+			for (std::size_t i = 0; i < values.Size(); ++i)
+			{
+				tree.AddNode(tree.Root(), values[i]);
+			}
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					DoNotOptimize(tree.FindNode(tree.Root(), values[i]));
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void BinarySearchTreeInorder(BenchmarkState& state)
+		{
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+			SDA::BinarySearchTree<T> tree;
+			for (std::size_t i = 0; i < values.Size(); ++i)
+			{
+				tree.AddNode(tree.Root(), values[i]);
+			}
+
+			while (state.KeepRunning())
+			{
+				tree.InorderTraversal([](BinarySearchTreeNode<T>* nodePtr) -> bool
+				{
+					DoNotOptimize(nodePtr->key);
+					return false;
+				});
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("BinarySearchTree/Insert", BinarySearchTreeInsert, int);
+		SDA_BENCHMARK_TEMPLATE("BinarySearchTree/Insert", BinarySearchTreeInsert, std::string);
+		SDA_BENCHMARK_TEMPLATE("BinarySearchTree/Find", BinarySearchTreeFind, int);
+		SDA_BENCHMARK_TEMPLATE("BinarySearchTree/Find", BinarySearchTreeFind, std::string);
+		SDA_BENCHMARK_TEMPLATE("BinarySearchTree/Inorder", BinarySearchTreeInorder, int);
+
+		/////////// LiniarSet /////////////
+
+		template <class T>
+		void LiniarSetAdd(BenchmarkState& state)
+		{
+			if (state.Size() > QUADRATIC_MAX_SIZE)
+			{
+				state.Skip("O(n^2)");
+				return;
+			}
+
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				// a set keeps only the new elements
+				SDA::LiniarSet<T> set;
+				for (std::size_t i = 0; i < values.Size(); ++i)
+				{
+					if (false == set.exists(values[i]))
+					{
+						set.addElement(values[i]);
+					}
+				}
+				DoNotOptimize(set);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void LiniarSetIntersection(BenchmarkState& state)
+		{
+			if (state.Size() > QUADRATIC_MAX_SIZE)
+			{
+				state.Skip("O(n^2)");
+				return;
+			}
+
+			// half of the elements are shared
+			const SDA::Vector<T> values = RandomValues<T>(state.Size() + state.Size() / 2);
+			SDA::LiniarSet<T> set1, set2;
+			for (std::size_t i = 0; i < state.Size(); ++i)
+			{
+				set1.addElement(values[i]);
+				set2.addElement(values[values.Size() - 1 - i]);
+			}
+
+			while (state.KeepRunning())
+			{
+				SDA::LiniarSet<T> inter = set1.intersection(set2);
+				DoNotOptimize(inter);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("LiniarSet/Add", LiniarSetAdd, int);
+		SDA_BENCHMARK_TEMPLATE("LiniarSet/Add", LiniarSetAdd, std::string);
+		SDA_BENCHMARK_TEMPLATE("LiniarSet/Intersection", LiniarSetIntersection, int);
+
+		/////////// Graph /////////////
+
+		// size vertices, every vertex has DEGREE random out edges
+		void BuildGraph(Graph& graph, const std::size_t size)
+		{
+			const std::size_t DEGREE = 4;
+
+			std::mt19937 generator(RANDOM_SEED);
+			std::uniform_int_distribution<int> vertex(0, (int)size - 1);
+
+			for (std::size_t v = 0; v < size; ++v)
+			{
+				// a path through all the vertices, so everything is reachable from 0
+				if (v + 1 < size)
+				{
+					graph.AddEdge((int)v, (int)v + 1);
+				}
+
+				for (std::size_t edge = 1; edge < DEGREE; ++edge)
+				{
+					graph.AddEdge((int)v, vertex(generator));
+				}
+			}
+		}
+
+		void GraphBFS(BenchmarkState& state)
+		{
+			// there is no start vertex
+			if (0 == state.Size())
+			{
+				state.Skip("empty graph");
+				return;
+			}
+
+			Graph graph(state.Size());
+			BuildGraph(graph, state.Size());
+
+			while (state.KeepRunning())
+			{
+				graph.BFS(0, [](int v) { DoNotOptimize(v); });
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		void GraphDFS(BenchmarkState& state)
+		{
+			// there is no start vertex
+			if (0 == state.Size())
+			{
+				state.Skip("empty graph");
+				return;
+			}
+
+			Graph graph(state.Size());
+			BuildGraph(graph, state.Size());
+
+			while (state.KeepRunning())
+			{
+				graph.DFS(0, [](int v) { DoNotOptimize(v); });
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		// the reachable set of two vertices, intersected
+		void GraphReachable(BenchmarkState& state)
+		{
+			// there is no start vertex
+			if (0 == state.Size())
+			{
+				state.Skip("empty graph");
+				return;
+			}
+
+			Graph graph(state.Size());
+			BuildGraph(graph, state.Size());
+
+			while (state.KeepRunning())
+			{
+				SDA::BitVector reachable = graph.Reachable(0);
+				reachable &= graph.Reachable((int)state.Size() / 2);
+				DoNotOptimize(reachable.Count());
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK("Graph/BFS", GraphBFS);
+		SDA_BENCHMARK("Graph/DFS", GraphDFS);
+		SDA_BENCHMARK("Graph/Reachable", GraphReachable);
+
+		/////////// Sort /////////////
+
+		template <class T, class SortFunc>
+		void RunSort(BenchmarkState& state, const SortFunc sort, const bool isQuadratic)
+		{
+			if (state.Size() < 2)
+			{
+				state.Skip("at least 2 elements");
+				return;
+			}
+
+			if (isQuadratic && state.Size() > QUADRATIC_MAX_SIZE)
+			{
+				state.Skip("O(n^2)");
+				return;
+			}
+
+			const SDA::Vector<T> values = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				state.PauseTiming();
+				SDA::Vector<T> vec(values);
+				state.ResumeTiming();
+
+				sort(vec);
+				DoNotOptimize(vec);
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		template <class T>
+		void BubbleSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { SDA::BubbleSort(vec, SDA::Less()); }, true);
+		}
+
+		template <class T>
+		void SelectionSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { SDA::SelectionSort(vec, SDA::Less()); }, true);
+		}
+
+		template <class T>
+		void InsertionSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { SDA::InsertionSort(vec, SDA::Less()); }, true);
+		}
+
+		template <class T>
+		void CountSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { SDA::CountSort(vec, SDA::Less()); }, false);
+		}
+
+		template <class T>
+		void QuickSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { SDA::QuickSort(vec, SDA::Less()); }, false);
+		}
+
+		template <class T>
+		void MergeSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { SDA::MergeSort(vec, SDA::Less()); }, false);
+		}
+
+		// the baseline of QuickSort and MergeSort
+		template <class T>
+		void StdSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { std::sort(vec.GetData(), vec.GetData() + vec.Size(), SDA::Less()); }, false);
+		}
+
+		template <class T>
+		void StdStableSortRandom(BenchmarkState& state)
+		{
+			RunSort<T>(state, [](SDA::Vector<T>& vec) { std::stable_sort(vec.GetData(), vec.GetData() + vec.Size(), SDA::Less()); }, false);
+		}
+
+		SDA_BENCHMARK_TEMPLATE("Sort/BubbleSort", BubbleSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/SelectionSort", SelectionSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/InsertionSort", InsertionSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/CountSort", CountSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/QuickSort", QuickSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/QuickSort", QuickSortRandom, std::int64_t);
+		SDA_BENCHMARK_TEMPLATE("Sort/QuickSort", QuickSortRandom, Int64Pair);
+		SDA_BENCHMARK_TEMPLATE("Sort/StdSort", StdSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/StdSort", StdSortRandom, std::int64_t);
+		SDA_BENCHMARK_TEMPLATE("Sort/StdSort", StdSortRandom, Int64Pair);
+		SDA_BENCHMARK_TEMPLATE("Sort/MergeSort", MergeSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/MergeSort", MergeSortRandom, std::int64_t);
+		SDA_BENCHMARK_TEMPLATE("Sort/MergeSort", MergeSortRandom, Int64Pair);
+		SDA_BENCHMARK_TEMPLATE("Sort/StdStableSort", StdStableSortRandom, int);
+		SDA_BENCHMARK_TEMPLATE("Sort/StdStableSort", StdStableSortRandom, std::int64_t);
+		SDA_BENCHMARK_TEMPLATE("Sort/StdStableSort", StdStableSortRandom, Int64Pair);
+
+		/////////// Search /////////////
+
+		template <class T>
+		void BinarySearchLookup(BenchmarkState& state)
+		{
+			if (state.Size() < 2)
+			{
+				state.Skip("at least 2 elements");
+				return;
+			}
+
+			const SDA::Vector<T> values = SortedValues<T>(state.Size());
+			const SDA::Vector<T> keys = RandomValues<T>(state.Size());
+
+			while (state.KeepRunning())
+			{
+				for (std::size_t i = 0; i < keys.Size(); ++i)
+				{
+					DoNotOptimize(SDA::BinarySearch(values, keys[i], 0, values.Size() - 1));
+				}
+			}
+			state.SetItemsPerIteration(state.Size());
+		}
+
+		SDA_BENCHMARK_TEMPLATE("Search/BinarySearch", BinarySearchLookup, int);
+		SDA_BENCHMARK_TEMPLATE("Search/BinarySearch", BinarySearchLookup, std::string);
+	}
+}
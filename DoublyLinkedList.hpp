@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 DoublyLinkedList - a type of collection/container to store elements of the same type
@@ -78,7 +79,8 @@ namespace SDA
 	class DoublyLinkedList
 	{
 	public:
-		DoublyLinkedList();
+		// nullptr allocator means the global heap
+		DoublyLinkedList(Allocator* allocator = nullptr);
 		DoublyLinkedList(const DoublyLinkedList<T>& list);
 		DoublyLinkedList(DoublyLinkedList<T>&& list);
 		virtual ~DoublyLinkedList();
@@ -102,13 +104,17 @@ namespace SDA
 		void Reverse();
 		void InsertionSort();
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const DoublyLinkedList<T>& list);
 		void Move(DoublyLinkedList<T>&& list);
 		void Destroy();
 
-		DoublyLinkedListNode<T>* mHeadPtr, mTailPtr;
+		DoublyLinkedListNode<T>* mHeadPtr, * mTailPtr;
 		size_t mSize;
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -118,20 +124,22 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	DoublyLinkedList<T>::DoublyLinkedList()
-		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0)
+	DoublyLinkedList<T>::DoublyLinkedList(Allocator* allocator)
+		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0), mAllocator(allocator)
 	{}
 
 	template <class T>
 	DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList<T>& list)
+		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0), mAllocator(list.mAllocator) // the copy uses the same allocator
 	{
 		Copy(list);
 	}
 
 	template <class T>
 	DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList<T>&& list)
+		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0), mAllocator(list.mAllocator)
 	{
-		Move(list);
+		Move(std::move(list));
 	}
 
 	template <class T>
@@ -162,6 +170,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of list
+			mAllocator = list.mAllocator;
+
 			mSize = list.mSize;
 
 			mHeadPtr = list.mHeadPtr;
@@ -179,7 +190,7 @@ namespace SDA
 		while (crrNodePtr != nullptr)
 		{
 			mHeadPtr = crrNodePtr->nextPtr;
-			delete crrNodePtr;
+			SDA::Delete(mAllocator, crrNodePtr);
 			crrNodePtr = mHeadPtr;
 		}
 
@@ -199,11 +210,17 @@ namespace SDA
 	template <class T>
 	DoublyLinkedList<T>& DoublyLinkedList<T>::operator =(DoublyLinkedList<T>&& list)
 	{
-		Move(list);
+		Move(std::move(list));
 
 		return *this;
 	}
 
+	template <class T>
+	Allocator* DoublyLinkedList<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	DoublyLinkedListNode<T>* DoublyLinkedList<T>::First() const
 	{
@@ -225,13 +242,17 @@ namespace SDA
 	template <class T>
 	void DoublyLinkedList<T>::InsertFirst(const T& val)
 	{
-		DoublyLinkedListNode<T>* newNodePtr = new DoublyLinkedListNode<T>(val);
+		DoublyLinkedListNode<T>* newNodePtr = SDA::New<DoublyLinkedListNode<T>>(mAllocator, val);
 
 		if (mHeadPtr)
 		{
 			newNodePtr->nextPtr = mHeadPtr;
 			mHeadPtr->prevPtr = newNodePtr;
 		}
+		else
+		{
+			mTailPtr = newNodePtr;
+		}
 		mHeadPtr = newNodePtr;
 
 		++mSize;
@@ -240,7 +261,7 @@ namespace SDA
 	template <class T>
 	void DoublyLinkedList<T>::InsertLast(const T& val)
 	{
-		DoublyLinkedListNode<T>* newNodePtr = new DoublyLinkedListNode<T>(val);
+		DoublyLinkedListNode<T>* newNodePtr = SDA::New<DoublyLinkedListNode<T>>(mAllocator, val);
 
 		if (mSize == 0)
 		{
@@ -250,6 +271,7 @@ namespace SDA
 		{
 			mTailPtr->nextPtr = newNodePtr;
 			newNodePtr->prevPtr = mTailPtr;
+			mTailPtr = newNodePtr;
 		}
 
 		++mSize;
@@ -270,7 +292,7 @@ namespace SDA
 		}
 		else // in between
 		{
-			DoublyLinkedListNode<T>* newNodePtr = new DoublyLinkedListNode<T>(val);
+			DoublyLinkedListNode<T>* newNodePtr = SDA::New<DoublyLinkedListNode<T>>(mAllocator, val);
 
 			size_t idx = 0;
 			DoublyLinkedListNode<T>* crrNode = nullptr;
@@ -304,11 +326,14 @@ namespace SDA
 		DoublyLinkedListNode<T>* nodeToDeletePtr = mHeadPtr;
 
 		mHeadPtr = mHeadPtr->nextPtr;
-		mHeadPtr->prevPtr = nullptr;
+		if (mHeadPtr)
+			mHeadPtr->prevPtr = nullptr;
+		else // the last element
+			mTailPtr = nullptr;
 
 		nodeToDeletePtr->nextPtr = nullptr;
 		nodeToDeletePtr->prevPtr = nullptr;
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -320,11 +345,14 @@ namespace SDA
 		DoublyLinkedListNode<T>* nodeToDeletePtr = mTailPtr;
 
 		mTailPtr = mTailPtr->prevPtr;
-		mTailPtr->nextPtr = nullptr;
+		if (mTailPtr)
+			mTailPtr->nextPtr = nullptr;
+		else // the last element
+			mHeadPtr = nullptr;
 
 		nodeToDeletePtr->nextPtr = nullptr;
 		nodeToDeletePtr->prevPtr = nullptr;
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -367,7 +395,7 @@ namespace SDA
 
 			nodeToDeletePtr->nextPtr = nullptr;
 			nodeToDeletePtr->prevPtr = nullptr;
-			delete nodeToDeletePtr;
+			SDA::Delete(mAllocator, nodeToDeletePtr);
 			--mSize;
 		}
 	}
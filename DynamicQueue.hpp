@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 DynamicQueue - FIFO container, but dynamic in size
@@ -70,7 +71,8 @@ namespace SDA
 	public:
 	
 
-		DynamicQueue();
+		// nullptr allocator means the global heap
+		DynamicQueue(Allocator* allocator = nullptr);
 		DynamicQueue(const DynamicQueue<T>& queue);
 		DynamicQueue(DynamicQueue<T>&& queue);
 		virtual ~DynamicQueue();
@@ -86,6 +88,8 @@ namespace SDA
 		void PushBack(const T& val);
 		void PopFront();
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const DynamicQueue<T>& queue);
 		void Move(DynamicQueue<T>&& queue);
@@ -93,6 +97,8 @@ namespace SDA
 
 		QueueNode<T> *mHeadPtr, *mTailPtr;
 		size_t mSize;
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -102,20 +108,22 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	DynamicQueue<T>::DynamicQueue()
-		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0)
+	DynamicQueue<T>::DynamicQueue(Allocator* allocator)
+		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0), mAllocator(allocator)
 	{}
 
 	template <class T>
 	DynamicQueue<T>::DynamicQueue(const DynamicQueue<T>& queue)
+		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0), mAllocator(queue.mAllocator) // the copy uses the same allocator
 	{
 		Copy(queue);
 	}
 
 	template <class T>
 	DynamicQueue<T>::DynamicQueue(DynamicQueue<T>&& queue)
+		: mHeadPtr(nullptr), mTailPtr(nullptr), mSize(0), mAllocator(queue.mAllocator)
 	{
-		Move(queue);
+		Move(std::move(queue));
 	}
 
 	template <class T>
@@ -134,7 +142,7 @@ namespace SDA
 			QueueNode<T>* crrNodePtr = nullptr;
 			for (crrNodePtr = queue.mHeadPtr; crrNodePtr != nullptr; crrNodePtr = crrNodePtr->nextPtr)
 			{
-				Push(crrNodePtr->data);
+				PushBack(crrNodePtr->data);
 			}
 		}
 	}
@@ -146,6 +154,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of queue
+			mAllocator = queue.mAllocator;
+
 			mSize = queue.mSize;
 
 			mHeadPtr = queue.mHeadPtr;
@@ -163,7 +174,7 @@ namespace SDA
 		while (crrNode != nullptr)
 		{
 			mHeadPtr = crrNode->nextPtr;
-			delete crrNode;
+			SDA::Delete(mAllocator, crrNode);
 			crrNode = mHeadPtr;
 		}
 
@@ -183,11 +194,17 @@ namespace SDA
 	template <class T>
 	DynamicQueue<T>& DynamicQueue<T>::operator =(DynamicQueue<T>&& queue)
 	{
-		Move(queue);
+		Move(std::move(queue));
 
 		return *this;
 	}
 
+	template <class T>
+	Allocator* DynamicQueue<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	QueueNode<T>* DynamicQueue<T>::First()
 	{
@@ -209,15 +226,15 @@ namespace SDA
 	template <class T>
 	void DynamicQueue<T>::PushBack(const T& val)
 	{
-		QueueNode<T>* newNodePtr = new QueueNode<T>(val);
+		QueueNode<T>* newNodePtr = SDA::New<QueueNode<T>>(mAllocator, val);
 
 		if (mTailPtr)
 		{
 			mTailPtr->nextPtr = newNodePtr;
 			mTailPtr = newNodePtr;
 		}
-		else
-			mTailPtr = newNodePtr;
+		else // the first element
+			mHeadPtr = mTailPtr = newNodePtr;
 
 		++mSize;
 	}
@@ -225,7 +242,7 @@ namespace SDA
 	template <class T>
 	void DynamicQueue<T>::PopFront()
 	{
-		assert(mSize == 0);
+		assert(mSize > 0);
 
 		QueueNode<T>* nodeToDeletePtr = mHeadPtr;
 
@@ -234,7 +251,12 @@ namespace SDA
 			mHeadPtr = mHeadPtr->nextPtr;
 		}
 
-		delete nodeToDeletePtr;
+		if (mHeadPtr == nullptr) // the last element
+		{
+			mTailPtr = nullptr;
+		}
+
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
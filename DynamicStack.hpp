@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 DynamicQueue - LIFO container, but dynamic in size
@@ -75,7 +76,8 @@ namespace SDA
 	public:
 
 
-		DynamicStack();
+		// nullptr allocator means the global heap
+		DynamicStack(Allocator* allocator = nullptr);
 		DynamicStack(const DynamicStack<T>& stack);
 		DynamicStack(DynamicStack<T>&& stack);
 		virtual ~DynamicStack();
@@ -90,6 +92,8 @@ namespace SDA
 		void Push(const T& val);
 		void Pop();
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const DynamicStack<T>& stack);
 		void Move(DynamicStack<T>&& stack);
@@ -97,6 +101,8 @@ namespace SDA
 
 		StackNode<T>* mTopPtr;
 		size_t mSize;
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -106,20 +112,22 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	DynamicStack<T>::DynamicStack()
-		: mTopPtr(nullptr), mSize(0)
+	DynamicStack<T>::DynamicStack(Allocator* allocator)
+		: mTopPtr(nullptr), mSize(0), mAllocator(allocator)
 	{}
 
 	template <class T>
 	DynamicStack<T>::DynamicStack(const DynamicStack<T>& stack)
+		: mTopPtr(nullptr), mSize(0), mAllocator(stack.mAllocator) // the copy uses the same allocator
 	{
 		Copy(stack);
 	}
 
 	template <class T>
 	DynamicStack<T>::DynamicStack(DynamicStack<T>&& stack)
+		: mTopPtr(nullptr), mSize(0), mAllocator(stack.mAllocator)
 	{
-		Move(stack);
+		Move(std::move(stack));
 	}
 
 	template <class T>
@@ -135,21 +143,28 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are copied top to bottom, so the order stays the same
 			StackNode<T>* newStackPtr = nullptr;
-			StackNode<T>* crrNodePtr = stack.Top();
+			StackNode<T>* crrNodePtr = stack.mTopPtr;
 			while (crrNodePtr != nullptr)
 			{
+				StackNode<T>* newNodePtr = SDA::New<StackNode<T>>(mAllocator, crrNodePtr->data);
+
 				if (newStackPtr)
 				{
-					newStackPtr->nextPtr = crrNodePtr;
-					newStackPtr = crrNodePtr;
+					newStackPtr->nextPtr = newNodePtr;
+					newStackPtr = newNodePtr;
 				}
 				else
 				{
-					newStackPtr = crrNodePtr;
+					newStackPtr = newNodePtr;
 					mTopPtr = newStackPtr;
 				}
+
+				crrNodePtr = crrNodePtr->nextPtr;
 			}
+
+			mSize = stack.mSize;
 		}
 	}
 
@@ -160,6 +175,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of stack
+			mAllocator = stack.mAllocator;
+
 			mSize = stack.mSize;
 
 			mTopPtr = stack.mTopPtr;
@@ -174,7 +192,7 @@ namespace SDA
 		while (crrNode != nullptr)
 		{
 			mTopPtr = crrNode->nextPtr;
-			delete crrNode;
+			SDA::Delete(mAllocator, crrNode);
 			crrNode = mTopPtr;
 		}
 
@@ -193,11 +211,17 @@ namespace SDA
 	template <class T>
 	DynamicStack<T>& DynamicStack<T>::operator =(DynamicStack<T>&& stack)
 	{
-		Move(stack);
+		Move(std::move(stack));
 
 		return *this;
 	}
 
+	template <class T>
+	Allocator* DynamicStack<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	StackNode<T>* DynamicStack<T>::Top()
 	{
@@ -213,7 +237,7 @@ namespace SDA
 	template <class T>
 	void DynamicStack<T>::Push(const T& val)
 	{
-		StackNode<T>* newNodePtr = new StackNode<T>(val);
+		StackNode<T>* newNodePtr = SDA::New<StackNode<T>>(mAllocator, val);
 
 		if (mTopPtr)
 		{
@@ -230,7 +254,7 @@ namespace SDA
 	template <class T>
 	void DynamicStack<T>::Pop()
 	{
-		assert(mSize == 0);
+		assert(mSize > 0);
 
 		StackNode<T>* nodeToDeletePtr = mTopPtr;
 
@@ -239,7 +263,7 @@ namespace SDA
 			mTopPtr = mTopPtr->nextPtr;
 		}
 
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
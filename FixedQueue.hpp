@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /* A Fixed size Stack - standard FIFO container
 
@@ -39,8 +40,9 @@ namespace SDA
 	class FixedQueue
 	{
 	public:
-		FixedQueue();
-		FixedQueue(size_t capacity);
+		// nullptr allocator means the global heap
+		FixedQueue(Allocator* allocator = nullptr);
+		FixedQueue(size_t capacity, Allocator* allocator = nullptr);
 		FixedQueue(const FixedQueue<T>& queue);
 		FixedQueue(FixedQueue<T>&& queue);
 		virtual ~FixedQueue();
@@ -64,6 +66,8 @@ namespace SDA
 
 		void Swap(FixedQueue<T>& queue);
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const FixedQueue<T>& queue);
 		void Move(FixedQueue<T>&& queue);
@@ -73,6 +77,8 @@ namespace SDA
 		size_t mCapacity;
 		size_t mSize;
 
+		Allocator* mAllocator; // not owned
+
 		static const size_t DEFAULT_CAPACITY = 100;
 	};
 }
@@ -83,29 +89,31 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	FixedQueue<T>::FixedQueue()
-		: mBuffer(nullptr), mCapacity(DEFAULT_CAPACITY), mSize(0)
+	FixedQueue<T>::FixedQueue(Allocator* allocator)
+		: mBuffer(nullptr), mCapacity(DEFAULT_CAPACITY), mSize(0), mAllocator(allocator)
 	{
-		mBuffer = new T[mCapacity];
+		mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 	}
 
 	template <class T>
-	FixedQueue<T>::FixedQueue(size_t capacity)
-		: mCapacity(capacity), mSize(0)
+	FixedQueue<T>::FixedQueue(size_t capacity, Allocator* allocator)
+		: mBuffer(nullptr), mCapacity(capacity), mSize(0), mAllocator(allocator)
 	{
-		mBuffer = new T[mCapacity];
+		mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 	}
 
 	template <class T>
 	FixedQueue<T>::FixedQueue(const FixedQueue<T>& queue)
+		: mBuffer(nullptr), mCapacity(0), mSize(0), mAllocator(queue.mAllocator) // the copy uses the same allocator
 	{
 		Copy(queue);
 	}
 
 	template <class T>
 	FixedQueue<T>::FixedQueue(FixedQueue<T>&& queue)
+		: mBuffer(nullptr), mCapacity(0), mSize(0), mAllocator(queue.mAllocator)
 	{
-		Move(queue);
+		Move(std::move(queue));
 	}
 
 	template <class T>
@@ -125,7 +133,7 @@ namespace SDA
 			mCapacity = queue.mCapacity;
 			mSize = queue.mSize;
 
-			mBuffer = new T[mCapacity];
+			mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 
 			for (size_t i = 0; i < mSize; ++i)
 			{
@@ -147,8 +155,9 @@ namespace SDA
 			mCapacity = queue.mCapacity;
 			mSize = queue.mSize;
 
-			// just copy the pointer
+			// just copy the pointer, the buffer is freed with the allocator of queue
 			mBuffer = queue.mBuffer;
+			mAllocator = queue.mAllocator;
 
 			// vec is invalidated after move
 			queue.mBuffer = nullptr;
@@ -162,7 +171,8 @@ namespace SDA
 	{
 		if (mBuffer)
 		{
-			delete[] mBuffer;
+			SDA::DeleteArray(mAllocator, mBuffer, mCapacity);
+			mBuffer = nullptr;
 		}
 
 		mCapacity = 0;
@@ -180,7 +190,7 @@ namespace SDA
 	template <class T>
 	FixedQueue<T>& FixedQueue<T>::operator =(FixedQueue<T>&& queue)
 	{
-		Move(queue);
+		Move(std::move(queue));
 
 		return *this;
 	}
@@ -255,16 +265,15 @@ namespace SDA
 	{
 		if (false == IsEmpty())
 		{
-			// destroy first element
-			mBuffer[0].~T();
-
-			// shift elements to left with 1 position
-			for (size_t i = 0; i < mSize; ++i)
+			// shift elements to left with 1 position, this overwrites the first element
+			for (size_t i = 0; i + 1 < mSize; ++i)
 			{
 				// better move them then copy
 				mBuffer[i] = std::move(mBuffer[i + 1]);
 			}
 
+			// the elements stay constructed until DeleteArray(), only the value is released
+			mBuffer[mSize - 1] = T();
 			--mSize;
 		}
 
@@ -276,6 +285,13 @@ namespace SDA
 		SDA::Swap(mBuffer, queue.mBuffer);
 		SDA::Swap(mCapacity, queue.mCapacity);
 		SDA::Swap(mSize, queue.mSize);
+		SDA::Swap(mAllocator, queue.mAllocator);
+	}
+
+	template <class T>
+	Allocator* FixedQueue<T>::GetAllocator() const
+	{
+		return mAllocator;
 	}
 
 	/////////// OUTPUT /////////////
@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /* A Fixed size Stack - standard LIFO container
 
@@ -42,8 +43,9 @@ namespace SDA
 	class FixedStack
 	{
 	public:
-		FixedStack();
-		FixedStack(size_t capacity);
+		// nullptr allocator means the global heap
+		FixedStack(Allocator* allocator = nullptr);
+		FixedStack(size_t capacity, Allocator* allocator = nullptr);
 		FixedStack(const FixedStack<T>& stack);
 		FixedStack(FixedStack<T>&& stack);
 		virtual ~FixedStack();
@@ -65,6 +67,8 @@ namespace SDA
 
 		void Swap(FixedStack<T>& stack);
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const FixedStack<T>& stack);
 		void Move(FixedStack<T>&& stack);
@@ -74,6 +78,8 @@ namespace SDA
 		size_t mCapacity;
 		size_t mSize;
 
+		Allocator* mAllocator; // not owned
+
 		static const size_t DEFAULT_CAPACITY = 100;
 	};
 }
@@ -84,29 +90,31 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	FixedStack<T>::FixedStack()
-		:  mBuffer(nullptr), mCapacity(DEFAULT_CAPACITY), mSize(0)
+	FixedStack<T>::FixedStack(Allocator* allocator)
+		:  mBuffer(nullptr), mCapacity(DEFAULT_CAPACITY), mSize(0), mAllocator(allocator)
 	{
-		mBuffer = new T[mCapacity];
+		mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 	}
 
 	template <class T>
-	FixedStack<T>::FixedStack(size_t capacity)
-		: mCapacity(capacity), mSize(0)
+	FixedStack<T>::FixedStack(size_t capacity, Allocator* allocator)
+		: mBuffer(nullptr), mCapacity(capacity), mSize(0), mAllocator(allocator)
 	{
-		mBuffer = new T[mCapacity];
+		mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 	}
 
 	template <class T>
 	FixedStack<T>::FixedStack(const FixedStack<T>& stack)
+		: mBuffer(nullptr), mCapacity(0), mSize(0), mAllocator(stack.mAllocator) // the copy uses the same allocator
 	{
 		Copy(stack);
 	}
 
 	template <class T>
 	FixedStack<T>::FixedStack(FixedStack<T>&& stack)
+		: mBuffer(nullptr), mCapacity(0), mSize(0), mAllocator(stack.mAllocator)
 	{
-		Move(stack);
+		Move(std::move(stack));
 	}
 
 	template <class T>
@@ -129,7 +137,7 @@ namespace SDA
 			mCapacity = stack.mCapacity;
 			mSize = stack.mSize;
 
-			mBuffer = new T[mCapacity];
+			mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 
 			for (size_t i = 0; i < mSize; ++i)
 			{
@@ -151,8 +159,9 @@ namespace SDA
 			mCapacity = stack.mCapacity;
 			mSize = stack.mSize;
 
-			// just copy the pointer
+			// just copy the pointer, the buffer is freed with the allocator of stack
 			mBuffer = stack.mBuffer;
+			mAllocator = stack.mAllocator;
 
 			// vec is invalidated after move
 			stack.mBuffer = nullptr;
@@ -166,7 +175,8 @@ namespace SDA
 	{
 		if (mBuffer)
 		{
-			delete[] mBuffer;
+			SDA::DeleteArray(mAllocator, mBuffer, mCapacity);
+			mBuffer = nullptr;
 		}
 	}
 
@@ -181,7 +191,7 @@ namespace SDA
 	template <class T>
 	FixedStack<T>& FixedStack<T>::operator =(FixedStack<T>&& stack)
 	{
-		Move(stack);
+		Move(std::move(stack));
 
 		return *this;
 	}
@@ -240,7 +250,8 @@ namespace SDA
 	{
 		if (false == IsEmpty())
 		{
-			mBuffer[mSize - 1].~T();
+			// the elements stay constructed until DeleteArray(), only the value is released
+			mBuffer[mSize - 1] = T();
 			--mSize;
 		}
 	}
@@ -251,6 +262,13 @@ namespace SDA
 		SDA::Swap(mBuffer, stack.mBuffer);
 		SDA::Swap(mCapacity, stack.mCapacity);
 		SDA::Swap(mSize, stack.mSize);
+		SDA::Swap(mAllocator, stack.mAllocator);
+	}
+
+	template <class T>
+	Allocator* FixedStack<T>::GetAllocator() const
+	{
+		return mAllocator;
 	}
 
 	/////////// OUTPUT /////////////
@@ -0,0 +1,241 @@
+#include "FreeListAllocator.hpp"
+#include "MemoryUtility.hpp"
+#include <cstdlib> // malloc(), free()
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	FreeListAllocator::FreeListAllocator()
+		: Allocator(), mMemoryBuffer(nullptr), mFreeList(nullptr), mPolicy(FIND_FIRST)
+	{}
+
+	FreeListAllocator::FreeListAllocator(const std::size_t totalSize, const PlacementPolicy policy)
+		: Allocator(totalSize), mMemoryBuffer(nullptr), mFreeList(nullptr), mPolicy(policy)
+	{
+		assert(totalSize >= sizeof(FreeBlock) && "Total size is too small");
+	}
+
+	FreeListAllocator::~FreeListAllocator()
+	{
+		if (mMemoryBuffer)
+		{
+			free(mMemoryBuffer);
+		}
+		mMemoryBuffer = nullptr;
+		mFreeList = nullptr;
+	}
+
+	void FreeListAllocator::Init()
+	{
+		if (mMemoryBuffer)
+		{
+			free(mMemoryBuffer);
+		}
+		mMemoryBuffer = malloc(mTotalSize);
+
+		Reset();
+	}
+
+	void FreeListAllocator::Reset()
+	{
+		mUsed = 0;
+		mPeak = 0;
+		mFreeList = nullptr;
+
+		if (nullptr == mMemoryBuffer)
+		{
+			return;
+		}
+
+		// the whole buffer is one big free block
+		mFreeList = (FreeBlock*)mMemoryBuffer;
+		mFreeList->size = mTotalSize;
+		mFreeList->next = nullptr;
+	}
+
+	void FreeListAllocator::Find(const std::size_t size, const std::size_t alignment,
+		FreeBlock*& previousBlock, FreeBlock*& foundBlock, std::size_t& padding, std::size_t& blockSize) const
+	{
+		// the header and the free block that replaces the memory on Free() must be correctly aligned
+		const std::size_t headerAlignment = std::max(alignment, alignof(AllocationHeader));
+		const std::size_t blockAlignment = alignof(FreeBlock);
+
+		previousBlock = nullptr;
+		foundBlock = nullptr;
+
+		FreeBlock* previous = nullptr;
+		FreeBlock* current = mFreeList;
+
+		while (current)
+		{
+			const std::size_t currentPadding = SDA::CalculateMemoryPaddingWithHeader((std::size_t)current, headerAlignment, sizeof(AllocationHeader));
+
+			std::size_t requiredSize = ((currentPadding + size + blockAlignment - 1) / blockAlignment) * blockAlignment;
+			requiredSize = std::max(requiredSize, sizeof(FreeBlock));
+
+			if (current->size >= requiredSize)
+			{
+				if (nullptr == foundBlock || current->size < foundBlock->size)
+				{
+					previousBlock = previous;
+					foundBlock = current;
+					padding = currentPadding;
+					blockSize = requiredSize;
+				}
+
+				// the first fit is good enough or we cannot do better than a perfect fit
+				if (FIND_FIRST == mPolicy || current->size == requiredSize)
+				{
+					return;
+				}
+			}
+
+			previous = current;
+			current = current->next;
+		}
+	}
+
+	void* FreeListAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+
+		FreeBlock* previousBlock = nullptr;
+		FreeBlock* foundBlock = nullptr;
+		std::size_t padding = 0;
+		std::size_t blockSize = 0;
+
+		Find(size, alignment, previousBlock, foundBlock, padding, blockSize);
+
+		// no free block big enough
+		if (nullptr == foundBlock)
+		{
+			return nullptr;
+		}
+
+		FreeBlock* nextBlock = foundBlock->next;
+
+		// split the block if what is left can be used later
+		const std::size_t remainingSize = foundBlock->size - blockSize;
+		if (remainingSize >= sizeof(FreeBlock))
+		{
+			FreeBlock* remainingBlock = (FreeBlock*)((std::size_t)foundBlock + blockSize);
+			remainingBlock->size = remainingSize;
+			remainingBlock->next = nextBlock;
+
+			nextBlock = remainingBlock;
+		}
+		else
+		{
+			blockSize = foundBlock->size;
+		}
+
+		// remove the block from the free list
+		if (previousBlock)
+		{
+			previousBlock->next = nextBlock;
+		}
+		else
+		{
+			mFreeList = nextBlock;
+		}
+
+		const std::size_t nextAvailableAddress = (std::size_t)foundBlock + padding;
+
+		// store the header right before the returned address
+		AllocationHeader* header = (AllocationHeader*)(nextAvailableAddress - sizeof(AllocationHeader));
+		header->blockSize = blockSize;
+		header->padding = padding;
+
+		mUsed += blockSize;
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)nextAvailableAddress;
+	}
+
+	void FreeListAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		const std::size_t currentAddress = (std::size_t)ptr;
+
+		assert(currentAddress > (std::size_t)mMemoryBuffer &&
+			currentAddress < (std::size_t)mMemoryBuffer + mTotalSize && "Pointer not owned by this allocator");
+
+		// read the header before the free block overwrites it
+		const AllocationHeader* header = (const AllocationHeader*)(currentAddress - sizeof(AllocationHeader));
+		const std::size_t blockSize = header->blockSize;
+		const std::size_t padding = header->padding;
+
+		FreeBlock* freeBlock = (FreeBlock*)(currentAddress - padding);
+		freeBlock->size = blockSize;
+
+		// keep the list sorted by address so the neighbours can be merged
+		FreeBlock* previous = nullptr;
+		FreeBlock* current = mFreeList;
+		while (current && current < freeBlock)
+		{
+			previous = current;
+			current = current->next;
+		}
+
+		freeBlock->next = current;
+		if (previous)
+		{
+			previous->next = freeBlock;
+		}
+		else
+		{
+			mFreeList = freeBlock;
+		}
+
+		mUsed -= blockSize;
+
+		Coalesce(previous, freeBlock);
+	}
+
+	void FreeListAllocator::Coalesce(FreeBlock* previousBlock, FreeBlock* freeBlock)
+	{
+		// merge with the next block
+		FreeBlock* nextBlock = freeBlock->next;
+		if (nextBlock && (std::size_t)freeBlock + freeBlock->size == (std::size_t)nextBlock)
+		{
+			freeBlock->size += nextBlock->size;
+			freeBlock->next = nextBlock->next;
+		}
+
+		// merge with the previous block
+		if (previousBlock && (std::size_t)previousBlock + previousBlock->size == (std::size_t)freeBlock)
+		{
+			previousBlock->size += freeBlock->size;
+			previousBlock->next = freeBlock->next;
+		}
+	}
+
+	float FreeListAllocator::Fragmentation()
+	{
+		std::size_t totalFree = 0;
+		std::size_t largestFree = 0;
+
+		for (FreeBlock* current = mFreeList; current; current = current->next)
+		{
+			totalFree += current->size;
+			largestFree = std::max(largestFree, current->size);
+		}
+
+		if (0 == totalFree)
+		{
+			return 0.0f;
+		}
+
+		return 1.0f - static_cast<float>(largestFree) / totalFree;
+	}
+
+	FreeListAllocator::PlacementPolicy FreeListAllocator::Policy() const
+	{
+		return mPolicy;
+	}
+}
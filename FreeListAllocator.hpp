@@ -0,0 +1,76 @@
+#ifndef FREE_LIST_ALLOCATOR_HPP
+#define FREE_LIST_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+
+/*
+FreeListAllocator - general purpose allocator, variable size Allocate/Free in any order.
+The free blocks are kept in a list sorted by address, stored inside the free memory itself.
+Every allocated block has a header with its size and the alignment padding.
+When a block is freed it is merged (coalesced) with its free neighbours.
+
+TIME COMPLEXITY:
+- Allocate = O(n) - n is the number of free blocks
+- Free = O(n) - the block is inserted sorted by address
+
+PLACEMENT POLICY:
+- FIND_FIRST - the first free block big enough, faster
+- FIND_BEST - the smallest free block big enough, less fragmentation
+
+USAGES:
+- a replacement for malloc()/free() with a fixed memory budget
+*/
+
+namespace SDA
+{
+	class FreeListAllocator : public Allocator
+	{
+	public:
+		enum PlacementPolicy
+		{
+			FIND_FIRST,
+			FIND_BEST
+		};
+
+		FreeListAllocator();
+		FreeListAllocator(const std::size_t totalSize, const PlacementPolicy policy = FIND_FIRST);
+		virtual ~FreeListAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		float Fragmentation();
+
+		PlacementPolicy Policy() const;
+
+	private:
+		NON_COPY_AND_MOVE(FreeListAllocator)
+
+		struct FreeBlock
+		{
+			std::size_t size;
+			FreeBlock* next;
+		};
+
+		struct AllocationHeader
+		{
+			std::size_t blockSize; // padding included
+			std::size_t padding;
+		};
+
+		void Find(const std::size_t size, const std::size_t alignment,
+			FreeBlock*& previousBlock, FreeBlock*& foundBlock, std::size_t& padding, std::size_t& blockSize) const;
+
+		void Coalesce(FreeBlock* previousBlock, FreeBlock* freeBlock);
+
+		void* mMemoryBuffer;
+		FreeBlock* mFreeList;
+		PlacementPolicy mPolicy;
+	};
+}
+
+#endif /* FREE_LIST_ALLOCATOR_HPP */
\ No newline at end of file
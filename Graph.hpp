@@ -1,11 +1,13 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include "BitVector.hpp"
 #include <cstddef> // size_t
 #include <vector>
 #include <stack>
 #include <queue>
 #include <functional>
+#include <utility> // std::pair
 
 class Graph
 {
@@ -19,6 +21,9 @@ public:
 	void BFS(int start, const std::function<void(int v)>& fn);
 	void DFS(int start, const std::function<void(int v)>& fn);
 
+	// the vertices reachable from start (start included), one bit per vertex
+	SDA::BitVector Reachable(int start);
+
 private:
 	std::vector<int>* mAdj;
 	size_t mSize;
@@ -26,38 +31,43 @@ private:
 
 /////////////////////
 
-Graph::Graph()
+// defined in the header, inline keeps them from being defined again in every translation unit
+inline Graph::Graph()
 	: mAdj(nullptr), mSize(0)
 {}
 
-Graph::Graph(size_t size)
+inline Graph::Graph(size_t size)
 	: mSize(size)
 {
 	mAdj = new std::vector<int>[size];
 }
 
-Graph::~Graph()
+inline Graph::~Graph()
 {
-	for (size_t i = 0; i < mAdj[i].size(); ++i)
+	for (size_t i = 0; i < mSize; ++i)
 		mAdj[i].clear();
 
 	delete[] mAdj;
 }
 
-void Graph::AddEdge(int v, int w)
+inline void Graph::AddEdge(int v, int w)
 {
 	mAdj[v].push_back(w);
 }
 
-void Graph::BFS(int start, const std::function<void(int v)>& fn)
+inline void Graph::BFS(int start, const std::function<void(int v)>& fn)
 {
+	// an empty graph or a vertex outside of it has nothing to visit
+	if (start < 0 || (size_t)start >= mSize)
+		return;
+
 	// Iterative
-	std::vector<bool> visited(mSize, false);
+	SDA::BitVector visited(mSize);
 
 	std::queue<int> Queue;
 
 	Queue.push(start);
-	visited[start] = true;
+	visited.Set(start);
 
 	while (Queue.empty() == false)
 	{
@@ -69,32 +79,85 @@ void Graph::BFS(int start, const std::function<void(int v)>& fn)
 
 		for (int& w : mAdj[v])
 		{
-			if (visited[w] == false)
+			if (visited.Test(w) == false)
 			{
 				Queue.push(w);
-				visited[w] = true;
+				visited.Set(w);
 			}
 		}
 	}
 }
 
-void Graph::DFS(int start, const std::function<void(int v)>& fn)
+inline void Graph::DFS(int start, const std::function<void(int v)>& fn)
 {
-	// Recursive
-	std::vector<bool> visited(mSize, false);
+	// an empty graph or a vertex outside of it has nothing to visit
+	if (start < 0 || (size_t)start >= mSize)
+		return;
+
+	// Iterative, the stack keeps every vertex of the path with the index of its next edge,
+	// so the order is the recursive one without a call frame per vertex (a long path overflowed the stack)
+	SDA::BitVector visited(mSize);
 
-	auto DFS_R = [&visited, &fn](int v) -> void
+	std::stack<std::pair<int, size_t>> Stack;
+
+	visited.Set(start);
+	if (fn)
+		fn(start);
+	Stack.push(std::make_pair(start, 0));
+
+	while (Stack.empty() == false)
 	{
-		visited[v] = true;
+		std::pair<int, size_t>& top = Stack.top();
+		const std::vector<int>& edges = mAdj[top.first];
+
+		// skip the neighbours visited meanwhile
+		while (top.second < edges.size() && visited.Test(edges[top.second]))
+			++top.second;
+
+		if (top.second == edges.size())
+		{
+			Stack.pop();
+			continue;
+		}
+
+		const int w = edges[top.second++];
+		visited.Set(w);
 		if (fn)
-			fn(v);
+			fn(w);
+		Stack.push(std::make_pair(w, 0));
+	}
+}
+
+inline SDA::BitVector Graph::Reachable(int start)
+{
+	// Iterative, the set can be combined with others (&=, |=, AndNot())
+	SDA::BitVector visited(mSize);
+
+	// an empty graph or a vertex outside of it has nothing to visit
+	if (start < 0 || (size_t)start >= mSize)
+		return visited;
+
+	std::stack<int> Stack;
+
+	Stack.push(start);
+	visited.Set(start);
+
+	while (Stack.empty() == false)
+	{
+		int v = Stack.top();
+		Stack.pop();
 
 		for (int& w : mAdj[v])
 		{
-			if (visited[w] == false)
-				DFS_R(w);
+			if (visited.Test(w) == false)
+			{
+				Stack.push(w);
+				visited.Set(w);
+			}
 		}
-	}(start);
+	}
+
+	return visited;
 }
 
 #endif /* GRAPH_HPP */
\ No newline at end of file
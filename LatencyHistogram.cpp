@@ -0,0 +1,123 @@
+#include "LatencyHistogram.hpp"
+#include "MemoryUtility.hpp"
+#include <algorithm> // min, max
+#include <cmath> // ceil
+#include <cassert>
+
+namespace SDA
+{
+	LatencyHistogram::LatencyHistogram()
+	{
+		Reset();
+	}
+
+	LatencyHistogram::~LatencyHistogram()
+	{}
+
+	void LatencyHistogram::Record(const std::uint64_t value)
+	{
+		++mBuckets[BucketIndex(value)];
+
+		++mCount;
+		mMin = std::min(mMin, value);
+		mMax = std::max(mMax, value);
+		mSum += (double)value;
+	}
+
+	void LatencyHistogram::Merge(const LatencyHistogram& histogram)
+	{
+		for (std::size_t index = 0; index < BUCKET_COUNT; ++index)
+		{
+			mBuckets[index] += histogram.mBuckets[index];
+		}
+
+		mCount += histogram.mCount;
+		mMin = std::min(mMin, histogram.mMin);
+		mMax = std::max(mMax, histogram.mMax);
+		mSum += histogram.mSum;
+	}
+
+	void LatencyHistogram::Reset()
+	{
+		std::fill(mBuckets, mBuckets + BUCKET_COUNT, 0);
+
+		mCount = 0;
+		mMin = UINT64_MAX;
+		mMax = 0;
+		mSum = 0.0;
+	}
+
+	std::uint64_t LatencyHistogram::Count() const
+	{
+		return mCount;
+	}
+
+	std::uint64_t LatencyHistogram::Min() const
+	{
+		return (mCount > 0) ? mMin : 0;
+	}
+
+	std::uint64_t LatencyHistogram::Max() const
+	{
+		return mMax;
+	}
+
+	double LatencyHistogram::Mean() const
+	{
+		return (mCount > 0) ? mSum / mCount : 0.0;
+	}
+
+	std::uint64_t LatencyHistogram::Percentile(const double percentile) const
+	{
+		assert(percentile >= 0.0 && percentile <= 1.0);
+
+		if (0 == mCount)
+		{
+			return 0;
+		}
+
+		// the rank of the value we look for, at least the first one
+		const std::uint64_t rank = std::max<std::uint64_t>(1, (std::uint64_t)std::ceil(percentile * mCount));
+
+		std::uint64_t count = 0;
+		for (std::size_t index = 0; index < BUCKET_COUNT; ++index)
+		{
+			count += mBuckets[index];
+			if (count >= rank)
+			{
+				// the bucket is an approximation, never report more than what was recorded
+				return std::min(BucketValue(index), mMax);
+			}
+		}
+
+		return mMax;
+	}
+
+	std::size_t LatencyHistogram::BucketIndex(const std::uint64_t value)
+	{
+		// small values have their own bucket
+		if (value < SUB_BUCKET_COUNT)
+		{
+			return (std::size_t)value;
+		}
+
+		// keep the SUB_BUCKET_BITS most significant bits, the mantissa is in [HALF_SUB_BUCKET_COUNT, SUB_BUCKET_COUNT)
+		const std::size_t shift = SDA::Log2((std::size_t)value) - SUB_BUCKET_BITS + 1;
+		const std::size_t mantissa = (std::size_t)(value >> shift);
+
+		return SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT + (mantissa - HALF_SUB_BUCKET_COUNT);
+	}
+
+	std::uint64_t LatencyHistogram::BucketValue(const std::size_t index)
+	{
+		if (index < SUB_BUCKET_COUNT)
+		{
+			return index;
+		}
+
+		const std::size_t shift = (index - SUB_BUCKET_COUNT) / HALF_SUB_BUCKET_COUNT + 1;
+		const std::uint64_t mantissa = (index - SUB_BUCKET_COUNT) % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+
+		return ((mantissa + 1) << shift) - 1;
+	}
+}
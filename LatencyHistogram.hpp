@@ -0,0 +1,58 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <cstddef> // size_t
+#include <cstdint>
+
+/*
+LatencyHistogram - HDR style histogram (log-linear buckets) for latencies in nanoseconds.
+Every power of 2 range is split in HALF_SUB_BUCKET_COUNT linear buckets, so any recorded value
+is known with a relative error below 1 / HALF_SUB_BUCKET_COUNT (~3%), from 1ns up to 2^64ns,
+in a fixed amount of memory and without allocations.
+Values below SUB_BUCKET_COUNT are exact.
+
+TIME COMPLEXITY:
+- Record = O(1)
+- Percentile = O(BUCKET_COUNT)
+- Merge = O(BUCKET_COUNT)
+*/
+
+namespace SDA
+{
+	class LatencyHistogram
+	{
+	public:
+		LatencyHistogram();
+		virtual ~LatencyHistogram();
+
+		void Record(const std::uint64_t value);
+		void Merge(const LatencyHistogram& histogram);
+		void Reset();
+
+		std::uint64_t Count() const;
+		std::uint64_t Min() const;
+		std::uint64_t Max() const;
+		double Mean() const;
+
+		// percentile in [0, 1], e.g. 0.99 for p99
+		std::uint64_t Percentile(const double percentile) const;
+
+	private:
+		static std::size_t BucketIndex(const std::uint64_t value);
+		// the highest value that falls in the bucket
+		static std::uint64_t BucketValue(const std::size_t index);
+
+		static const std::size_t SUB_BUCKET_BITS = 6;
+		static const std::size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+		static const std::size_t HALF_SUB_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+		static const std::size_t BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * HALF_SUB_BUCKET_COUNT;
+
+		std::uint64_t mBuckets[BUCKET_COUNT];
+		std::uint64_t mCount;
+		std::uint64_t mMin;
+		std::uint64_t mMax;
+		double mSum;
+	};
+}
+
+#endif /* LATENCY_HISTOGRAM_HPP */
\ No newline at end of file
@@ -7,30 +7,64 @@
 namespace SDA
 {
 	LiniarAllocator::LiniarAllocator()
-		: Allocator(), mMemoryBuffer(nullptr), mOffset(0)
+		: Allocator(), mMemoryBuffer(nullptr), mOffset(0), mAvailableSize(0)
+		, mIsVirtualMemory(false), mVirtualMemoryOptions(), mVirtualMemory()
 	{}
 
 	LiniarAllocator::LiniarAllocator(const std::size_t totalSize)
-		: Allocator(totalSize), mMemoryBuffer(nullptr), mOffset(0)
+		: Allocator(totalSize), mMemoryBuffer(nullptr), mOffset(0), mAvailableSize(0)
+		, mIsVirtualMemory(false), mVirtualMemoryOptions(), mVirtualMemory()
+	{}
+
+	LiniarAllocator::LiniarAllocator(const std::size_t totalSize, const VirtualMemoryOptions& options)
+		: Allocator(totalSize), mMemoryBuffer(nullptr), mOffset(0), mAvailableSize(0)
+		, mIsVirtualMemory(true), mVirtualMemoryOptions(options), mVirtualMemory()
 	{}
 
 	LiniarAllocator::~LiniarAllocator()
 	{
-		if (mMemoryBuffer)
+		if (mMemoryBuffer && false == mIsVirtualMemory)
 		{
 			free(mMemoryBuffer);
 		}
 		mMemoryBuffer = nullptr;
 		mOffset = 0;
+		mAvailableSize = 0;
 	}
 
 	void LiniarAllocator::Init()
 	{
-		mMemoryBuffer = malloc(mTotalSize);
+		if (mIsVirtualMemory)
+		{
+			// only the address space is reserved, the pages are committed in Allocate()
+			mMemoryBuffer = mVirtualMemory.Reserve(mTotalSize, mVirtualMemoryOptions) ? mVirtualMemory.Base() : nullptr;
+		}
+		else
+		{
+			if (mMemoryBuffer)
+			{
+				free(mMemoryBuffer);
+			}
+			mMemoryBuffer = malloc(mTotalSize);
+		}
+
+		// the virtual memory is committed on demand
+		mAvailableSize = (mMemoryBuffer && false == mIsVirtualMemory) ? mTotalSize : 0;
+
+		mOffset = 0;
+		mUsed = 0;
+		mPeak = 0;
 	}
 
 	void LiniarAllocator::Reset()
 	{
+		if (mIsVirtualMemory && mVirtualMemoryOptions.releaseOnReset)
+		{
+			// give the pages back to the OS
+			mVirtualMemory.Decommit();
+			mAvailableSize = mVirtualMemory.Committed();
+		}
+
 		mOffset = 0;
 		mUsed = 0;
 		mPeak = 0;
@@ -43,14 +77,15 @@ namespace SDA
 		const std::size_t currentAddress = (std::size_t)mMemoryBuffer + mOffset;
 
 		// in case alignment is needed we find the correct padding
+		// (the address is aligned, not the offset, malloc() gives only max_align_t alignment)
 		std::size_t padding = 0;
-		if ((alignment > 0) && (mOffset % alignment != 0))
+		if ((alignment > 0) && (currentAddress % alignment != 0))
 		{
 			padding = SDA::CalculateMemoryPadding(currentAddress, alignment);
 		}
 
 		// check if there is space left to allocate
-		if (mOffset + padding + size > mTotalSize)
+		if (mOffset + padding + size > mAvailableSize && false == Reserve(mOffset + padding + size))
 		{
 			return nullptr;
 		}
@@ -64,9 +99,27 @@ namespace SDA
 		return (void*)nextAvailableAddress;
 	}
 
-	void LiniarAllocator::Free(void* ptr)
+	void LiniarAllocator::Free(void* /* ptr */)
+	{
+		// nothing to do, the memory is given back only by Reset()
+		// so the containers can use this allocator as an arena
+	}
+
+	bool LiniarAllocator::Reserve(const std::size_t size)
 	{
-		// This allocator does not support this operation!
-		assert(false && "Use Reset() method");
+		if (nullptr == mMemoryBuffer || size > mTotalSize || false == mIsVirtualMemory)
+		{
+			return false;
+		}
+
+		// commit the pages lazily as the offset grows
+		if (false == mVirtualMemory.Commit(size))
+		{
+			return false;
+		}
+
+		mAvailableSize = mVirtualMemory.Committed();
+
+		return true;
 	}
 }
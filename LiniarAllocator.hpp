@@ -2,7 +2,8 @@
 #define LINIAR_ALLOCATOR_HPP
 
 #include "Allocator.hpp"
-#include <cstddef> // size_t
+#include "VirtualMemory.hpp"
+#include <cstddef> // size_t, max_align_t
 
 namespace SDA
 {
@@ -11,6 +12,8 @@ namespace SDA
 	public:
 		LiniarAllocator();
 		LiniarAllocator(const std::size_t totalSize);
+		// backed by virtual memory instead of malloc()
+		LiniarAllocator(const std::size_t totalSize, const VirtualMemoryOptions& options);
 		virtual ~LiniarAllocator();
 
 		void Init();
@@ -19,12 +22,90 @@ namespace SDA
 		void* Allocate(const std::size_t size, const std::size_t alignment);
 		void Free(void* ptr);
 
+		/* Fast path - size and alignment known at compile time, the bump is inlined
+		   and the alignment is a mask, no virtual call when used on a LiniarAllocator.
+		   The memory is not constructed. */
+		template <std::size_t Size, std::size_t Alignment = alignof(std::max_align_t)>
+		void* Allocate();
+		template <class T>
+		T* Allocate();
+		template <class T>
+		T* AllocateArray(const std::size_t count);
+
 	private:
 		NON_COPY_AND_MOVE(LiniarAllocator)
 
+		template <std::size_t Alignment>
+		void* AllocateAligned(const std::size_t size);
+
+		// makes sure the offset can grow up to size, commits more virtual memory if needed
+		bool Reserve(const std::size_t size);
+
 		void* mMemoryBuffer;
 		std::size_t mOffset;
+		std::size_t mAvailableSize; // the offset can grow up to here without a system call
+
+		bool mIsVirtualMemory;
+		VirtualMemoryOptions mVirtualMemoryOptions;
+		VirtualMemoryArena mVirtualMemory;
 	};
+
+	template <std::size_t Size, std::size_t Alignment>
+	inline void* LiniarAllocator::Allocate()
+	{
+		static_assert(Size > 0, "Size must be greater than 0");
+		static_assert(Alignment > 0 && 0 == (Alignment & (Alignment - 1)), "Alignment must be a power of 2");
+
+		return AllocateAligned<Alignment>(Size);
+	}
+
+	template <class T>
+	inline T* LiniarAllocator::Allocate()
+	{
+		return (T*)AllocateAligned<alignof(T)>(sizeof(T));
+	}
+
+	template <class T>
+	inline T* LiniarAllocator::AllocateArray(const std::size_t count)
+	{
+		if (0 == count)
+		{
+			return nullptr;
+		}
+
+		// the size would overflow
+		if (count > (std::size_t)-1 / sizeof(T))
+		{
+			return nullptr;
+		}
+
+		return (T*)AllocateAligned<alignof(T)>(sizeof(T) * count);
+	}
+
+	template <std::size_t Alignment>
+	inline void* LiniarAllocator::AllocateAligned(const std::size_t size)
+	{
+		const std::size_t bufferAddress = (std::size_t)mMemoryBuffer;
+
+		// the mask is a compile time constant, no padding if the address is already aligned
+		const std::size_t alignedAddress = (bufferAddress + mOffset + (Alignment - 1)) & ~(Alignment - 1);
+		const std::size_t newOffset = alignedAddress - bufferAddress + size;
+
+		// the slow path: out of memory or more virtual memory has to be committed
+		if (newOffset > mAvailableSize && false == Reserve(newOffset))
+		{
+			return nullptr;
+		}
+
+		mOffset = newOffset;
+		mUsed = newOffset;
+		if (newOffset > mPeak)
+		{
+			mPeak = newOffset;
+		}
+
+		return (void*)alignedAddress;
+	}
 }
 
 #endif /* LINIAR_ALLOCATOR_HPP */
\ No newline at end of file
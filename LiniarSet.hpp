@@ -2,6 +2,7 @@
 #define LINIAR_SET_HPP
 
 #include <cassert>
+#include "AllocatorUtility.hpp"
 
 namespace SDA
 {
@@ -9,9 +10,10 @@ namespace SDA
 	class LiniarSet
 	{
 	public:
-		LiniarSet();
-		LiniarSet(size_t size);
-		LiniarSet(size_t size, const T& el);
+		// nullptr allocator means the global heap
+		LiniarSet(Allocator* allocator = nullptr);
+		LiniarSet(size_t size, Allocator* allocator = nullptr);
+		LiniarSet(size_t size, const T& el, Allocator* allocator = nullptr);
 		LiniarSet(const LiniarSet<T>& set);
 		LiniarSet(LiniarSet<T>&& set);
 		~LiniarSet();
@@ -25,9 +27,11 @@ namespace SDA
 		size_t capacity();
 		size_t size();
 
+		void clear();
+
 		void addElement(const T& el);
 
-		bool exists(const T& el);
+		bool exists(const T& el) const;
 
 		LiniarSet<T> reunion(const LiniarSet<T>& set);
 		LiniarSet<T> intersection(const LiniarSet<T>& set);
@@ -36,6 +40,8 @@ namespace SDA
 		void reserve(size_t capacity);
 		void resize(size_t size);
 
+		Allocator* getAllocator() const;
+
 	private:
 		void Copy(const LiniarSet<T>& set);
 		void Move(LiniarSet<T>&& set);
@@ -44,6 +50,8 @@ namespace SDA
 		T* mBuffer;
 		size_t mSize;
 		size_t mCapacity; //at least double of the size
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -59,50 +67,49 @@ namespace SDA
 	 */
 
 	template <class T>
-	LiniarSet<T>::LiniarSet()
-		: mCapacity(0), mSize(0), mBuffer(nullptr) //avoid nullptr buffer
+	LiniarSet<T>::LiniarSet(Allocator* allocator)
+		: mCapacity(0), mSize(0), mBuffer(nullptr), mAllocator(allocator) //avoid nullptr buffer
 	{}
 
 	template <class T>
-	LiniarSet<T>::LiniarSet(size_t size)
-		: mSize(size), mCapacity(size)
+	LiniarSet<T>::LiniarSet(size_t size, Allocator* allocator)
+		: mSize(size), mCapacity(size), mAllocator(allocator)
 	{
-		mBuffer = new T[mCapacity];
+		mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 	}
 
 	template <class T>
-	LiniarSet<T>::LiniarSet(size_t size, const T& el)
-		: LiniarSet(size)
+	LiniarSet<T>::LiniarSet(size_t size, const T& el, Allocator* allocator)
+		: LiniarSet(size, allocator)
 	{
+		// the elements are already constructed by NewArray()
 		for (size_t i = 0; i < mSize; ++i)
 		{
-			// create via placement new()
-			new (mBuffer + i) T(el);
+			mBuffer[i] = el;
 		}
 	}
 
 	template <class T>
 	LiniarSet<T>::LiniarSet(const LiniarSet<T>& set)
+		: mBuffer(nullptr), mSize(0), mCapacity(0), mAllocator(set.mAllocator) // the copy uses the same allocator
 	{
 		operator = (set);
 	}
 
 	template <class T>
 	LiniarSet<T>::LiniarSet(LiniarSet<T>&& set)
+		: mBuffer(nullptr), mSize(0), mCapacity(0), mAllocator(set.mAllocator)
 	{
-		operator = (set);
+		operator = (std::move(set));
 	}
 
 	template <class T>
 	LiniarSet<T>::~LiniarSet()
 	{
+		Destroy();
+
 		mSize = 0;
 		mCapacity = 0;
-
-		if (mBuffer)
-		{
-			delete[] mBuffer;
-		}
 	}
 
 	template <class T>
@@ -110,12 +117,13 @@ namespace SDA
 	{
 		if (this != &set)
 		{
+			// the old buffer is destroyed with the old capacity
+			Destroy();
+
 			mSize = set.mSize;
 			mCapacity = set.mCapacity;
 
-			Destroy();
-
-			mBuffer = new T[mCapacity];
+			mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 
 			for (size_t i = 0; i < mSize; ++i)
 			{
@@ -129,12 +137,13 @@ namespace SDA
 	{
 		if (this != &set)
 		{
+			// the old buffer is destroyed with the old capacity
+			Destroy();
+
 			mSize = set.mSize;
 			mCapacity = set.mCapacity;
 
-			Destroy();
-
-			mBuffer = new T[mCapacity];
+			mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 
 			for (size_t i = 0; i < mSize; ++i)
 			{
@@ -148,7 +157,8 @@ namespace SDA
 	{
 		if (mBuffer)
 		{
-			delete[] mBuffer;
+			SDA::DeleteArray(mAllocator, mBuffer, mCapacity);
+			mBuffer = nullptr;
 		}
 	}
 
@@ -157,20 +167,17 @@ namespace SDA
 	{
 		if (this != &set)
 		{
+			// the old buffer is destroyed with the old capacity
+			Destroy();
+
 			mSize = set.mSize;
 			mCapacity = set.mCapacity;
 
-			if (mBuffer)
-			{
-				delete[] mBuffer;
-			}
-
-			mBuffer = new T[mCapacity];
+			mBuffer = SDA::NewArray<T>(mAllocator, mCapacity);
 
 			for (size_t i = 0; i < mSize; ++i)
 			{
-				// copy via placement new()
-				new (mBuffer + i) T(set.mBuffer[i]);
+				mBuffer[i] = set.mBuffer[i];
 			}
 		}
 		return *this;
@@ -181,19 +188,19 @@ namespace SDA
 	{
 		if (this != &set)
 		{
+			// the old buffer is destroyed with the old capacity
+			Destroy();
+
 			mSize = set.mSize;
 			mCapacity = set.mCapacity;
 
-			if (mBuffer)
-			{
-				delete[] mBuffer;
-			}
-
+			// the buffer is freed with the allocator of set
 			mBuffer = set.mBuffer;
+			mAllocator = set.mAllocator;
 
 			set.mBuffer = nullptr;
 			set.mSize = 0;
-			set.capacity = 0;
+			set.mCapacity = 0;
 
 		}
 		return *this;
@@ -232,11 +239,8 @@ namespace SDA
 	template <class T>
 	void LiniarSet<T>::clear()
 	{
-		// destorying all the elements int eh buffer, not the buffer itself though
-		for (size_t i = 0; i < mSize; ++i)
-		{
-			mBuffer[i].~T();
-		}
+		// the elements stay constructed (NewArray()) and are overwritten by addElement(), the buffer is kept
+		mSize = 0;
 	}
 
 	template <class T>
@@ -244,13 +248,13 @@ namespace SDA
 	{
 		if (mSize >= mCapacity)
 		{
-			reserve(mCapacity * 2); //when not enough space we double the capacity
+			reserve(mCapacity > 0 ? mCapacity * 2 : 2); //when not enough space we double the capacity
 		}
 		mBuffer[mSize++] = el;
 	}
 
 	template <class T>
-	bool LiniarSet<T>::exists(const T& el)
+	bool LiniarSet<T>::exists(const T& el) const
 	{
 		for (size_t i = 0; i < mSize; ++i)
 		{
@@ -272,7 +276,7 @@ namespace SDA
 		// hence creating a reunion set
 		for (size_t i = 0; i < set.mSize; ++i)
 		{
-			T& el = set.mBuffer[i];
+			const T& el = set.mBuffer[i];
 			if (reu.exists(el) == false)
 			{
 				reu.addElement(el);
@@ -291,8 +295,8 @@ namespace SDA
 		// add those that exist to the intersection set
 		for (size_t i = 0; i < set.mSize; ++i)
 		{
-			T& el = set.mBuffer[i];
-			if (this.exists(el) == true)
+			const T& el = set.mBuffer[i];
+			if (this->exists(el) == true)
 			{
 				inter.addElement(el);
 			}
@@ -308,12 +312,12 @@ namespace SDA
 		// elements of this set that are not in the second set
 
 		LiniarSet<T> diff;
-		for (size_t i = 0; i < set.mSize; ++i)
+		for (size_t i = 0; i < mSize; ++i)
 		{
-			T& el = set.mBuffer[i];
-			if (this.exists(el) == false)
+			const T& el = mBuffer[i];
+			if (set.exists(el) == false)
 			{
-				diff.addElement(mBuffer[i]); //add elements from this set
+				diff.addElement(el); //add elements from this set
 			}
 		}
 
@@ -325,17 +329,17 @@ namespace SDA
 	{
 		if (capacity > mCapacity)
 		{
-			mCapacity = capacity;
-			T* newBuffer = new T[mCapacity];
+			T* newBuffer = SDA::NewArray<T>(mAllocator, capacity);
 
+			// the elements are already constructed by NewArray()
 			for (size_t i = 0; i < mSize; ++i)
 			{
-				// copy via placement new()
-				new (newBuffer + i) T(mBuffer[i]);
+				newBuffer[i] = mBuffer[i];
 			}
 
-			delete[] mBuffer;
+			Destroy();
 			mBuffer = newBuffer;
+			mCapacity = capacity;
 		}
 	}
 
@@ -348,6 +352,12 @@ namespace SDA
 		}
 		mSize = size;
 	}
+
+	template <class T>
+	Allocator* LiniarSet<T>::getAllocator() const
+	{
+		return mAllocator;
+	}
 }
 
 #endif /* LINIAR_SET_HPP */
\ No newline at end of file
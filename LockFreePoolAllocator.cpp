@@ -0,0 +1,182 @@
+#include "LockFreePoolAllocator.hpp"
+#include "MemoryUtility.hpp"
+#include <cstdlib> // malloc(), free()
+#include <new> // placement new
+#include <cassert>
+
+namespace SDA
+{
+	LockFreePoolAllocator::LockFreePoolAllocator()
+		: Allocator(), mRawBuffer(nullptr), mMemoryBuffer(nullptr), mChunkSize(0), mChunkCount(0)
+		, mHead(Pack(0, NULL_INDEX)), mUsedAtomic(0), mPeakAtomic(0)
+	{}
+
+	LockFreePoolAllocator::LockFreePoolAllocator(const std::size_t totalSize, const std::size_t chunkSize)
+		: Allocator(totalSize), mRawBuffer(nullptr), mMemoryBuffer(nullptr), mChunkSize(chunkSize), mChunkCount(0)
+		, mHead(Pack(0, NULL_INDEX)), mUsedAtomic(0), mPeakAtomic(0)
+	{
+		assert(chunkSize >= sizeof(std::atomic<std::uint32_t>) && "Chunk size is too small");
+		assert(chunkSize % alignof(std::atomic<std::uint32_t>) == 0 && "Chunk size must keep the chunks aligned");
+		assert(totalSize % chunkSize == 0 && "Total size must be a multiple of chunk size");
+		assert(totalSize / chunkSize < NULL_INDEX && "Too many chunks");
+
+		mChunkCount = static_cast<std::uint32_t>(totalSize / chunkSize);
+	}
+
+	LockFreePoolAllocator::~LockFreePoolAllocator()
+	{
+		if (mRawBuffer)
+		{
+			free(mRawBuffer);
+		}
+		mRawBuffer = nullptr;
+		mMemoryBuffer = nullptr;
+	}
+
+	void LockFreePoolAllocator::Init()
+	{
+		if (mRawBuffer)
+		{
+			free(mRawBuffer);
+		}
+
+		// malloc() gives only max_align_t alignment, the extra bytes let the first chunk start aligned
+		const std::size_t alignment = ChunkAlignment();
+		mRawBuffer = malloc(mTotalSize + alignment - 1);
+		mMemoryBuffer = (void*)((std::size_t)mRawBuffer + CalculateMemoryPadding((std::size_t)mRawBuffer, alignment));
+
+		Reset();
+	}
+
+	void LockFreePoolAllocator::Reset()
+	{
+		mUsedAtomic.store(0, std::memory_order_relaxed);
+		mPeakAtomic.store(0, std::memory_order_relaxed);
+
+		if (nullptr == mMemoryBuffer || 0 == mChunkCount)
+		{
+			mHead.store(Pack(0, NULL_INDEX), std::memory_order_release);
+			return;
+		}
+
+		// link every chunk to the next one, the last one ends the list
+		for (std::uint32_t index = 0; index < mChunkCount; ++index)
+		{
+			const std::uint32_t next = (index + 1 < mChunkCount) ? index + 1 : NULL_INDEX;
+
+			new ((void*)Next(index)) std::atomic<std::uint32_t>(next);
+		}
+
+		// keep increasing the tag so a stale head of the previous run never matches
+		const std::uint32_t tag = Tag(mHead.load(std::memory_order_relaxed)) + 1;
+		mHead.store(Pack(tag, 0), std::memory_order_release);
+	}
+
+	void* LockFreePoolAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0 && size <= mChunkSize && "Allocation size must fit in a chunk");
+		assert((alignment == 0 || alignment <= ChunkAlignment()) && "Alignment not supported by the chunk size");
+
+		std::uint64_t head = mHead.load(std::memory_order_acquire);
+		std::uint32_t index = NULL_INDEX;
+
+		do
+		{
+			index = Index(head);
+
+			// no chunk left
+			if (NULL_INDEX == index)
+			{
+				return nullptr;
+			}
+
+			// the chunk may be taken meanwhile by another thread and next may be garbage,
+			// but then the tag of the head changed and the CAS fails
+			const std::uint32_t next = Next(index)->load(std::memory_order_relaxed);
+			const std::uint64_t newHead = Pack(Tag(head) + 1, next);
+
+			if (mHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				break;
+			}
+		} while (true);
+
+		// update the statistics
+		const std::size_t used = mUsedAtomic.fetch_add(mChunkSize, std::memory_order_relaxed) + mChunkSize;
+		std::size_t peak = mPeakAtomic.load(std::memory_order_relaxed);
+		while (used > peak && false == mPeakAtomic.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+		{}
+
+		return (void*)((std::size_t)mMemoryBuffer + index * mChunkSize);
+	}
+
+	void LockFreePoolAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		assert((std::size_t)ptr >= (std::size_t)mMemoryBuffer &&
+			(std::size_t)ptr < (std::size_t)mMemoryBuffer + mTotalSize && "Pointer not owned by this allocator");
+
+		const std::uint32_t index = static_cast<std::uint32_t>(((std::size_t)ptr - (std::size_t)mMemoryBuffer) / mChunkSize);
+
+		// the user data is gone, the chunk holds the link again
+		std::atomic<std::uint32_t>* next = Next(index);
+
+		std::uint64_t head = mHead.load(std::memory_order_relaxed);
+		std::uint64_t newHead = 0;
+
+		do
+		{
+			next->store(Index(head), std::memory_order_relaxed);
+			newHead = Pack(Tag(head) + 1, index);
+		} while (false == mHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+
+		mUsedAtomic.fetch_sub(mChunkSize, std::memory_order_relaxed);
+	}
+
+	std::size_t LockFreePoolAllocator::Used()
+	{
+		return mUsedAtomic.load(std::memory_order_relaxed);
+	}
+
+	std::size_t LockFreePoolAllocator::Peak()
+	{
+		return mPeakAtomic.load(std::memory_order_relaxed);
+	}
+
+	std::size_t LockFreePoolAllocator::ChunkSize() const
+	{
+		return mChunkSize;
+	}
+
+	std::size_t LockFreePoolAllocator::ChunkAlignment() const
+	{
+		// the lowest set bit of the chunk size
+		const std::size_t alignment = mChunkSize & (~mChunkSize + 1);
+
+		return (alignment < MAX_CHUNK_ALIGNMENT) ? alignment : MAX_CHUNK_ALIGNMENT;
+	}
+
+	std::uint64_t LockFreePoolAllocator::Pack(const std::uint32_t tag, const std::uint32_t index)
+	{
+		return ((std::uint64_t)tag << 32) | index;
+	}
+
+	std::uint32_t LockFreePoolAllocator::Tag(const std::uint64_t head)
+	{
+		return static_cast<std::uint32_t>(head >> 32);
+	}
+
+	std::uint32_t LockFreePoolAllocator::Index(const std::uint64_t head)
+	{
+		return static_cast<std::uint32_t>(head & 0xFFFFFFFF);
+	}
+
+	std::atomic<std::uint32_t>* LockFreePoolAllocator::Next(const std::uint32_t index) const
+	{
+		return (std::atomic<std::uint32_t>*)((std::size_t)mMemoryBuffer + index * mChunkSize);
+	}
+}
@@ -0,0 +1,75 @@
+#ifndef LOCK_FREE_POOL_ALLOCATOR_HPP
+#define LOCK_FREE_POOL_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <atomic>
+
+/*
+LockFreePoolAllocator - thread safe PoolAllocator without locks.
+The head of the free list is a 64 bit word updated with compare-and-swap:
+- low 32 bits: the index of the first free chunk
+- high 32 bits: a version counter (tag) incremented on every change
+The tag makes the list ABA safe: if a chunk is popped and pushed back by other threads
+between our read and our CAS, the head has another tag and the CAS fails.
+A chunk can be freed by any thread, not only the one that allocated it.
+
+TIME COMPLEXITY:
+- Allocate/Free = O(1) without contention, retried while other threads change the head
+
+NOTE:
+- at most 2^32 - 1 chunks
+- the chunks are aligned like in PoolAllocator: to the biggest power of two dividing the chunk size, at most 4096
+- Init()/Reset() must not run concurrently with Allocate()/Free()
+*/
+
+namespace SDA
+{
+	class LockFreePoolAllocator : public Allocator
+	{
+	public:
+		LockFreePoolAllocator();
+		LockFreePoolAllocator(const std::size_t totalSize, const std::size_t chunkSize);
+		virtual ~LockFreePoolAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		std::size_t Used();
+		std::size_t Peak();
+
+		std::size_t ChunkSize() const;
+		// the biggest alignment Allocate() supports
+		std::size_t ChunkAlignment() const;
+
+		static const std::size_t MAX_CHUNK_ALIGNMENT = 4096;
+
+	private:
+		NON_COPY_AND_MOVE(LockFreePoolAllocator)
+
+		static std::uint64_t Pack(const std::uint32_t tag, const std::uint32_t index);
+		static std::uint32_t Tag(const std::uint64_t head);
+		static std::uint32_t Index(const std::uint64_t head);
+
+		// the index of the next free chunk is stored inside the free chunk
+		std::atomic<std::uint32_t>* Next(const std::uint32_t index) const;
+
+		void* mRawBuffer; // from malloc(), a bit bigger than mTotalSize so the chunks can be aligned
+		void* mMemoryBuffer; // mRawBuffer aligned to ChunkAlignment()
+		std::size_t mChunkSize;
+		std::uint32_t mChunkCount;
+
+		// on their own cache lines, every thread writes them
+		alignas(64) std::atomic<std::uint64_t> mHead;
+		alignas(64) std::atomic<std::size_t> mUsedAtomic;
+		std::atomic<std::size_t> mPeakAtomic;
+
+		static const std::uint32_t NULL_INDEX = 0xFFFFFFFF;
+	};
+}
+
+#endif /* LOCK_FREE_POOL_ALLOCATOR_HPP */
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "LockedAllocator.hpp"
+
+namespace SDA
+{
+	LockedAllocator::LockedAllocator(Allocator& allocator)
+		: Allocator(allocator.TotalSize()), mAllocator(allocator), mMutex()
+	{}
+
+	LockedAllocator::~LockedAllocator()
+	{}
+
+	void LockedAllocator::Init()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mAllocator.Init();
+		UpdateStatistics();
+	}
+
+	void LockedAllocator::Reset()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mAllocator.Reset();
+		UpdateStatistics();
+	}
+
+	void* LockedAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		void* ptr = mAllocator.Allocate(size, alignment);
+		UpdateStatistics();
+
+		return ptr;
+	}
+
+	void LockedAllocator::Free(void* ptr)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mAllocator.Free(ptr);
+		UpdateStatistics();
+	}
+
+	float LockedAllocator::Fragmentation()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		return mAllocator.Fragmentation();
+	}
+
+	void LockedAllocator::UpdateStatistics()
+	{
+		mUsed = mAllocator.Used();
+		mPeak = mAllocator.Peak();
+	}
+}
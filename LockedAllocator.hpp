@@ -0,0 +1,41 @@
+#ifndef LOCKED_ALLOCATOR_HPP
+#define LOCKED_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <mutex>
+
+/*
+LockedAllocator - makes any Allocator thread safe by guarding every call with a mutex.
+Simple but all the threads are serialized, used as a baseline for the concurrent allocators.
+The wrapped allocator is not owned.
+*/
+
+namespace SDA
+{
+	class LockedAllocator : public Allocator
+	{
+	public:
+		LockedAllocator(Allocator& allocator);
+		virtual ~LockedAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		float Fragmentation();
+
+	private:
+		NON_COPY_AND_MOVE(LockedAllocator)
+
+		// keeps Used()/Peak() in sync with the wrapped allocator, called under lock
+		void UpdateStatistics();
+
+		Allocator& mAllocator;
+		std::mutex mMutex;
+	};
+}
+
+#endif /* LOCKED_ALLOCATOR_HPP */
\ No newline at end of file
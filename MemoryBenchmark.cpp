@@ -1,72 +1,757 @@
 #include "MemoryBenchmark.hpp"
 #include "Allocator.hpp"
+#include "AllocationTrace.hpp"
 #include <cassert>
 #include <cstddef> // size_t
 #include <iostream>
+#include <fstream>
+#include <algorithm> // min, max, sort
+#include <cmath> // abs
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 namespace SDA
 {
+	namespace
+	{
+		// nanoseconds, the same clock in every thread
+		inline Timer::long_t Now(const ClockSource clockSource)
+		{
+			return static_cast<Timer::long_t>(ClockNow(clockSource));
+		}
+
+		double Median(std::vector<double> values)
+		{
+			if (values.empty())
+			{
+				return 0.0;
+			}
+
+			std::sort(values.begin(), values.end());
+
+			const std::size_t middle = values.size() / 2;
+			return (values.size() % 2) ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+		}
+
+		// the sweep doubles count, but its last step is maxCount even when that isn't a power of 2 (1, 2, 4, 6)
+		std::size_t NextCount(const std::size_t count, const std::size_t maxCount)
+		{
+			return (count == maxCount) ? count + 1 : std::min(count * 2, maxCount);
+		}
+
+		// median absolute deviation
+		double MAD(const std::vector<double>& values, const double median)
+		{
+			std::vector<double> deviations;
+			deviations.reserve(values.size());
+			for (const double value : values)
+			{
+				deviations.push_back(std::abs(value - median));
+			}
+
+			return Median(deviations);
+		}
+
+		std::string EscapeJSON(const std::string& text)
+		{
+			std::string escaped;
+			for (const char c : text)
+			{
+				if ('"' == c || '\\' == c)
+				{
+					escaped += '\\';
+				}
+				escaped += c;
+			}
+
+			return escaped;
+		}
+
+		std::string EscapeCSV(const std::string& text)
+		{
+			std::string escaped = "\"";
+			for (const char c : text)
+			{
+				if ('"' == c)
+				{
+					escaped += '"';
+				}
+				escaped += c;
+			}
+			escaped += '"';
+
+			return escaped;
+		}
+	}
+
 	MemoryBenchmark::MemoryBenchmark()
-		: mOperationCount(0), mTimer()
+		: mOperationCount(0), mRepetitionCount(DEFAULT_REPETITION_COUNT), mWarmupCount(DEFAULT_WARMUP_COUNT)
+		, mName(), mResults(), mClockSource(CLOCK_STEADY)
 	{}
 
-	MemoryBenchmark::MemoryBenchmark(const std::size_t operationCount)
-		: mOperationCount(operationCount)
-	{}
+	MemoryBenchmark::MemoryBenchmark(const std::size_t operationCount, const std::size_t repetitionCount, const std::size_t warmupCount)
+		: mOperationCount(operationCount), mRepetitionCount(repetitionCount), mWarmupCount(warmupCount)
+		, mName(), mResults(), mClockSource(CLOCK_STEADY)
+	{
+		assert(repetitionCount > 0);
+	}
 
 	MemoryBenchmark::~MemoryBenchmark()
 	{}
 
+	void MemoryBenchmark::SetName(const std::string& name)
+	{
+		mName = name;
+	}
+
 	void MemoryBenchmark::SingleAllocation(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment)
 	{
 		assert(nullptr != allocatorPtr);
 
-		mTimer.Start();
+		Run("SingleAllocation", allocatorPtr, 1, [this, allocatorPtr, size, alignment](LatencyHistogram& latency, Result& result) -> Timer::long_t
+		{
+			allocatorPtr->Init();
+
+			const Timer::long_t startTime = Now(mClockSource);
+
+			for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+			{
+				const Timer::long_t operationStartTime = Now(mClockSource);
+				void* ptr = allocatorPtr->Allocate(size, alignment);
+				latency.Record(Now(mClockSource) - operationStartTime);
+
+				if (nullptr == ptr)
+				{
+					++result.failedOperations;
+				}
+			}
+
+			return Now(mClockSource) - startTime;
+		});
+	}
+
+	void MemoryBenchmark::SingleFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment)
+	{
+		assert(nullptr != allocatorPtr);
 
-		allocatorPtr->Init();
+		std::vector<void*> allocatedMemory(mOperationCount);
 
-		for (std::size_t operation = 0; operation < mOperationCount; ++ operation)
+		Run("SingleFree", allocatorPtr, 1, [this, allocatorPtr, size, alignment, &allocatedMemory](LatencyHistogram& latency, Result& /* result */) -> Timer::long_t
 		{
-			allocatorPtr->Allocate(size, alignment);
-		}
+			allocatorPtr->Init();
 
+			// only the Free() calls are timed
+			for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+			{
+				allocatedMemory[operation] = allocatorPtr->Allocate(size, alignment);
+			}
 
-		mTimer.Stop();
+			const Timer::long_t startTime = Now(mClockSource);
 
-		CollectResults(mTimer.ElapsedTimeInMiliseconds(), allocatorPtr->Peak());
+			for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+			{
+				const Timer::long_t operationStartTime = Now(mClockSource);
+				allocatorPtr->Free(allocatedMemory[operation]);
+				latency.Record(Now(mClockSource) - operationStartTime);
+			}
+
+			return Now(mClockSource) - startTime;
+		});
 	}
 
-	void MemoryBenchmark::SingleFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment)
+	void MemoryBenchmark::AllocationAndFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment)
 	{
 		assert(nullptr != allocatorPtr);
 
-		void** allocatedMemory = new void*[mOperationCount];
+		Run("AllocationAndFree", allocatorPtr, 1, [this, allocatorPtr, size, alignment](LatencyHistogram& latency, Result& /* result */) -> Timer::long_t
+		{
+			// same sized objects churned in batches: allocate a batch, free it, repeat
+			const std::size_t batchSize = 1024;
+			void* allocatedMemory[batchSize];
+
+			allocatorPtr->Init();
+
+			const Timer::long_t startTime = Now(mClockSource);
+
+			for (std::size_t operation = 0; operation < mOperationCount; operation += batchSize)
+			{
+				const std::size_t count = std::min(batchSize, mOperationCount - operation);
 
-		allocatorPtr->Init();
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const Timer::long_t operationStartTime = Now(mClockSource);
+					allocatedMemory[i] = allocatorPtr->Allocate(size, alignment);
+					latency.Record(Now(mClockSource) - operationStartTime);
+				}
 
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const Timer::long_t operationStartTime = Now(mClockSource);
+					allocatorPtr->Free(allocatedMemory[i]);
+					latency.Record(Now(mClockSource) - operationStartTime);
+				}
+			}
+
+			return Now(mClockSource) - startTime;
+		});
+	}
+
+	void MemoryBenchmark::RandomAllocationAndFree(Allocator* allocatorPtr, const std::size_t minSize, const std::size_t maxSize, const std::size_t alignment)
+	{
+		assert(nullptr != allocatorPtr);
+		assert(minSize > 0 && minSize <= maxSize);
+
+		// a window of live blocks, every operation replaces a random one
+		// so the blocks are freed in random order and with different sizes
+		const std::size_t liveCount = 1024;
+
+		// generate the random input before we start the timer
+		std::mt19937 generator(RANDOM_SEED);
+		std::uniform_int_distribution<std::size_t> sizeDistribution(minSize, maxSize);
+		std::uniform_int_distribution<std::size_t> slotDistribution(0, liveCount - 1);
+
+		std::vector<std::size_t> sizes(mOperationCount);
+		std::vector<std::size_t> slots(mOperationCount);
 		for (std::size_t operation = 0; operation < mOperationCount; ++operation)
 		{
-			allocatedMemory[operation] = allocatorPtr->Allocate(size, alignment);
+			sizes[operation] = sizeDistribution(generator);
+			slots[operation] = slotDistribution(generator);
 		}
 
-		for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+		Run("RandomAllocationAndFree", allocatorPtr, 1, [this, allocatorPtr, alignment, liveCount, &sizes, &slots](LatencyHistogram& latency, Result& result) -> Timer::long_t
+		{
+			void* liveMemory[liveCount] = {};
+
+			allocatorPtr->Init();
+
+			const Timer::long_t startTime = Now(mClockSource);
+
+			for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+			{
+				const std::size_t slot = slots[operation];
+
+				if (liveMemory[slot])
+				{
+					const Timer::long_t operationStartTime = Now(mClockSource);
+					allocatorPtr->Free(liveMemory[slot]);
+					latency.Record(Now(mClockSource) - operationStartTime);
+				}
+
+				const Timer::long_t operationStartTime = Now(mClockSource);
+				liveMemory[slot] = allocatorPtr->Allocate(sizes[operation], alignment);
+				latency.Record(Now(mClockSource) - operationStartTime);
+
+				if (nullptr == liveMemory[slot])
+				{
+					++result.failedOperations;
+				}
+			}
+
+			const Timer::long_t elapsedTime = Now(mClockSource) - startTime;
+
+			result.fragmentation = std::max(result.fragmentation, allocatorPtr->Fragmentation());
+
+			for (std::size_t slot = 0; slot < liveCount; ++slot)
+			{
+				allocatorPtr->Free(liveMemory[slot]);
+			}
+
+			return elapsedTime;
+		});
+	}
+
+	void MemoryBenchmark::MultiThreadedAllocationAndFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment, const std::size_t maxThreadCount)
+	{
+		assert(nullptr != allocatorPtr);
+		assert(maxThreadCount > 0);
+
+		// every thread runs the same churn as AllocationAndFree(),
+		// the thread count is doubled every run: 1, 2, 4 ... maxThreadCount
+		for (std::size_t threadCount = 1; threadCount <= maxThreadCount; threadCount = NextCount(threadCount, maxThreadCount))
+		{
+			Run("MultiThreadedAllocationAndFree", allocatorPtr, threadCount, [this, allocatorPtr, size, alignment, threadCount](LatencyHistogram& latency, Result& /* result */) -> Timer::long_t
+			{
+				// one histogram per thread, merged at the end
+				std::vector<LatencyHistogram> threadLatencies(threadCount);
+
+				allocatorPtr->Init();
+
+				std::vector<std::thread> workers;
+				workers.reserve(threadCount);
+
+				const Timer::long_t startTime = Now(mClockSource);
+
+				for (std::size_t thread = 0; thread < threadCount; ++thread)
+				{
+					workers.emplace_back([this, allocatorPtr, size, alignment, &threadLatency = threadLatencies[thread]]()
+					{
+						const std::size_t batchSize = 1024;
+						void* allocatedMemory[batchSize];
+
+						for (std::size_t operation = 0; operation < mOperationCount; operation += batchSize)
+						{
+							const std::size_t count = std::min(batchSize, mOperationCount - operation);
+
+							for (std::size_t i = 0; i < count; ++i)
+							{
+								const Timer::long_t operationStartTime = Now(mClockSource);
+								allocatedMemory[i] = allocatorPtr->Allocate(size, alignment);
+								threadLatency.Record(Now(mClockSource) - operationStartTime);
+							}
+
+							for (std::size_t i = 0; i < count; ++i)
+							{
+								const Timer::long_t operationStartTime = Now(mClockSource);
+								allocatorPtr->Free(allocatedMemory[i]);
+								threadLatency.Record(Now(mClockSource) - operationStartTime);
+							}
+						}
+					});
+				}
+
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+
+				const Timer::long_t elapsedTime = Now(mClockSource) - startTime;
+
+				for (const LatencyHistogram& threadLatency : threadLatencies)
+				{
+					latency.Merge(threadLatency);
+				}
+
+				return elapsedTime;
+			});
+		}
+	}
+
+	void MemoryBenchmark::ProducerConsumer(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment, const std::size_t maxThreadCount)
+	{
+		assert(nullptr != allocatorPtr);
+		assert(maxThreadCount > 1);
+
+		// pairs of threads: the producer allocates blocks and passes them through a ring
+		// of slots to the consumer which frees them, so every Free() is cross thread
+		const std::size_t slotCount = 1024;
+
+		// the pair count is doubled every run, the last run has the most pairs that fit in maxThreadCount
+		const std::size_t maxPairCount = maxThreadCount / 2;
+		for (std::size_t threadCount = 2; threadCount / 2 <= maxPairCount; threadCount = 2 * NextCount(threadCount / 2, maxPairCount))
+		{
+			Run("ProducerConsumer", allocatorPtr, threadCount, [this, allocatorPtr, size, alignment, slotCount, threadCount](LatencyHistogram& latency, Result& /* result */) -> Timer::long_t
+			{
+				const std::size_t pairCount = threadCount / 2;
+
+				// an empty slot is nullptr
+				std::vector<std::atomic<void*>> slots(pairCount * slotCount);
+				for (std::atomic<void*>& slot : slots)
+				{
+					slot.store(nullptr, std::memory_order_relaxed);
+				}
+
+				// one histogram per thread, merged at the end
+				std::vector<LatencyHistogram> threadLatencies(threadCount);
+
+				allocatorPtr->Init();
+
+				std::vector<std::thread> workers;
+				workers.reserve(threadCount);
+
+				const Timer::long_t startTime = Now(mClockSource);
+
+				for (std::size_t pair = 0; pair < pairCount; ++pair)
+				{
+					std::atomic<void*>* ring = slots.data() + pair * slotCount;
+
+					workers.emplace_back([this, allocatorPtr, size, alignment, ring, slotCount, &producerLatency = threadLatencies[pair * 2]]()
+					{
+						for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+						{
+							void* ptr = nullptr;
+							for (;;)
+							{
+								const Timer::long_t operationStartTime = Now(mClockSource);
+								ptr = allocatorPtr->Allocate(size, alignment);
+								if (ptr)
+								{
+									producerLatency.Record(Now(mClockSource) - operationStartTime);
+									break;
+								}
+
+								std::this_thread::yield(); // wait for the consumers to free some memory
+							}
+
+							std::atomic<void*>& slot = ring[operation % slotCount];
+							while (nullptr != slot.load(std::memory_order_acquire))
+							{
+								std::this_thread::yield();
+							}
+							slot.store(ptr, std::memory_order_release);
+						}
+					});
+
+					workers.emplace_back([this, allocatorPtr, ring, slotCount, &consumerLatency = threadLatencies[pair * 2 + 1]]()
+					{
+						for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+						{
+							std::atomic<void*>& slot = ring[operation % slotCount];
+
+							void* ptr = nullptr;
+							while (nullptr == (ptr = slot.load(std::memory_order_acquire)))
+							{
+								std::this_thread::yield();
+							}
+							slot.store(nullptr, std::memory_order_release);
+
+							const Timer::long_t operationStartTime = Now(mClockSource);
+							allocatorPtr->Free(ptr);
+							consumerLatency.Record(Now(mClockSource) - operationStartTime);
+						}
+					});
+				}
+
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+
+				const Timer::long_t elapsedTime = Now(mClockSource) - startTime;
+
+				for (const LatencyHistogram& threadLatency : threadLatencies)
+				{
+					latency.Merge(threadLatency);
+				}
+
+				return elapsedTime;
+			});
+		}
+	}
+
+	void MemoryBenchmark::DoublingGrowth(Allocator* allocatorPtr, const std::size_t initialSize, const std::size_t maxSize, const std::size_t alignment)
+	{
+		assert(nullptr != allocatorPtr);
+		assert(initialSize > 0 && initialSize <= maxSize);
+
+		Run("DoublingGrowth", allocatorPtr, 1, [this, allocatorPtr, initialSize, maxSize, alignment](LatencyHistogram& latency, Result& result) -> Timer::long_t
+		{
+			// replays the growth of several Vectors at the same time (like Vector::Reserve()):
+			// a buffer twice as big is allocated and the old one is freed,
+			// once maxSize is reached the Vector starts over with initialSize
+			const std::size_t vectorCount = 8;
+			const std::size_t orderOfGrowth = 2;
+			void* buffers[vectorCount] = {};
+			std::size_t capacities[vectorCount] = {};
+
+			allocatorPtr->Init();
+
+			const Timer::long_t startTime = Now(mClockSource);
+
+			for (std::size_t operation = 0; operation < mOperationCount; ++operation)
+			{
+				const std::size_t vector = operation % vectorCount;
+
+				std::size_t newCapacity = capacities[vector] * orderOfGrowth;
+				if (0 == newCapacity || newCapacity > maxSize)
+				{
+					newCapacity = initialSize;
+				}
+
+				Timer::long_t operationStartTime = Now(mClockSource);
+				void* newBuffer = allocatorPtr->Allocate(newCapacity, alignment);
+				latency.Record(Now(mClockSource) - operationStartTime);
+
+				if (nullptr == newBuffer)
+				{
+					++result.failedOperations;
+				}
+
+				if (buffers[vector])
+				{
+					operationStartTime = Now(mClockSource);
+					allocatorPtr->Free(buffers[vector]);
+					latency.Record(Now(mClockSource) - operationStartTime);
+				}
+
+				buffers[vector] = newBuffer;
+				capacities[vector] = newBuffer ? newCapacity : 0;
+			}
+
+			const Timer::long_t elapsedTime = Now(mClockSource) - startTime;
+
+			result.fragmentation = std::max(result.fragmentation, allocatorPtr->Fragmentation());
+
+			for (std::size_t vector = 0; vector < vectorCount; ++vector)
+			{
+				allocatorPtr->Free(buffers[vector]);
+			}
+
+			return elapsedTime;
+		});
+	}
+
+	void MemoryBenchmark::Replay(Allocator* allocatorPtr, const AllocationTrace& trace)
+	{
+		assert(nullptr != allocatorPtr);
+
+		// block id -> pointer returned by this allocator
+		std::vector<void*> blocks(trace.BlockCount(), nullptr);
+
+		Run("Replay", allocatorPtr, 1, [this, allocatorPtr, &trace, &blocks](LatencyHistogram& latency, Result& result) -> Timer::long_t
 		{
-			allocatorPtr->Free(allocatedMemory[operation]);
+			// all the threads of the trace are replayed on this thread, in the recorded order
+			const std::vector<AllocationEvent>& events = trace.Events();
+
+			allocatorPtr->Init();
+
+			Timer::long_t elapsedTime = 0;
+
+			for (std::size_t index = 0; index < events.size(); ++index)
+			{
+				const AllocationEvent& event = events[index];
+
+				if (AllocationEvent::FREE == event.type && nullptr == blocks[event.id])
+				{
+					continue; // the allocation failed, nothing to free
+				}
+
+				const Timer::long_t operationStartTime = Now(mClockSource);
+
+				switch (event.type)
+				{
+				case AllocationEvent::ALLOCATE:
+				{
+					void* ptr = allocatorPtr->Allocate(event.size, AllocationTrace::Alignment(event));
+					blocks[event.id] = ptr;
+					if (nullptr == ptr)
+					{
+						++result.failedOperations;
+					}
+					break;
+				}
+				case AllocationEvent::FREE:
+				{
+					allocatorPtr->Free(blocks[event.id]);
+					blocks[event.id] = nullptr;
+					break;
+				}
+				case AllocationEvent::RESET:
+				{
+					allocatorPtr->Reset();
+					std::fill(blocks.begin(), blocks.end(), nullptr);
+					break;
+				}
+				default:
+					break;
+				}
+
+				const Timer::long_t operationTime = Now(mClockSource) - operationStartTime;
+				latency.Record(operationTime);
+				elapsedTime += operationTime;
+
+				// the worst fragmentation seen, sampled out of the timed calls
+				if (0 == index % FRAGMENTATION_SAMPLE_INTERVAL)
+				{
+					result.fragmentation = std::max(result.fragmentation, allocatorPtr->Fragmentation());
+				}
+			}
+
+			result.fragmentation = std::max(result.fragmentation, allocatorPtr->Fragmentation());
+
+			// what the trace did not free
+			for (void*& ptr : blocks)
+			{
+				if (ptr)
+				{
+					allocatorPtr->Free(ptr);
+					ptr = nullptr;
+				}
+			}
+
+			return elapsedTime;
+		});
+	}
+
+	void MemoryBenchmark::SetClockSource(const ClockSource clockSource)
+	{
+		// the TSC is calibrated now and not in the middle of a measurement
+		if (CLOCK_TSC == clockSource)
+		{
+			TscClock::IsAvailable();
 		}
 
-		delete[] allocatedMemory;
+		mClockSource = clockSource;
+	}
+
+	ClockSource MemoryBenchmark::GetClockSource() const
+	{
+		return mClockSource;
+	}
+
+	const std::vector<MemoryBenchmark::Result>& MemoryBenchmark::Results() const
+	{
+		return mResults;
+	}
+
+	void MemoryBenchmark::ClearResults()
+	{
+		mResults.clear();
 	}
 
-	void MemoryBenchmark::CollectResults(Timer::long_t elapsedTime, const std::size_t memoryPeak)
+	void MemoryBenchmark::WriteResults(std::ostream& out, const OutputFormat format) const
 	{
-		float operationsPerSecond = static_cast<float>(mOperationCount) / elapsedTime;
-		float timePerOperation = static_cast<float>(elapsedTime) / mOperationCount;
+		const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+		const char* percentileNames[] = { "p50", "p90", "p99", "p999" };
+		const std::size_t percentileCount = sizeof(percentiles) / sizeof(percentiles[0]);
+
+		switch (format)
+		{
+		case OUTPUT_JSON:
+		{
+			out << "[" << std::endl;
+			for (std::size_t index = 0; index < mResults.size(); ++index)
+			{
+				const Result& result = mResults[index];
+
+				out << "\t{" << std::endl;
+				out << "\t\t\"name\": \"" << EscapeJSON(result.name) << "\"," << std::endl;
+				out << "\t\t\"benchmark\": \"" << EscapeJSON(result.benchmark) << "\"," << std::endl;
+				out << "\t\t\"threads\": " << result.threadCount << "," << std::endl;
+				out << "\t\t\"repetitions\": " << result.repetitionCount << "," << std::endl;
+				out << "\t\t\"operations\": " << result.operationCount << "," << std::endl;
+				out << "\t\t\"time_per_operation_ns\": [";
+				for (std::size_t repetition = 0; repetition < result.timePerOperation.size(); ++repetition)
+				{
+					out << (repetition ? ", " : "") << result.timePerOperation[repetition];
+				}
+				out << "]," << std::endl;
+				out << "\t\t\"median_ns\": " << result.medianTimePerOperation << "," << std::endl;
+				out << "\t\t\"mad_ns\": " << result.madTimePerOperation << "," << std::endl;
+				out << "\t\t\"latency_ns\": { \"min\": " << result.latency.Min() << ", \"mean\": " << result.latency.Mean();
+				for (std::size_t p = 0; p < percentileCount; ++p)
+				{
+					out << ", \"" << percentileNames[p] << "\": " << result.latency.Percentile(percentiles[p]);
+				}
+				out << ", \"max\": " << result.latency.Max() << " }," << std::endl;
+				out << "\t\t\"memory_peak\": " << result.memoryPeak << "," << std::endl;
+				out << "\t\t\"fragmentation\": " << result.fragmentation << "," << std::endl;
+				out << "\t\t\"failed_operations\": " << result.failedOperations << std::endl;
+				out << "\t}" << ((index + 1 < mResults.size()) ? "," : "") << std::endl;
+			}
+			out << "]" << std::endl;
+			break;
+		}
+		case OUTPUT_CSV:
+		{
+			out << "name,benchmark,threads,repetitions,operations,median_ns,mad_ns,min_ns,mean_ns";
+			for (std::size_t p = 0; p < percentileCount; ++p)
+			{
+				out << "," << percentileNames[p] << "_ns";
+			}
+			out << ",max_ns,memory_peak,fragmentation,failed_operations" << std::endl;
+
+			for (const Result& result : mResults)
+			{
+				out << EscapeCSV(result.name) << "," << result.benchmark << "," << result.threadCount << ","
+					<< result.repetitionCount << "," << result.operationCount << ","
+					<< result.medianTimePerOperation << "," << result.madTimePerOperation << ","
+					<< result.latency.Min() << "," << result.latency.Mean();
+				for (std::size_t p = 0; p < percentileCount; ++p)
+				{
+					out << "," << result.latency.Percentile(percentiles[p]);
+				}
+				out << "," << result.latency.Max() << "," << result.memoryPeak << ","
+					<< result.fragmentation << "," << result.failedOperations << std::endl;
+			}
+			break;
+		}
+		default:
+			assert(false && "Unknown output format");
+			break;
+		}
+	}
+
+	bool MemoryBenchmark::SaveResults(const std::string& path, const OutputFormat format) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (false == file.is_open())
+		{
+			return false;
+		}
+
+		WriteResults(file, format);
+
+		return file.good();
+	}
+
+	void MemoryBenchmark::Run(const std::string& benchmark, Allocator* allocatorPtr, const std::size_t threadCount, const RepetitionFunc& repetition)
+	{
+		Result result;
+		result.name = mName;
+		result.benchmark = benchmark;
+		result.threadCount = threadCount;
+		result.repetitionCount = mRepetitionCount;
+		result.operationCount = 0;
+		result.medianTimePerOperation = 0.0;
+		result.madTimePerOperation = 0.0;
+		result.memoryPeak = 0;
+		result.fragmentation = 0.0f;
+		result.failedOperations = 0;
+
+		for (std::size_t run = 0; run < mWarmupCount + mRepetitionCount; ++run)
+		{
+			LatencyHistogram latency;
+			Result runResult;
+			runResult.fragmentation = 0.0f;
+			runResult.failedOperations = 0;
+
+			const Timer::long_t elapsedTime = repetition(latency, runResult);
+
+			// the warmup runs only fill the caches
+			if (run < mWarmupCount)
+			{
+				continue;
+			}
+
+			// every Allocate() or Free() call is an operation
+			result.operationCount = (std::size_t)latency.Count();
+			result.timePerOperation.push_back((latency.Count() > 0) ? (double)elapsedTime / latency.Count() : 0.0);
+			result.latency.Merge(latency);
+
+			result.memoryPeak = std::max(result.memoryPeak, allocatorPtr->Peak());
+			result.fragmentation = std::max(result.fragmentation, std::max(runResult.fragmentation, allocatorPtr->Fragmentation()));
+			result.failedOperations += runResult.failedOperations;
+		}
+
+		CollectResults(result);
+	}
+
+	void MemoryBenchmark::CollectResults(Result& result)
+	{
+		result.medianTimePerOperation = Median(result.timePerOperation);
+		result.madTimePerOperation = MAD(result.timePerOperation, result.medianTimePerOperation);
+
+		// nanoseconds, no division by zero on fast runs
+		const double operationsPerSecond = (result.medianTimePerOperation > 0.0) ? 1e9 / result.medianTimePerOperation : 0.0;
 
 		// Print results
 		std::cout << "---------- BENCHMARK --------- " << std::endl;
+		std::cout << "Name: " << result.name << std::endl;
+		std::cout << "Benchmark: " << result.benchmark << std::endl;
+		std::cout << "Threads: " << result.threadCount << std::endl;
+		std::cout << "Repetitions: " << result.repetitionCount << std::endl;
 		std::cout << "Operations per sec: " << operationsPerSecond << std::endl;
-		std::cout << "Time per Operation: " << timePerOperation << std::endl;
-		std::cout << "Memory peak: " << memoryPeak << std::endl;
+		std::cout << "Time per Operation (ns): " << result.medianTimePerOperation << " +/- " << result.madTimePerOperation << " (median +/- MAD)" << std::endl;
+		std::cout << "Latency (ns): p50 " << result.latency.Percentile(0.5) << ", p99 " << result.latency.Percentile(0.99)
+			<< ", p999 " << result.latency.Percentile(0.999) << ", max " << result.latency.Max() << std::endl;
+		std::cout << "Failed operations: " << result.failedOperations << std::endl;
+		std::cout << "Memory peak: " << result.memoryPeak << std::endl;
+		std::cout << "Fragmentation: " << result.fragmentation << std::endl;
 		std::cout << "---------- BENCHMARK --------- " << std::endl;
+
+		mResults.push_back(result);
 	}
-}
\ No newline at end of file
+}
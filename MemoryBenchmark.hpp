@@ -3,29 +3,105 @@
 
 #include "ClassHelper.h"
 #include <cstddef> // size_t
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
 #include "Timer.hpp"
+#include "Clock.hpp"
+#include "LatencyHistogram.hpp"
+
+/*
+MemoryBenchmark - runs the same workloads against every allocator.
+
+Every benchmark is run warmupCount times (ignored) and then repetitionCount times.
+Every Allocate()/Free() call is timed on its own (nanoseconds) and recorded in a LatencyHistogram,
+the time per operation of every repetition (wall time / operations) gives the median and
+the MAD (median absolute deviation), which are not disturbed by a few noisy repetitions.
+The wall time includes the cost of timing every call, compare it only between allocators.
+SetClockSource(CLOCK_TSC) makes that cost a few nanoseconds instead of 20-30ns.
+
+The results are printed as they come and kept, so they can be saved as JSON or CSV
+and compared between builds.
+*/
 
 namespace SDA
 {
 	class Allocator;
+	class AllocationTrace;
 
 	class MemoryBenchmark
 	{
 	public:
+		enum OutputFormat
+		{
+			OUTPUT_JSON = 0,
+			OUTPUT_CSV
+		};
+
+		struct Result
+		{
+			std::string name;
+			std::string benchmark;
+			std::size_t threadCount;
+			std::size_t repetitionCount;
+			std::size_t operationCount; // per repetition, all the threads
+			std::vector<double> timePerOperation; // nanoseconds, one per repetition
+			double medianTimePerOperation;
+			double madTimePerOperation;
+			LatencyHistogram latency; // all the operations of all the repetitions
+			std::size_t memoryPeak;
+			float fragmentation;
+			std::size_t failedOperations;
+		};
+
 		MemoryBenchmark();
-		MemoryBenchmark(const std::size_t operationCount);
+		MemoryBenchmark(const std::size_t operationCount, const std::size_t repetitionCount = DEFAULT_REPETITION_COUNT, const std::size_t warmupCount = DEFAULT_WARMUP_COUNT);
 		virtual ~MemoryBenchmark();
 
+		// shows up in the results, usually the name of the allocator
+		void SetName(const std::string& name);
+		// the per operation timings are much less disturbed with CLOCK_TSC
+		void SetClockSource(const ClockSource clockSource);
+		ClockSource GetClockSource() const;
+
 		void SingleAllocation(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment);
 		void SingleFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment);
+		void AllocationAndFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment);
+		void RandomAllocationAndFree(Allocator* allocatorPtr, const std::size_t minSize, const std::size_t maxSize, const std::size_t alignment);
+		void MultiThreadedAllocationAndFree(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment, const std::size_t maxThreadCount);
+		void ProducerConsumer(Allocator* allocatorPtr, const std::size_t size, const std::size_t alignment, const std::size_t maxThreadCount);
+		void DoublingGrowth(Allocator* allocatorPtr, const std::size_t initialSize, const std::size_t maxSize, const std::size_t alignment);
+		// runs a recorded trace (see TracingAllocator), every call is timed on its own
+		void Replay(Allocator* allocatorPtr, const AllocationTrace& trace);
+
+		const std::vector<Result>& Results() const;
+		void ClearResults();
 
-		void CollectResults(Timer::long_t elapsedTime, const std::size_t memoryPeak);
+		void WriteResults(std::ostream& out, const OutputFormat format) const;
+		// returns false if the file can't be written
+		bool SaveResults(const std::string& path, const OutputFormat format) const;
 
 	private:
 		NON_COPY_AND_MOVE(MemoryBenchmark)
 
+		// runs one repetition, records the latency of every operation and returns the elapsed time in nanoseconds
+		typedef std::function<Timer::long_t(LatencyHistogram& latency, Result& result)> RepetitionFunc;
+
+		void Run(const std::string& benchmark, Allocator* allocatorPtr, const std::size_t threadCount, const RepetitionFunc& repetition);
+		void CollectResults(Result& result);
+
 		std::size_t mOperationCount;
-		SDA::Timer mTimer;
+		std::size_t mRepetitionCount;
+		std::size_t mWarmupCount;
+		std::string mName;
+		std::vector<Result> mResults;
+		ClockSource mClockSource;
+
+		static const unsigned int RANDOM_SEED = 42; // same input for every allocator
+		static const std::size_t FRAGMENTATION_SAMPLE_INTERVAL = 1024; // Fragmentation() may walk the free blocks
+		static const std::size_t DEFAULT_REPETITION_COUNT = 5;
+		static const std::size_t DEFAULT_WARMUP_COUNT = 1;
 	};
 }
 #endif /* MEMORY_BENCHMARK_HPP */
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "MemoryResource.hpp"
+#include "MemoryUtility.hpp"
+#include <new> // bad_alloc
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	/////////// AllocatorMemoryResource /////////////
+
+	AllocatorMemoryResource::AllocatorMemoryResource(Allocator& allocator)
+		: std::pmr::memory_resource(), mAllocator(allocator)
+	{}
+
+	AllocatorMemoryResource::~AllocatorMemoryResource()
+	{}
+
+	Allocator& AllocatorMemoryResource::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
+	void* AllocatorMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		// our allocators do not support empty allocations
+		void* ptr = mAllocator.Allocate(std::max<std::size_t>(bytes, 1), alignment);
+		if (nullptr == ptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return ptr;
+	}
+
+	void AllocatorMemoryResource::do_deallocate(void* ptr, std::size_t /* bytes */, std::size_t /* alignment */)
+	{
+		// the size is tracked by the allocator itself
+		mAllocator.Free(ptr);
+	}
+
+	bool AllocatorMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		if (this == &other)
+		{
+			return true;
+		}
+
+		// the same allocator behind two resources, one can free what the other allocated
+		const AllocatorMemoryResource* otherResource = dynamic_cast<const AllocatorMemoryResource*>(&other);
+
+		return (nullptr != otherResource) && (&mAllocator == &otherResource->mAllocator);
+	}
+
+	/////////// MemoryResourceAllocator /////////////
+
+	MemoryResourceAllocator::MemoryResourceAllocator(std::pmr::memory_resource& resource)
+		: Allocator(), mResource(resource)
+	{}
+
+	MemoryResourceAllocator::~MemoryResourceAllocator()
+	{}
+
+	void MemoryResourceAllocator::Init()
+	{
+		Reset();
+	}
+
+	void MemoryResourceAllocator::Reset()
+	{
+		// the blocks are owned by the resource, we only reset the statistics
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void* MemoryResourceAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+		assert((0 == alignment || SDA::IsPowerOfTwo(alignment)) && "Alignment must be a power of 2");
+
+		// the header fits in the alignment padding, so the user pointer stays aligned
+		const std::size_t blockAlignment = std::max(std::max(alignment, alignof(Header)), SDA::NextPowerOfTwo(sizeof(Header)));
+
+		void* block = nullptr;
+		try
+		{
+			block = mResource.allocate(blockAlignment + size, blockAlignment);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return nullptr;
+		}
+
+		const std::size_t address = (std::size_t)block + blockAlignment;
+
+		Header* header = (Header*)(address - sizeof(Header));
+		header->size = size;
+		header->alignment = blockAlignment;
+
+		mUsed += size;
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)address;
+	}
+
+	void MemoryResourceAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		const Header* header = (const Header*)((std::size_t)ptr - sizeof(Header));
+		const std::size_t size = header->size;
+		const std::size_t blockAlignment = header->alignment;
+
+		mUsed -= size;
+
+		mResource.deallocate((void*)((std::size_t)ptr - blockAlignment), blockAlignment + size, blockAlignment);
+	}
+
+	std::pmr::memory_resource& MemoryResourceAllocator::GetResource() const
+	{
+		return mResource;
+	}
+}
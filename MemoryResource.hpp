@@ -0,0 +1,79 @@
+#ifndef MEMORY_RESOURCE_HPP
+#define MEMORY_RESOURCE_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <memory_resource> // C++17
+
+/*
+Bridges between SDA allocators and std::pmr.
+
+AllocatorMemoryResource - any SDA::Allocator seen as a std::pmr::memory_resource,
+so std::pmr::vector, std::pmr::unordered_map, ... can live in our arenas.
+Used()/Peak() of the wrapped allocator count the standard containers too.
+
+MemoryResourceAllocator - any std::pmr::memory_resource seen as an SDA::Allocator,
+so the SDA containers can use std::pmr::monotonic_buffer_resource, pools, ...
+Every block has a small header with its size and alignment, as deallocate() needs them.
+
+The wrapped allocator/resource is not owned.
+
+USAGES:
+	SDA::LiniarAllocator arena(1 << 20);
+	arena.Init();
+	SDA::AllocatorMemoryResource resource(arena);
+	std::pmr::vector<int> vec(&resource);
+*/
+
+namespace SDA
+{
+	class AllocatorMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		AllocatorMemoryResource(Allocator& allocator);
+		virtual ~AllocatorMemoryResource();
+
+		Allocator& GetAllocator() const;
+
+	protected:
+		// throws std::bad_alloc if the allocator is out of memory
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	private:
+		NON_COPY_AND_MOVE(AllocatorMemoryResource)
+
+		Allocator& mAllocator;
+	};
+
+	class MemoryResourceAllocator : public Allocator
+	{
+	public:
+		MemoryResourceAllocator(std::pmr::memory_resource& resource);
+		virtual ~MemoryResourceAllocator();
+
+		void Init();
+		void Reset();
+
+		// returns nullptr if the resource throws std::bad_alloc
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		std::pmr::memory_resource& GetResource() const;
+
+	private:
+		NON_COPY_AND_MOVE(MemoryResourceAllocator)
+
+		// stored right before the returned pointer
+		struct Header
+		{
+			std::size_t size; // user size
+			std::size_t alignment; // alignment of the whole block, also the offset to the user pointer
+		};
+
+		std::pmr::memory_resource& mResource;
+	};
+}
+
+#endif /* MEMORY_RESOURCE_HPP */
\ No newline at end of file
@@ -4,10 +4,54 @@ namespace SDA
 {
 	const std::size_t CalculateMemoryPadding(const std::size_t baseAddress, const std::size_t alignment)
 	{
-		const std::size_t multiplier = (baseAddress / alignment) + 1;
-		const std::size_t alignedAddress = multiplier * alignment;
-		const std::size_t padding = alignedAddress - baseAddress;
+		// no padding if the address is already aligned
+		const std::size_t remainder = baseAddress % alignment;
+		const std::size_t padding = (0 == remainder) ? 0 : alignment - remainder;
 
 		return padding;
 	}
+
+	const std::size_t CalculateMemoryPaddingWithHeader(const std::size_t baseAddress, const std::size_t alignment, const std::size_t headerSize)
+	{
+		std::size_t padding = (alignment > 0) ? CalculateMemoryPadding(baseAddress, alignment) : 0;
+
+		// the header is stored right before the aligned address
+		// so the padding has to be big enough to hold it
+		if (padding < headerSize)
+		{
+			const std::size_t neededSpace = headerSize - padding;
+
+			padding += (alignment > 0) ? alignment * ((neededSpace + alignment - 1) / alignment) : neededSpace;
+		}
+
+		return padding;
+	}
+
+	bool IsPowerOfTwo(const std::size_t value)
+	{
+		return (value > 0) && ((value & (value - 1)) == 0);
+	}
+
+	const std::size_t NextPowerOfTwo(const std::size_t value)
+	{
+		std::size_t power = 1;
+		while (power < value)
+		{
+			power <<= 1;
+		}
+
+		return power;
+	}
+
+	const std::size_t Log2(const std::size_t value)
+	{
+		// floor(log2(value))
+		std::size_t log = 0;
+		for (std::size_t v = value; v > 1; v >>= 1)
+		{
+			++log;
+		}
+
+		return log;
+	}
 }
\ No newline at end of file
@@ -6,6 +6,11 @@
 namespace SDA
 {
 	const std::size_t CalculateMemoryPadding(const std::size_t baseAddress, const std::size_t alignment);
+	const std::size_t CalculateMemoryPaddingWithHeader(const std::size_t baseAddress, const std::size_t alignment, const std::size_t headerSize);
+
+	bool IsPowerOfTwo(const std::size_t value);
+	const std::size_t NextPowerOfTwo(const std::size_t value);
+	const std::size_t Log2(const std::size_t value);
 }
 
 #endif /* MEMORY_UTILITY_HPP */
\ No newline at end of file
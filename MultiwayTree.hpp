@@ -6,6 +6,7 @@
 #include <functional>
 #include <iostream>
 #include <cassert>
+#include "AllocatorUtility.hpp"
 
 namespace SDA
 {
@@ -59,8 +60,9 @@ namespace SDA
 		using NodePtr = NodeT<T>*;
 
 
-		MultiwayTree();
-		MultiwayTree(const T& rootData);
+		// nullptr allocator means the global heap
+		MultiwayTree(Allocator* allocator = nullptr);
+		MultiwayTree(const T& rootData, Allocator* allocator = nullptr);
 		MultiwayTree(MultiwayTree<T>::NodePtr<T> rootNode);
 		MultiwayTree(const MultiwayTree<T>& tree);
 		MultiwayTree(MultiwayTree<T>&& tree);
@@ -93,9 +95,13 @@ namespace SDA
 		MultiwayTree<T>::NodePtr<T> traverse(MultiwayTree<T>::NodePtr<T> startNode, const std::string& finishNodeName,
 			const std::function<void(MultiwayTree<T>::NodePtr<T> node)>& func = default_func, TR_DIR dir = TR_DIR::TR_DIR_FORWARD);
 
+		Allocator* getAllocator() const;
+
 	private:
 		NodePtr<T> mRoot;
 		NodePtr<T> mBottom;
+
+		Allocator* mAllocator; // not owned
 	};
 
 	// cin & cout
@@ -132,15 +138,15 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	MultiwayTree<T>::MultiwayTree()
-		: mRoot(nullptr), mBottom(nullptr)
+	MultiwayTree<T>::MultiwayTree(Allocator* allocator)
+		: mRoot(nullptr), mBottom(nullptr), mAllocator(allocator)
 	{}
 
 	template <class T>
-	MultiwayTree<T>::MultiwayTree(const T& rootData)
-		: MultiwayTree()
+	MultiwayTree<T>::MultiwayTree(const T& rootData, Allocator* allocator)
+		: MultiwayTree(allocator)
 	{
-		mRoot = new Node(rootData);
+		mRoot = SDA::New<NodeT<T>>(mAllocator, rootData);
 	}
 
 	template <class T>
@@ -152,7 +158,7 @@ namespace SDA
 
 	template <class T>
 	MultiwayTree<T>::MultiwayTree(const MultiwayTree<T>& tree)
-		: MultiwayTree()
+		: MultiwayTree(tree.mAllocator) // the copy uses the same allocator
 	{
 		if (this != &tree)
 		{
@@ -162,6 +168,7 @@ namespace SDA
 
 	template <class T>
 	MultiwayTree<T>::MultiwayTree(MultiwayTree<T>&& tree)
+		: MultiwayTree(tree.mAllocator)
 	{
 		if (this != &tree)
 		{
@@ -186,9 +193,9 @@ namespace SDA
 	template <class T>
 	void MultiwayTree<T>::destroy()
 	{
-		traverse(mBottom, "", [](NodePtr<T> node)
+		traverse(mBottom, "", [this](NodePtr<T> node)
 			{
-				if (node) { delete node; }
+				if (node) { SDA::Delete(mAllocator, node); }
 			}
 		, TR_DIR::TR_DIR_BACKWARD);
 	}
@@ -209,6 +216,12 @@ namespace SDA
 		return *this;
 	}
 
+	template <class T>
+	Allocator* MultiwayTree<T>::getAllocator() const
+	{
+		return mAllocator;
+	}
+
 
 	template <class T>
 	bool MultiwayTree<T>::isEmpty() const
@@ -442,7 +455,7 @@ namespace SDA
 
 			nodeToRemove->parent->childrenCount--;
 
-			delete nodeToRemove;
+			SDA::Delete(mAllocator, nodeToRemove);
 		}
 		else
 		{
@@ -4,6 +4,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "Utility.hpp"
 
 namespace SDA
 {
@@ -15,11 +16,11 @@ namespace SDA
 		Pair();
 		Pair(const T1& v1, const T2& v2);
 		Pair(const Pair<T1, T2>& pair);
-		Pair(Pair<T1, T2>&& pair);
+		Pair(Pair<T1, T2>&& pair) noexcept;
 		virtual ~Pair();
 
 		Pair<T1, T2>& operator =(const Pair<T1, T2>& pair);
-		Pair<T1, T2>& operator =(Pair<T1, T2>&& pair);
+		Pair<T1, T2>& operator =(Pair<T1, T2>&& pair) noexcept;
 
 		void Swap(Pair<T1, T2>& pair);
 
@@ -61,15 +62,13 @@ namespace SDA
 
 	template <class T1, class T2>
 	Pair<T1, T2>::Pair(const Pair<T1, T2>& pair)
-	{
-		Copy(pair);
-	}
+		: mFirst(pair.mFirst), mSecond(pair.mSecond)
+	{}
 
 	template <class T1, class T2>
-	Pair<T1, T2>::Pair(Pair<T1, T2>&& pair)
-	{
-		Move(pair);
-	}
+	Pair<T1, T2>::Pair(Pair<T1, T2>&& pair) noexcept
+		: mFirst(std::move(pair.mFirst)), mSecond(std::move(pair.mSecond))
+	{}
 
 	template <class T1, class T2>
 	Pair<T1, T2>::~Pair()
@@ -86,9 +85,9 @@ namespace SDA
 	}
 
 	template <class T1, class T2>
-	Pair<T1, T2>& Pair<T1, T2>::operator =(Pair<T1, T2>&& pair)
+	Pair<T1, T2>& Pair<T1, T2>::operator =(Pair<T1, T2>&& pair) noexcept
 	{
-		Move(pair);
+		Move(std::move(pair));
 
 		return *this;
 	}
@@ -123,8 +122,7 @@ namespace SDA
 	template <class T1, class T2>
 	void Pair<T1, T2>::Destroy()
 	{
-		mFirst.~T1();
-		mSecond.~T2();
+		// nothing to release, the members are destroyed right after the destructor body
 	}
 
 	template <class T1, class T2>
@@ -166,13 +164,15 @@ namespace SDA
 	template <class T1, class T2>
 	void Pair<T1, T2>::Set(const T1& v1, const T2& v2)
 	{
-		Pair(v1, v2);
+		mFirst = v1;
+		mSecond = v2;
 	}
 
 	template <class T1, class T2>
 	void Pair<T1, T2>::Set(const Pair<T1, T2>& pair)
 	{
-		Pair(pair);
+		mFirst = pair.mFirst;
+		mSecond = pair.mSecond;
 	}
 
 	///////////// COMPARISON /////////////
@@ -188,16 +188,17 @@ namespace SDA
 		return ! (left == right);
 	}
 
+	// lexicographic, by First() then by Second(), a strict weak ordering for the sort algorithms
 	template <class T1, class T2>
-	bool operator > (const Pair<T1, T2>& left, const Pair<T1, T2>& right)
+	bool operator < (const Pair<T1, T2>& left, const Pair<T1, T2>& right)
 	{
-		return (left.First() > right.First()) && (left.Second() > right.Second());
+		return (left.First() < right.First()) || (!(right.First() < left.First()) && (left.Second() < right.Second()));
 	}
 
 	template <class T1, class T2>
-	bool operator < (const Pair<T1, T2>& left, const Pair<T1, T2>& right)
+	bool operator > (const Pair<T1, T2>& left, const Pair<T1, T2>& right)
 	{
-		return (right > left);
+		return (right < left);
 	}
 
 	template <class T1, class T2>
@@ -0,0 +1,119 @@
+#include "PoolAllocator.hpp"
+#include "MemoryUtility.hpp"
+#include <cstdlib> // malloc(), free()
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	PoolAllocator::PoolAllocator()
+		: Allocator(), mRawBuffer(nullptr), mMemoryBuffer(nullptr), mChunkSize(0), mFreeList(nullptr)
+	{}
+
+	PoolAllocator::PoolAllocator(const std::size_t totalSize, const std::size_t chunkSize)
+		: Allocator(totalSize), mRawBuffer(nullptr), mMemoryBuffer(nullptr), mChunkSize(chunkSize), mFreeList(nullptr)
+	{
+		// every chunk has to be able to hold the free list link
+		assert(chunkSize >= sizeof(FreeChunk) && "Chunk size is too small");
+		assert(totalSize % chunkSize == 0 && "Total size must be a multiple of chunk size");
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		if (mRawBuffer)
+		{
+			free(mRawBuffer);
+		}
+		mRawBuffer = nullptr;
+		mMemoryBuffer = nullptr;
+		mFreeList = nullptr;
+	}
+
+	void PoolAllocator::Init()
+	{
+		if (mRawBuffer)
+		{
+			free(mRawBuffer);
+		}
+
+		// malloc() gives only max_align_t alignment, the extra bytes let the first chunk start aligned
+		const std::size_t alignment = ChunkAlignment();
+		mRawBuffer = malloc(mTotalSize + alignment - 1);
+		mMemoryBuffer = (void*)((std::size_t)mRawBuffer + CalculateMemoryPadding((std::size_t)mRawBuffer, alignment));
+
+		Reset();
+	}
+
+	void PoolAllocator::Reset()
+	{
+		mUsed = 0;
+		mPeak = 0;
+		mFreeList = nullptr;
+
+		if (nullptr == mMemoryBuffer)
+		{
+			return;
+		}
+
+		// link the chunks backwards so the first allocation gets the first chunk
+		const std::size_t chunkCount = mTotalSize / mChunkSize;
+		for (std::size_t i = chunkCount; i > 0; --i)
+		{
+			FreeChunk* chunk = (FreeChunk*)((std::size_t)mMemoryBuffer + (i - 1) * mChunkSize);
+			chunk->next = mFreeList;
+			mFreeList = chunk;
+		}
+	}
+
+	void* PoolAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0 && size <= mChunkSize && "Allocation size must fit in a chunk");
+
+		// every chunk starts at a multiple of the chunk size from the aligned buffer
+		assert((alignment == 0 || alignment <= ChunkAlignment()) && "Alignment not supported by the chunk size");
+
+		// no chunk left
+		if (nullptr == mFreeList)
+		{
+			return nullptr;
+		}
+
+		FreeChunk* chunk = mFreeList;
+		mFreeList = chunk->next;
+
+		mUsed += mChunkSize;
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)chunk;
+	}
+
+	void PoolAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		assert((std::size_t)ptr >= (std::size_t)mMemoryBuffer &&
+			(std::size_t)ptr < (std::size_t)mMemoryBuffer + mTotalSize && "Pointer not owned by this allocator");
+
+		FreeChunk* chunk = (FreeChunk*)ptr;
+		chunk->next = mFreeList;
+		mFreeList = chunk;
+
+		mUsed -= mChunkSize;
+	}
+
+	std::size_t PoolAllocator::ChunkSize() const
+	{
+		return mChunkSize;
+	}
+
+	std::size_t PoolAllocator::ChunkAlignment() const
+	{
+		// the lowest set bit of the chunk size
+		const std::size_t alignment = mChunkSize & (~mChunkSize + 1);
+
+		return (alignment < MAX_CHUNK_ALIGNMENT) ? alignment : MAX_CHUNK_ALIGNMENT;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+
+/*
+PoolAllocator - splits the buffer into chunks of the same size.
+The free chunks are linked together through their own memory (embedded free list),
+so no per-block header is needed.
+
+TIME COMPLEXITY:
+- Allocate = O(1) - pop the head of the free list
+- Free = O(1) - push the chunk back as the head of the free list
+- Reset = O(n) - the free list is rebuilt
+
+The chunks are aligned to ChunkAlignment(): the biggest power of two dividing the chunk size,
+at most MAX_CHUNK_ALIGNMENT (a 64 byte chunk is 64 byte aligned, a 48 byte chunk 16 byte aligned).
+
+USAGES:
+- lots of objects of the same size allocated and freed in any order
+e.g. particles, nodes of lists/trees, network messages
+*/
+
+namespace SDA
+{
+	class PoolAllocator : public Allocator
+	{
+	public:
+		PoolAllocator();
+		PoolAllocator(const std::size_t totalSize, const std::size_t chunkSize);
+		virtual ~PoolAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		std::size_t ChunkSize() const;
+		// the biggest alignment Allocate() supports
+		std::size_t ChunkAlignment() const;
+
+		static const std::size_t MAX_CHUNK_ALIGNMENT = 4096;
+
+	private:
+		NON_COPY_AND_MOVE(PoolAllocator)
+
+		// a free chunk stores the address of the next free chunk
+		struct FreeChunk
+		{
+			FreeChunk* next;
+		};
+
+		void* mRawBuffer; // from malloc(), a bit bigger than mTotalSize so the chunks can be aligned
+		void* mMemoryBuffer; // mRawBuffer aligned to ChunkAlignment()
+		std::size_t mChunkSize;
+		FreeChunk* mFreeList;
+	};
+}
+
+#endif /* POOL_ALLOCATOR_HPP */
\ No newline at end of file
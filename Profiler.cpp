@@ -0,0 +1,310 @@
+#include "Profiler.hpp"
+#include "Clock.hpp"
+#include <fstream>
+#include <iomanip>
+#include <algorithm> // min, max, sort
+#include <limits>
+#include <cassert>
+
+namespace SDA
+{
+	static_assert(0 == (Profiler::BUFFER_CAPACITY & (Profiler::BUFFER_CAPACITY - 1)), "The buffer capacity must be a power of 2");
+
+	namespace
+	{
+		std::string EscapeJSON(const char* text)
+		{
+			std::string escaped;
+			for (; *text; ++text)
+			{
+				if ('"' == *text || '\\' == *text)
+				{
+					escaped += '\\';
+				}
+				escaped += *text;
+			}
+
+			return escaped;
+		}
+	}
+
+	/////////// ZoneStats /////////////
+
+	ZoneStats::ZoneStats()
+		: name(), count(0), total(0), min(std::numeric_limits<std::uint64_t>::max()), max(0), histogram()
+	{}
+
+	/////////// ThreadBuffer /////////////
+
+	Profiler::ThreadBuffer::ThreadBuffer()
+		: head(0), tail(0), dropped(0), isUsed(true), threadId(0)
+	{}
+
+	// gives the buffer back when the thread exits
+	struct Profiler::ThreadBufferOwner
+	{
+		ThreadBufferOwner()
+			: buffer(nullptr)
+		{}
+
+		~ThreadBufferOwner()
+		{
+			if (buffer)
+			{
+				buffer->isUsed.store(false, std::memory_order_release);
+			}
+		}
+
+		ThreadBuffer* buffer;
+	};
+
+	/////////// Profiler /////////////
+
+	Profiler::Profiler()
+		: mIsEnabled(true), mEpoch(Now()), mBuffersMutex(), mBuffers(), mNextThreadId(0)
+		, mCollectMutex(), mStats(), mStatsByName(), mTraceEvents(), mDropped(0)
+	{}
+
+	Profiler::~Profiler()
+	{}
+
+	Profiler& Profiler::GetInstance()
+	{
+		static Profiler mInstance;
+
+		return mInstance;
+	}
+
+	std::uint64_t Profiler::Now()
+	{
+		return TscClock::Now();
+	}
+
+	void Profiler::Record(const char* name, const std::uint64_t start, const std::uint64_t end)
+	{
+		if (false == mIsEnabled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		static thread_local ThreadBufferOwner owner;
+		if (nullptr == owner.buffer)
+		{
+			owner.buffer = AcquireBuffer();
+		}
+
+		ThreadBuffer* buffer = owner.buffer;
+
+		// only this thread writes head, Collect() moves tail forward
+		const std::uint64_t head = buffer->head.load(std::memory_order_relaxed);
+		const std::uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+		if (head - tail >= BUFFER_CAPACITY)
+		{
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		ZoneEvent& event = buffer->events[head & (BUFFER_CAPACITY - 1)];
+		event.name = name;
+		event.start = start;
+		event.end = end;
+
+		// publish the event to Collect()
+		buffer->head.store(head + 1, std::memory_order_release);
+	}
+
+	void Profiler::Collect()
+	{
+		std::lock_guard<std::mutex> collectLock(mCollectMutex);
+
+		// new buffers are only added, the pointers stay valid
+		std::vector<ThreadBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> buffersLock(mBuffersMutex);
+			for (const auto& buffer : mBuffers)
+			{
+				buffers.push_back(buffer.get());
+			}
+		}
+
+		for (ThreadBuffer* buffer : buffers)
+		{
+			const std::uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+			const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+
+			for (std::uint64_t index = tail; index != head; ++index)
+			{
+				const ZoneEvent& event = buffer->events[index & (BUFFER_CAPACITY - 1)];
+				const std::uint64_t duration = (event.end > event.start) ? event.end - event.start : 0;
+
+				ZoneStats& stats = FindStats(event.name);
+				++stats.count;
+				stats.total += duration;
+				stats.min = std::min(stats.min, duration);
+				stats.max = std::max(stats.max, duration);
+				stats.histogram.Record(duration);
+
+				if (mTraceEvents.size() < MAX_TRACE_EVENT_COUNT)
+				{
+					TraceEvent traceEvent;
+					traceEvent.name = event.name;
+					traceEvent.start = event.start;
+					traceEvent.end = event.end;
+					traceEvent.threadId = buffer->threadId.load(std::memory_order_relaxed);
+					mTraceEvents.push_back(traceEvent);
+				}
+				else
+				{
+					++mDropped;
+				}
+			}
+
+			// the slots can be written again
+			buffer->tail.store(head, std::memory_order_release);
+
+			mDropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+		}
+	}
+
+	void Profiler::Reset()
+	{
+		std::lock_guard<std::mutex> collectLock(mCollectMutex);
+
+		mStats.clear();
+		mStatsByName.clear();
+		mTraceEvents.clear();
+		mDropped = 0;
+	}
+
+	void Profiler::SetEnabled(const bool isEnabled)
+	{
+		mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+	}
+
+	bool Profiler::IsEnabled() const
+	{
+		return mIsEnabled.load(std::memory_order_relaxed);
+	}
+
+	std::map<std::string, ZoneStats> Profiler::Stats() const
+	{
+		std::lock_guard<std::mutex> collectLock(mCollectMutex);
+
+		return mStats;
+	}
+
+	std::uint64_t Profiler::DroppedCount() const
+	{
+		std::lock_guard<std::mutex> collectLock(mCollectMutex);
+
+		return mDropped;
+	}
+
+	void Profiler::WriteStats(std::ostream& out) const
+	{
+		// Collect() may run on another thread
+		std::lock_guard<std::mutex> collectLock(mCollectMutex);
+
+		out << std::left << std::setw(32) << "Zone" << std::right
+			<< std::setw(12) << "Count"
+			<< std::setw(16) << "Total(ns)"
+			<< std::setw(12) << "Mean(ns)"
+			<< std::setw(12) << "Min(ns)"
+			<< std::setw(12) << "p50(ns)"
+			<< std::setw(12) << "p99(ns)"
+			<< std::setw(12) << "Max(ns)" << std::endl;
+
+		for (const auto& zone : mStats)
+		{
+			const ZoneStats& stats = zone.second;
+
+			out << std::left << std::setw(32) << stats.name << std::right
+				<< std::setw(12) << stats.count
+				<< std::setw(16) << stats.total
+				<< std::setw(12) << (std::uint64_t)stats.histogram.Mean()
+				<< std::setw(12) << stats.min
+				<< std::setw(12) << stats.histogram.Percentile(0.5)
+				<< std::setw(12) << stats.histogram.Percentile(0.99)
+				<< std::setw(12) << stats.max << std::endl;
+		}
+
+		if (mDropped > 0)
+		{
+			out << "Dropped zones: " << mDropped << std::endl;
+		}
+	}
+
+	void Profiler::WriteTrace(std::ostream& out) const
+	{
+		std::lock_guard<std::mutex> collectLock(mCollectMutex);
+
+		// Chrome trace event format, complete events ("X"), microseconds
+		const std::ios::fmtflags flags = out.flags();
+		out << std::fixed << std::setprecision(3);
+
+		out << "{\"traceEvents\":[" << std::endl;
+		for (std::size_t index = 0; index < mTraceEvents.size(); ++index)
+		{
+			const TraceEvent& event = mTraceEvents[index];
+			const std::uint64_t start = (event.start > mEpoch) ? event.start - mEpoch : 0;
+			const std::uint64_t duration = (event.end > event.start) ? event.end - event.start : 0;
+
+			out << "{\"name\":\"" << EscapeJSON(event.name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.threadId
+				<< ",\"ts\":" << start / 1000.0 << ",\"dur\":" << duration / 1000.0 << "}"
+				<< ((index + 1 < mTraceEvents.size()) ? "," : "") << std::endl;
+		}
+		out << "],\"displayTimeUnit\":\"ns\"}" << std::endl;
+
+		out.flags(flags);
+	}
+
+	bool Profiler::SaveTrace(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (false == file.is_open())
+		{
+			return false;
+		}
+
+		WriteTrace(file);
+
+		return file.good();
+	}
+
+	Profiler::ThreadBuffer* Profiler::AcquireBuffer()
+	{
+		std::lock_guard<std::mutex> lock(mBuffersMutex);
+
+		// reuse the buffer of a thread that exited
+		for (const auto& buffer : mBuffers)
+		{
+			bool isUsed = false;
+			if (buffer->isUsed.compare_exchange_strong(isUsed, true, std::memory_order_acquire))
+			{
+				buffer->threadId.store(mNextThreadId++, std::memory_order_relaxed);
+				return buffer.get();
+			}
+		}
+
+		mBuffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+		mBuffers.back()->threadId.store(mNextThreadId++, std::memory_order_relaxed);
+
+		return mBuffers.back().get();
+	}
+
+	ZoneStats& Profiler::FindStats(const char* name)
+	{
+		// fast path, the zone was already seen at this address
+		auto found = mStatsByName.find(name);
+		if (found != mStatsByName.end())
+		{
+			return *found->second;
+		}
+
+		ZoneStats& stats = mStats[name];
+		stats.name = name;
+		mStatsByName[name] = &stats;
+
+		return stats;
+	}
+}
@@ -0,0 +1,176 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "ClassHelper.h"
+#include "LatencyHistogram.hpp"
+#include <cstddef> // size_t
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <iostream>
+
+/*
+Profiler - low overhead instrumentation for hot paths.
+
+ScopedZone measures the lifetime of a scope (RAII), the name must be a static string
+(only the pointer is kept). Every thread records its zones in its own ring buffer
+(single producer, single consumer, lock-free), so recording takes no lock and never allocates.
+When a buffer is full the zone is dropped and counted in DroppedCount().
+
+Collect() drains the buffers, it can be called from any thread (e.g. once per frame)
+and aggregates per zone: count, total, min, max and a LatencyHistogram.
+The drained zones are also kept (up to MAX_TRACE_EVENT_COUNT) to be saved as a
+Chrome trace (chrome://tracing, Perfetto).
+
+The timestamps are nanoseconds of TscClock (steady_clock if the TSC can't be used).
+
+SDA_PROFILE_ZONE(name) compiles to nothing unless SDA_PROFILING is defined,
+so the containers can be instrumented without any cost in the normal builds.
+
+TIME COMPLEXITY:
+- ScopedZone = O(1)
+- Collect = O(zones recorded since the last Collect)
+
+USAGES:
+	{
+		SDA_PROFILE_ZONE("Vector::Reserve");
+		...
+	}
+	SDA::Profiler::GetInstance().Collect();
+	SDA::Profiler::GetInstance().WriteStats(std::cout);
+	SDA::Profiler::GetInstance().SaveTrace("trace.json");
+*/
+
+namespace SDA
+{
+	struct ZoneEvent
+	{
+		const char* name;
+		std::uint64_t start;
+		std::uint64_t end;
+	};
+
+	struct ZoneStats
+	{
+		ZoneStats();
+
+		std::string name;
+		std::uint64_t count;
+		std::uint64_t total;
+		std::uint64_t min;
+		std::uint64_t max;
+		LatencyHistogram histogram;
+	};
+
+	class Profiler
+	{
+	public:
+		static Profiler& GetInstance();
+
+		// nanoseconds
+		static std::uint64_t Now();
+
+		// called by ScopedZone, records on the buffer of the calling thread
+		void Record(const char* name, const std::uint64_t start, const std::uint64_t end);
+
+		void Collect();
+		void Reset();
+
+		void SetEnabled(const bool isEnabled);
+		bool IsEnabled() const;
+
+		// by name, filled by Collect(), a copy taken under the lock
+		std::map<std::string, ZoneStats> Stats() const;
+		std::uint64_t DroppedCount() const;
+
+		void WriteStats(std::ostream& out) const;
+		void WriteTrace(std::ostream& out) const;
+		bool SaveTrace(const std::string& path) const;
+
+		static const std::size_t BUFFER_CAPACITY = 1 << 15; // zones per thread, power of 2
+		static const std::size_t MAX_TRACE_EVENT_COUNT = 1 << 20;
+
+	private:
+		Profiler();
+		virtual ~Profiler();
+		NON_COPY_AND_MOVE(Profiler)
+
+		struct ThreadBuffer
+		{
+			ThreadBuffer();
+
+			// head is written only by the owner thread, tail only by Collect()
+			alignas(64) std::atomic<std::uint64_t> head;
+			alignas(64) std::atomic<std::uint64_t> tail;
+			std::atomic<std::uint64_t> dropped;
+			std::atomic<bool> isUsed; // a thread owns it, released when the thread exits
+			std::atomic<std::uint32_t> threadId; // changes when the buffer is reused
+			ZoneEvent events[BUFFER_CAPACITY];
+		};
+
+		struct TraceEvent
+		{
+			const char* name;
+			std::uint64_t start;
+			std::uint64_t end;
+			std::uint32_t threadId;
+		};
+
+		struct ThreadBufferOwner;
+
+		ThreadBuffer* AcquireBuffer();
+		ZoneStats& FindStats(const char* name);
+
+		std::atomic<bool> mIsEnabled;
+		std::uint64_t mEpoch; // Now() when the profiler was created, the trace starts here
+
+		// the buffers live as long as the profiler, they are reused by new threads
+		std::mutex mBuffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+		std::uint32_t mNextThreadId;
+
+		// filled by Collect()
+		mutable std::mutex mCollectMutex;
+		std::map<std::string, ZoneStats> mStats;
+		std::unordered_map<const char*, ZoneStats*> mStatsByName; // the same string can have many addresses
+		std::vector<TraceEvent> mTraceEvents;
+		std::uint64_t mDropped;
+	};
+
+	class ScopedZone
+	{
+	public:
+		// the profiler is created before the first timestamp is taken
+		explicit ScopedZone(const char* name)
+			: mProfiler(Profiler::GetInstance()), mName(name), mStart(Profiler::Now())
+		{}
+
+		~ScopedZone()
+		{
+			mProfiler.Record(mName, mStart, Profiler::Now());
+		}
+
+	private:
+		NON_COPY_AND_MOVE(ScopedZone)
+
+		Profiler& mProfiler;
+		const char* mName;
+		std::uint64_t mStart;
+	};
+}
+
+#define SDA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SDA_PROFILE_CONCAT(a, b) SDA_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef SDA_PROFILING
+#define SDA_PROFILE_ZONE(name) SDA::ScopedZone SDA_PROFILE_CONCAT(sdaProfileZone, __LINE__)(name)
+#else
+#define SDA_PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif /* PROFILER_HPP */
\ No newline at end of file
@@ -7,8 +7,22 @@
 #include <thread>
 
 #include "Timer.hpp"
+#include "TimerWheel.hpp"
 #include "LiniarAllocator.hpp"
+#include "ChainedLiniarAllocator.hpp"
+#include "PoolAllocator.hpp"
+#include "StackAllocator.hpp"
+#include "FreeListAllocator.hpp"
+#include "BuddyAllocator.hpp"
+#include "LockedAllocator.hpp"
+#include "ThreadCacheAllocator.hpp"
+#include "LockFreePoolAllocator.hpp"
+#include "CAllocator.hpp"
+#include "MemoryResource.hpp"
+#include "CheckedAllocator.hpp"
 #include "MemoryBenchmark.hpp"
+#include "AllocationTrace.hpp"
+#include "Profiler.hpp"
 #include "RefCountedPtr.hpp"
 #include "Singleton.hpp"
 #include "Pair.hpp"
@@ -21,8 +35,12 @@
 
 #include "Sort.hpp"
 #include "Search.hpp"
+#include "Benchmark.hpp"
 
+// the demos below are off by default, the registered benchmarks (ContainerBenchmarks.cpp) always run
 //#define TEST_TIMER
+//#define TEST_TIMER_WHEEL
+//#define TEST_PROFILER
 //#define TEST_CUSTOM_ALLOCATORS
 //#define TEST_SMART_PTR
 //#define TEST_SINGLETON
@@ -94,7 +112,7 @@ private:
 	std::string mName;
 };
 
-int main()
+int main(int argc, char** argv)
 {
 
 #ifdef TEST_TIMER
@@ -121,16 +139,284 @@ int main()
 
 	timer2.Restart();
 
+	// the TSC is cheaper to read than high_resolution_clock
+	std::cout << "TSC available: " << SDA::TscClock::IsAvailable() << ", frequency: " << SDA::TscClock::Frequency() << std::endl;
+
+	SDA::Timer timer5;
+	timer5.SetClockSource(SDA::CLOCK_TSC);
+	timer5.Start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+	timer5.Stop();
+	std::cout << "Elapsed time nano (TSC): " << timer5.ElapsedTimeInNanoseconds() << std::endl;
+
 #endif // TEST_TIMER
 
+#ifdef TEST_TIMER_WHEEL
+	{
+		// timers sharing one service thread
+		SDA::TimerWheel wheel;
+		wheel.Start();
+
+		SDA::Timer timer3(wheel, []() { std::cout << "Wheel timeout! " << std::endl; }, true, 500);
+		SDA::Timer timer4(wheel, []() { std::cout << "Wheel single timeout! " << std::endl; }, false, 1200);
+		timer3.Start();
+		timer4.Start();
+		std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+		timer3.Stop();
+
+		wheel.Stop();
+	}
+
+	{
+		// 1M timers on a manually advanced wheel
+		const std::size_t timerCount = 1000000;
+		SDA::TimerWheel wheel;
+
+		std::vector<SDA::TimerWheel::TimerId> ids(timerCount);
+		std::vector<SDA::Timer::long_t> delays(timerCount);
+		for (std::size_t i = 0; i < timerCount; ++i)
+		{
+			delays[i] = 1 + rand() % 60000;
+		}
+
+		std::size_t fired = 0;
+		SDA::Timer timer;
+
+		timer.Start();
+		for (std::size_t i = 0; i < timerCount; ++i)
+		{
+			ids[i] = wheel.Schedule(delays[i], [&fired]() { ++fired; });
+		}
+		timer.Stop();
+		std::cout << "Schedule: " << timer.ElapsedTimeInNanoseconds() / timerCount << " ns/timer" << std::endl;
+
+		timer.Start();
+		for (std::size_t i = 0; i < timerCount; i += 2)
+		{
+			wheel.Cancel(ids[i]);
+		}
+		timer.Stop();
+		std::cout << "Cancel: " << timer.ElapsedTimeInNanoseconds() / (timerCount / 2) << " ns/timer" << std::endl;
+
+		timer.Start();
+		wheel.Advance(60001);
+		timer.Stop();
+		std::cout << "Advance: " << timer.ElapsedTimeInNanoseconds() / fired << " ns/timer, fired " << fired << std::endl;
+	}
+#endif // TEST_TIMER_WHEEL
+
+#ifdef TEST_PROFILER
+	{
+		// the Vector zones show up only when SDA_PROFILING is defined
+		auto work = []()
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				SDA::ScopedZone zone("PushBack1000");
+
+				SDA::Vector<int> vec;
+				for (int j = 0; j < 1000; ++j)
+				{
+					vec.PushBack(j);
+				}
+			}
+		};
+
+		std::thread thread1(work);
+		std::thread thread2(work);
+		{
+			SDA::ScopedZone zone("Main");
+			work();
+		}
+		thread1.join();
+		thread2.join();
+
+		SDA::Profiler& profiler = SDA::Profiler::GetInstance();
+		profiler.Collect();
+		profiler.WriteStats(std::cout);
+		profiler.SaveTrace("profile_trace.json");
+	}
+#endif // TEST_PROFILER
+
 #ifdef TEST_CUSTOM_ALLOCATORS
 	SDA::Allocator* allocator = new SDA::LiniarAllocator(1e9);
 
 	SDA::MemoryBenchmark benchmark(1e1);
+	benchmark.SetClockSource(SDA::CLOCK_TSC);
 
-	std::cout << "LINEAR ALLOCATOR" << std::endl;
+	benchmark.SetName("LINEAR ALLOCATOR");
 	benchmark.SingleAllocation(allocator, 4096, 8);
-	//benchmark.SingleFree(allocator, 4096, 8);
+	benchmark.SingleFree(allocator, 4096, 8);
+
+	SDA::VirtualMemoryOptions virtualMemoryOptions;
+	virtualMemoryOptions.useHugePages = true;
+	virtualMemoryOptions.releaseOnReset = true;
+	SDA::Allocator* virtualMemoryAllocator = new SDA::LiniarAllocator(1e9, virtualMemoryOptions);
+
+	benchmark.SetName("LINEAR ALLOCATOR - VIRTUAL MEMORY");
+	benchmark.SingleAllocation(virtualMemoryAllocator, 4096, 8);
+	virtualMemoryAllocator->Reset();
+
+	SDA::Allocator* chainedAllocator = new SDA::ChainedLiniarAllocator(1 << 20);
+
+	benchmark.SetName("CHAINED LINEAR ALLOCATOR");
+	benchmark.SingleAllocation(chainedAllocator, 4096, 8);
+
+	SDA::Allocator* poolAllocator = new SDA::PoolAllocator(4096 * 1e3, 4096);
+	SDA::Allocator* cAllocator = new SDA::CAllocator();
+
+	benchmark.SetName("POOL ALLOCATOR");
+	benchmark.SingleAllocation(poolAllocator, 4096, 8);
+	benchmark.AllocationAndFree(poolAllocator, 4096, 8);
+
+	SDA::StackAllocator* stackAllocator = new SDA::StackAllocator(1e9);
+
+	benchmark.SetName("STACK ALLOCATOR");
+	benchmark.SingleAllocation(stackAllocator, 4096, 8);
+
+	// nested scope rolled back with a marker
+	const SDA::StackAllocator::Marker marker = stackAllocator->GetMarker();
+	void* scratch1 = stackAllocator->Allocate(128, 16);
+	void* scratch2 = stackAllocator->Allocate(256, 16);
+	stackAllocator->Free(scratch2);
+	stackAllocator->FreeToMarker(marker);
+	std::cout << "stack used after rollback: " << stackAllocator->Used() << std::endl;
+
+	// the rolled back memory is handed out again
+	void* scratch3 = stackAllocator->Allocate(128, 16);
+	std::cout << "scratch reused after rollback: " << ((scratch3 == scratch1) ? "yes" : "no") << std::endl;
+	stackAllocator->FreeToMarker(marker);
+
+	SDA::Allocator* freeListFirstAllocator = new SDA::FreeListAllocator(1e9, SDA::FreeListAllocator::FIND_FIRST);
+	SDA::Allocator* freeListBestAllocator = new SDA::FreeListAllocator(1e9, SDA::FreeListAllocator::FIND_BEST);
+
+	benchmark.SetName("FREE LIST ALLOCATOR - FIND FIRST");
+	benchmark.SingleAllocation(freeListFirstAllocator, 4096, 8);
+	benchmark.RandomAllocationAndFree(freeListFirstAllocator, 16, 4096, 8);
+
+	benchmark.SetName("FREE LIST ALLOCATOR - FIND BEST");
+	benchmark.SingleAllocation(freeListBestAllocator, 4096, 8);
+	benchmark.RandomAllocationAndFree(freeListBestAllocator, 16, 4096, 8);
+
+	SDA::Allocator* buddyAllocator = new SDA::BuddyAllocator(1 << 30);
+
+	benchmark.SetName("BUDDY ALLOCATOR");
+	benchmark.SingleAllocation(buddyAllocator, 4096, 8);
+	benchmark.RandomAllocationAndFree(buddyAllocator, 16, 4096, 8);
+	benchmark.DoublingGrowth(buddyAllocator, 16, 1 << 20, 8);
+
+	benchmark.SetName("FREE LIST ALLOCATOR - DOUBLING GROWTH");
+	benchmark.DoublingGrowth(freeListFirstAllocator, 16, 1 << 20, 8);
+
+	benchmark.SetName("C ALLOCATOR");
+	benchmark.AllocationAndFree(cAllocator, 4096, 8);
+	benchmark.RandomAllocationAndFree(cAllocator, 16, 4096, 8);
+	benchmark.DoublingGrowth(cAllocator, 16, 1 << 20, 8);
+
+	// record a workload once, replay it against every allocator
+	SDA::AllocationTrace trace;
+	{
+		SDA::TracingAllocator tracingAllocator(*cAllocator, trace);
+		benchmark.RandomAllocationAndFree(&tracingAllocator, 16, 4096, 8);
+	}
+	trace.Save("random.trace");
+
+	SDA::AllocationTrace loadedTrace;
+	if (loadedTrace.Load("random.trace"))
+	{
+		benchmark.SetName("REPLAY - FREE LIST ALLOCATOR - FIND FIRST");
+		benchmark.Replay(freeListFirstAllocator, loadedTrace);
+
+		benchmark.SetName("REPLAY - FREE LIST ALLOCATOR - FIND BEST");
+		benchmark.Replay(freeListBestAllocator, loadedTrace);
+
+		benchmark.SetName("REPLAY - BUDDY ALLOCATOR");
+		benchmark.Replay(buddyAllocator, loadedTrace);
+
+		benchmark.SetName("REPLAY - C ALLOCATOR");
+		benchmark.Replay(cAllocator, loadedTrace);
+	}
+
+	// multi threaded: the same central pool, locked on every call vs thread caches
+	SDA::PoolAllocator centralPoolAllocator(256 * 1e5, 256);
+	SDA::Allocator* lockedAllocator = new SDA::LockedAllocator(centralPoolAllocator);
+	SDA::Allocator* threadCacheAllocator = new SDA::ThreadCacheAllocator(centralPoolAllocator);
+	const std::size_t maxThreadCount = std::thread::hardware_concurrency();
+
+	benchmark.SetName("LOCKED POOL ALLOCATOR - MULTI THREADED");
+	benchmark.MultiThreadedAllocationAndFree(lockedAllocator, 64, 8, maxThreadCount);
+
+	benchmark.SetName("THREAD CACHE ALLOCATOR - MULTI THREADED");
+	benchmark.MultiThreadedAllocationAndFree(threadCacheAllocator, 64, 8, maxThreadCount);
+
+	// contention: mutex guarded pool vs lock free pool
+	SDA::Allocator* lockFreePoolAllocator = new SDA::LockFreePoolAllocator(256 * 1e5, 256);
+	const std::size_t contentionThreadCount = 16;
+
+	benchmark.SetName("LOCKED POOL ALLOCATOR - CONTENTION");
+	benchmark.MultiThreadedAllocationAndFree(lockedAllocator, 64, 8, contentionThreadCount);
+	benchmark.ProducerConsumer(lockedAllocator, 64, 8, contentionThreadCount);
+
+	benchmark.SetName("LOCK FREE POOL ALLOCATOR - CONTENTION");
+	benchmark.MultiThreadedAllocationAndFree(lockFreePoolAllocator, 64, 8, contentionThreadCount);
+	benchmark.ProducerConsumer(lockFreePoolAllocator, 64, 8, contentionThreadCount);
+
+	// machine readable results, to compare between builds
+	benchmark.SaveResults("allocators.json", SDA::MemoryBenchmark::OUTPUT_JSON);
+	benchmark.SaveResults("allocators.csv", SDA::MemoryBenchmark::OUTPUT_CSV);
+
+	// containers on an arena: no Free() per element, everything is dropped by Reset()
+	std::cout << "VECTOR - CHAINED LINEAR ALLOCATOR" << std::endl;
+	chainedAllocator->Init();
+	{
+		SDA::Vector<int> arenaVector(chainedAllocator);
+		for (int i = 0; i < 1e6; ++i)
+		{
+			arenaVector.PushBack(i);
+		}
+		std::cout << "arena used: " << chainedAllocator->Used() << " blocks: " << ((SDA::ChainedLiniarAllocator*)chainedAllocator)->BlockCount() << std::endl;
+	}
+	chainedAllocator->Reset();
+
+	// std::pmr containers on the same arena, counted in the same Peak()
+	std::cout << "STD PMR VECTOR - CHAINED LINEAR ALLOCATOR" << std::endl;
+	{
+		SDA::AllocatorMemoryResource arenaResource(*chainedAllocator);
+		std::pmr::vector<int> pmrVector(&arenaResource);
+		for (int i = 0; i < 1e6; ++i)
+		{
+			pmrVector.push_back(i);
+		}
+		std::cout << "arena used: " << chainedAllocator->Used() << " peak: " << chainedAllocator->Peak() << std::endl;
+	}
+	chainedAllocator->Reset();
+
+	// red zones and poisoning when SDA_ALLOCATOR_CHECKS is defined, the plain allocator otherwise
+	std::cout << "VECTOR - DEBUG FREE LIST ALLOCATOR" << std::endl;
+	{
+		SDA::DebugAllocator debugAllocator(*freeListFirstAllocator);
+		debugAllocator.Get().Init();
+
+		SDA::Vector<int> checkedVector(&debugAllocator.Get());
+		for (int i = 0; i < 1e5; ++i)
+		{
+			checkedVector.PushBack(i);
+		}
+	}
+
+	delete lockFreePoolAllocator;
+	delete lockedAllocator;
+	delete threadCacheAllocator;
+
+	delete allocator;
+	delete virtualMemoryAllocator;
+	delete chainedAllocator;
+	delete poolAllocator;
+	delete stackAllocator;
+	delete freeListFirstAllocator;
+	delete freeListBestAllocator;
+	delete buddyAllocator;
+	delete cAllocator;
 
 #endif // TEST_CUSTOM_ALLOCATORS
 
@@ -518,7 +804,7 @@ int main()
 	vec1.PushBack(4);
 	vec1.PushBack(3);
 
-	SDA::BubbleSort<int>(vec1, SDA::Less<int>());
+	SDA::BubbleSort(vec1, SDA::Less());
 
 	std::cout << "sorted:" << std::endl;
 	std::cout << vec1;
@@ -528,6 +814,7 @@ int main()
 	std::cout << "found1: " << pos << std::endl;
 #endif // TEST_SEARCH
 
+	return SDA::RunBenchmarks(argc, argv);
 }
 
 /*
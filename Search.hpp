@@ -11,6 +11,7 @@ namespace SDA
 
 	/* NOTE! Container must be sorted first in an increasing order! */
 
+	// returns the index of val in [startIdx, endIdx] or container.Size() when val is not found
 	template <class T>
 	size_t BinarySearch(const SDA::Vector<T>& container, const T& val, size_t startIdx, size_t endIdx)
 	{
@@ -19,7 +20,13 @@ namespace SDA
 		assert(container.Size() >= 2);
 		assert(container[1] > container[0]);
 
-		size_t halfIdx = (endIdx - startIdx + 1) / 2;
+		if (startIdx > endIdx)
+		{
+			return container.Size();
+		}
+
+		// (startIdx + endIdx) / 2 could overflow
+		size_t halfIdx = startIdx + (endIdx - startIdx) / 2;
 
 		if (container[halfIdx] == val)
 		{
@@ -27,11 +34,19 @@ namespace SDA
 		}
 		else if (val < container[halfIdx])
 		{
-			return BinarySearch(container, val, startIdx, halfIdx);
+			if (halfIdx == startIdx)
+			{
+				return container.Size();
+			}
+			return BinarySearch(container, val, startIdx, halfIdx - 1);
 		}
-		else if (val > container[halfIdx])
+		else
 		{
-			return BinarySearch(container, val, halfIdx, endIdx);
+			if (halfIdx == endIdx)
+			{
+				return container.Size();
+			}
+			return BinarySearch(container, val, halfIdx + 1, endIdx);
 		}
 	}
 }
@@ -0,0 +1,491 @@
+#ifndef SEGMENTED_VECTOR_HPP
+#define SEGMENTED_VECTOR_HPP
+
+#include "Vector.hpp"
+#include "AllocatorUtility.hpp"
+#include <cstddef> // size_t
+#include <cstring> // memcpy()
+#include <utility> // std::move(), std::forward()
+#include <type_traits>
+#include <cassert>
+#include <iostream>
+
+/*
+SegmentedVector - a vector made of fixed size chunks of 2^CHUNK_SHIFT elements.
+A new chunk is added when the last one is full, the elements are never moved,
+so their addresses stay valid until they are removed.
+The element i is in the chunk i >> CHUNK_SHIFT at the position i & (CHUNK_SIZE - 1).
+
+TIME COMPLEXITY:
+- PushBack = O(1) at worst: one chunk allocation, no element is relocated
+(the table of chunk pointers is a Vector<T*> CHUNK_SIZE times smaller than the elements,
+it grows with realloc(), Reserve() allocates it and the chunks up front)
+- Index an element = O(1), a shift, a mask and one more indirection than Vector
+- Traversal = O(n), ForEachChunk()/ForEach() go chunk by chunk over contiguous memory
+
+SPACE COMPLEXITY:
+- O(N), at most one partially used chunk (Vector wastes up to half of its capacity)
+
+ADVANTAGES:
+ - no latency spike when growing, a huge vector never copies its elements
+ - pointers and references to the elements stay valid while it grows
+ - the memory is requested in equal blocks, good for pool allocators and fragmentation
+
+DISADVANTAGES:
+ - the elements aren't contiguous as a whole, no GetData()
+ - indexing is a bit slower than Vector (the chunk lookup)
+ - insertion/deletion in the middle isn't supported
+
+USAGES:
+ - big append only buffers filled while others read them
+ e.g. ingestion of a stream, logs, the nodes of a graph referenced by pointers
+
+*/
+
+namespace SDA
+{
+	/* SegmentedVector container - dynamic size, chunks of 2^CHUNK_SHIFT elements */
+	template <class T, size_t CHUNK_SHIFT = 10>
+	class SegmentedVector
+	{
+	public:
+		static const size_t CHUNK_SIZE = (size_t)1 << CHUNK_SHIFT;
+
+		// nullptr allocator means the global heap, the chunks and their table are allocated with it
+		SegmentedVector(Allocator* allocator = nullptr);
+		SegmentedVector(size_t size, const T& val, Allocator* allocator = nullptr);
+		SegmentedVector(const SegmentedVector<T, CHUNK_SHIFT>& vec);
+		SegmentedVector(SegmentedVector<T, CHUNK_SHIFT>&& vec) noexcept;
+		virtual ~SegmentedVector();
+
+		SegmentedVector<T, CHUNK_SHIFT>& operator =(const SegmentedVector<T, CHUNK_SHIFT>& vec);
+		SegmentedVector<T, CHUNK_SHIFT>& operator =(SegmentedVector<T, CHUNK_SHIFT>&& vec) noexcept;
+
+		T& operator [](size_t index);
+		const T& operator [](size_t index) const;
+		T& At(size_t index);
+		const T& At(size_t index) const;
+
+		T& Front();
+		const T& Front() const;
+		T& Back();
+		const T& Back() const;
+
+		bool IsEmpty() const;
+
+		size_t Capacity() const;
+		size_t Size() const;
+		size_t ChunkCount() const;
+
+		void PushBack(const T& val);
+		void PushBack(T&& val);
+		// constructs the element from args at the end, args may refer to an element of this vector
+		template <class... Args>
+		T& EmplaceBack(Args&&... args);
+		// the element is destroyed, its chunk is kept for the next PushBack()
+		void PopBack();
+
+		// allocates the chunks up front, PushBack() won't allocate until capacity
+		void Reserve(size_t capacity);
+		void Resize(size_t size);
+
+		// func(T* elements, size_t count) is called for every chunk with elements, in order
+		template <class Func>
+		void ForEachChunk(Func func);
+		template <class Func>
+		void ForEachChunk(Func func) const;
+
+		// func(T& element) is called for every element, in order
+		template <class Func>
+		void ForEach(Func func);
+		template <class Func>
+		void ForEach(Func func) const;
+
+		Allocator* GetAllocator() const;
+
+	private:
+		void Copy(const SegmentedVector<T, CHUNK_SHIFT>& vec);
+		void Move(SegmentedVector<T, CHUNK_SHIFT>&& vec);
+		void Destroy();
+
+		void AddChunk();
+
+		Vector<T*> mChunks; // the chunks are raw memory, [0, mSize) are constructed
+		size_t mSize;
+
+		Allocator* mAllocator; // not owned
+
+		static const size_t CHUNK_MASK = CHUNK_SIZE - 1;
+		static constexpr bool IS_TRIVIALLY_COPYABLE = std::is_trivially_copyable<T>::value;
+	};
+}
+
+/* As we do use templates we have to provie the definition in the header */
+//////////////// IMPLEMENTATION ////////////
+
+namespace SDA
+{
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(Allocator* allocator)
+		: mChunks(allocator), mSize(0), mAllocator(allocator)
+	{}
+
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(size_t size, const T& val, Allocator* allocator)
+		: SegmentedVector(allocator)
+	{
+		Reserve(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			EmplaceBack(val);
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(const SegmentedVector<T, CHUNK_SHIFT>& vec)
+		: SegmentedVector(vec.mAllocator) // the copy uses the same allocator
+	{
+		Copy(vec);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>::SegmentedVector(SegmentedVector<T, CHUNK_SHIFT>&& vec) noexcept
+		: SegmentedVector(vec.mAllocator)
+	{
+		Move(std::move(vec));
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>::~SegmentedVector()
+	{
+		Destroy();
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::Copy(const SegmentedVector<T, CHUNK_SHIFT>& vec)
+	{
+		if (this != &vec)
+		{
+			// delete the old elements, the chunks are reused
+			Resize(0);
+
+			Reserve(vec.mSize);
+
+			// copy chunk by chunk
+			vec.ForEachChunk([this](const T* elements, size_t count)
+			{
+				T* chunk = mChunks[mSize >> CHUNK_SHIFT];
+
+				if constexpr (IS_TRIVIALLY_COPYABLE)
+				{
+					std::memcpy(chunk, elements, count * sizeof(T));
+					mSize += count;
+				}
+				else
+				{
+					for (size_t i = 0; i < count; ++i, ++mSize)
+					{
+						new (chunk + i) T(elements[i]);
+					}
+				}
+			});
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::Move(SegmentedVector<T, CHUNK_SHIFT>&& vec)
+	{
+		if (this != &vec)
+		{
+			// delete the old chunks
+			Destroy();
+
+			// just take the chunk table, the chunks are freed with the allocator of vec
+			mChunks = std::move(vec.mChunks);
+			mSize = vec.mSize;
+			mAllocator = vec.mAllocator;
+
+			// vec is invalidated after move
+			vec.mSize = 0;
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::Destroy()
+	{
+		Resize(0);
+
+		for (size_t i = 0; i < mChunks.Size(); ++i)
+		{
+			SDA::FreeArray(mAllocator, mChunks[i]);
+		}
+		mChunks.Resize(0);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::AddChunk()
+	{
+		T* chunk = SDA::AllocateArray<T>(mAllocator, CHUNK_SIZE);
+
+		try
+		{
+			mChunks.PushBack(chunk);
+		}
+		catch (...)
+		{
+			SDA::FreeArray(mAllocator, chunk);
+			throw;
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>& SegmentedVector<T, CHUNK_SHIFT>::operator =(const SegmentedVector<T, CHUNK_SHIFT>& vec)
+	{
+		Copy(vec);
+
+		return *this;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	SegmentedVector<T, CHUNK_SHIFT>& SegmentedVector<T, CHUNK_SHIFT>::operator =(SegmentedVector<T, CHUNK_SHIFT>&& vec) noexcept
+	{
+		Move(std::move(vec));
+
+		return *this;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	T& SegmentedVector<T, CHUNK_SHIFT>::operator [](size_t index)
+	{
+		assert(index < mSize);
+
+		return mChunks[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	const T& SegmentedVector<T, CHUNK_SHIFT>::operator [](size_t index) const
+	{
+		assert(index < mSize);
+
+		return mChunks[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	T& SegmentedVector<T, CHUNK_SHIFT>::At(size_t index)
+	{
+		return operator [](index);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	const T& SegmentedVector<T, CHUNK_SHIFT>::At(size_t index) const
+	{
+		return operator [](index);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	T& SegmentedVector<T, CHUNK_SHIFT>::Front()
+	{
+		assert(mSize > 0);
+
+		return mChunks[0][0];
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	const T& SegmentedVector<T, CHUNK_SHIFT>::Front() const
+	{
+		assert(mSize > 0);
+
+		return mChunks[0][0];
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	T& SegmentedVector<T, CHUNK_SHIFT>::Back()
+	{
+		assert(mSize > 0);
+
+		return operator [](mSize - 1);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	const T& SegmentedVector<T, CHUNK_SHIFT>::Back() const
+	{
+		assert(mSize > 0);
+
+		return operator [](mSize - 1);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	bool SegmentedVector<T, CHUNK_SHIFT>::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	size_t SegmentedVector<T, CHUNK_SHIFT>::Capacity() const
+	{
+		return mChunks.Size() << CHUNK_SHIFT;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	size_t SegmentedVector<T, CHUNK_SHIFT>::Size() const
+	{
+		return mSize;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	size_t SegmentedVector<T, CHUNK_SHIFT>::ChunkCount() const
+	{
+		return mChunks.Size();
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::PushBack(const T& val)
+	{
+		EmplaceBack(val);
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::PushBack(T&& val)
+	{
+		EmplaceBack(std::move(val));
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	template <class... Args>
+	T& SegmentedVector<T, CHUNK_SHIFT>::EmplaceBack(Args&&... args)
+	{
+		const size_t chunkIndex = mSize >> CHUNK_SHIFT;
+
+		// the last chunk is full, the elements stay where they are so args can't be invalidated
+		if (chunkIndex == mChunks.Size())
+		{
+			AddChunk();
+		}
+
+		T* element = mChunks[chunkIndex] + (mSize & CHUNK_MASK);
+		new (element) T(std::forward<Args>(args)...);
+		++mSize;
+
+		return *element;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::PopBack()
+	{
+		assert(mSize > 0);
+
+		// destroy the last element as it is removed
+		if constexpr (false == std::is_trivially_destructible<T>::value)
+		{
+			Back().~T();
+		}
+
+		--mSize;
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::Reserve(size_t capacity)
+	{
+		const size_t chunkCount = (capacity + CHUNK_MASK) >> CHUNK_SHIFT;
+
+		// we allocate new chunks only if required
+		if (chunkCount > mChunks.Size())
+		{
+			mChunks.Reserve(chunkCount);
+
+			while (mChunks.Size() < chunkCount)
+			{
+				AddChunk();
+			}
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	void SegmentedVector<T, CHUNK_SHIFT>::Resize(size_t size)
+	{
+		Reserve(size);
+
+		// the new elements are value initialized (0 for numbers), the removed ones are destroyed
+		while (mSize < size)
+		{
+			EmplaceBack();
+		}
+
+		while (mSize > size)
+		{
+			PopBack();
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	template <class Func>
+	void SegmentedVector<T, CHUNK_SHIFT>::ForEachChunk(Func func)
+	{
+		for (size_t first = 0; first < mSize; first += CHUNK_SIZE)
+		{
+			const size_t count = (mSize - first < CHUNK_SIZE) ? mSize - first : CHUNK_SIZE;
+			func(mChunks[first >> CHUNK_SHIFT], count);
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	template <class Func>
+	void SegmentedVector<T, CHUNK_SHIFT>::ForEachChunk(Func func) const
+	{
+		for (size_t first = 0; first < mSize; first += CHUNK_SIZE)
+		{
+			const size_t count = (mSize - first < CHUNK_SIZE) ? mSize - first : CHUNK_SIZE;
+			func(static_cast<const T*>(mChunks[first >> CHUNK_SHIFT]), count);
+		}
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	template <class Func>
+	void SegmentedVector<T, CHUNK_SHIFT>::ForEach(Func func)
+	{
+		// the inner loop is over contiguous memory, without the chunk lookup per element
+		ForEachChunk([&func](T* elements, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				func(elements[i]);
+			}
+		});
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	template <class Func>
+	void SegmentedVector<T, CHUNK_SHIFT>::ForEach(Func func) const
+	{
+		ForEachChunk([&func](const T* elements, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				func(elements[i]);
+			}
+		});
+	}
+
+	template <class T, size_t CHUNK_SHIFT>
+	Allocator* SegmentedVector<T, CHUNK_SHIFT>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
+	/////////// INPUT & OUTPUT /////////////
+	template <class T, size_t CHUNK_SHIFT>
+	std::ostream& operator << (std::ostream& out, const SegmentedVector<T, CHUNK_SHIFT>& vec)
+	{
+		out << "vec: ";
+		vec.ForEach([&out](const T& element)
+		{
+			out << element << " ";
+		});
+		out << std::endl;
+
+		return out;
+	}
+}
+
+#endif /* SEGMENTED_VECTOR_HPP */
@@ -5,6 +5,7 @@
 #include <utility> // std::move()
 #include <cassert>
 #include <iostream>
+#include "AllocatorUtility.hpp"
 
 /*
 SinglyLinkedList - a type of collection/container to store elements of the same type
@@ -75,7 +76,8 @@ namespace SDA
 	class SinglyLinkedList
 	{
 	public:
-		SinglyLinkedList();
+		// nullptr allocator means the global heap
+		SinglyLinkedList(Allocator* allocator = nullptr);
 		SinglyLinkedList(const SinglyLinkedList<T>& list);
 		SinglyLinkedList(SinglyLinkedList<T>&& list);
 		virtual ~SinglyLinkedList();
@@ -98,6 +100,8 @@ namespace SDA
 		void Reverse();
 		void InsertionSort();
 
+		Allocator* GetAllocator() const;
+
 	private:
 		void Copy(const SinglyLinkedList<T>& list);
 		void Move(SinglyLinkedList<T>&& list);
@@ -105,6 +109,8 @@ namespace SDA
 
 		SinglyLinkedListNode<T>* mHeadPtr;
 		size_t mSize;
+
+		Allocator* mAllocator; // not owned
 	};
 }
 
@@ -114,20 +120,22 @@ namespace SDA
 namespace SDA
 {
 	template <class T>
-	SinglyLinkedList<T>::SinglyLinkedList()
-		: mHeadPtr(nullptr), mSize(0)
+	SinglyLinkedList<T>::SinglyLinkedList(Allocator* allocator)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(allocator)
 	{}
 
 	template <class T>
 	SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList<T>& list)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(list.mAllocator) // the copy uses the same allocator
 	{
 		Copy(list);
 	}
 
 	template <class T>
 	SinglyLinkedList<T>::SinglyLinkedList(SinglyLinkedList<T>&& list)
+		: mHeadPtr(nullptr), mSize(0), mAllocator(list.mAllocator)
 	{
-		Move(list);
+		Move(std::move(list));
 	}
 
 	template <class T>
@@ -158,6 +166,9 @@ namespace SDA
 		{
 			Destroy();
 
+			// the nodes are freed with the allocator of list
+			mAllocator = list.mAllocator;
+
 			mSize = list.mSize;
 
 			mHeadPtr = list.mHeadPtr;
@@ -172,7 +183,7 @@ namespace SDA
 		while (crrNodePtr != nullptr)
 		{
 			mHeadPtr = crrNodePtr->nextPtr;
-			delete crrNodePtr;
+			SDA::Delete(mAllocator, crrNodePtr);
 			crrNodePtr = mHeadPtr;
 		}
 
@@ -191,11 +202,17 @@ namespace SDA
 	template <class T>
 	SinglyLinkedList<T>& SinglyLinkedList<T>::operator =(SinglyLinkedList<T>&& list)
 	{
-		Move(list);
+		Move(std::move(list));
 
 		return *this;
 	}
 
+	template <class T>
+	Allocator* SinglyLinkedList<T>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+
 	template <class T>
 	SinglyLinkedListNode<T>* SinglyLinkedList<T>::First() const
 	{
@@ -211,7 +228,7 @@ namespace SDA
 	template <class T>
 	void SinglyLinkedList<T>::InsertFirst(const T& val)
 	{
-		SinglyLinkedListNode<T>* newNodePtr = new SinglyLinkedListNode<T>(val);
+		SinglyLinkedListNode<T>* newNodePtr = SDA::New<SinglyLinkedListNode<T>>(mAllocator, val);
 
 		// we can insert even if the lsit is empty
 
@@ -227,13 +244,13 @@ namespace SDA
 	template <class T>
 	void SinglyLinkedList<T>::InsertLast(const T& val)
 	{
-		SinglyLinkedListNode<T>* newNodePtr = new SinglyLinkedListNode<T>(val);
+		SinglyLinkedListNode<T>* newNodePtr = SDA::New<SinglyLinkedListNode<T>>(mAllocator, val);
 
 		if (mHeadPtr)
 		{
 			SinglyLinkedListNode<T>* crrNodePtr = mHeadPtr;
 
-			while (crrNodePtr != nullptr)
+			while (crrNodePtr->nextPtr != nullptr)
 			{
 				crrNodePtr = crrNodePtr->nextPtr;
 			}
@@ -263,7 +280,7 @@ namespace SDA
 		}
 		else // in between
 		{
-			SinglyLinkedListNode<T>* newNodePtr = new SinglyLinkedListNode<T>(val);
+			SinglyLinkedListNode<T>* newNodePtr = SDA::New<SinglyLinkedListNode<T>>(mAllocator, val);
 
 			size_t idx = -1; // we start with an an index before to arrive at the node before the one we must insert the new node 
 			SinglyLinkedListNode<T>* beforeNode = nullptr;
@@ -297,7 +314,7 @@ namespace SDA
 		mHeadPtr = mHeadPtr->nextPtr;
 
 		nodeToDeletePtr->nextPtr = nullptr;
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -323,7 +340,7 @@ namespace SDA
 		else
 		{
 			SinglyLinkedListNode<T>* crrNodePtr = mHeadPtr;
-			while (crrNodePtr->nextPtr->nextPtr != nullptr))
+			while (crrNodePtr->nextPtr->nextPtr != nullptr)
 			{
 				crrNodePtr = crrNodePtr->nextPtr;
 			}
@@ -334,7 +351,7 @@ namespace SDA
 		}
 
 		nodeToDeletePtr->nextPtr = nullptr;
-		delete nodeToDeletePtr;
+		SDA::Delete(mAllocator, nodeToDeletePtr);
 		--mSize;
 	}
 
@@ -371,7 +388,7 @@ namespace SDA
 			}
 
 			nodeToDeletePtr->nextPtr = nullptr;
-			delete nodeToDeletePtr;
+			SDA::Delete(mAllocator, nodeToDeletePtr);
 			--mSize;
 		}
 	}
@@ -386,16 +403,16 @@ namespace SDA
 			Space complexity O(1)
 		*/
 
-		SinglyLinkedListNode<T>* reversedHeadPtr = mHeadPtr;
-		reversedHeadPtr->nextPtr = nullptr; // last elements of the reversed list
-
 		// in case the original list has no elements or only one
 		if ((mHeadPtr == nullptr) || (mHeadPtr->nextPtr == nullptr))
 		{
 			return;
 		}
 
-		SinglyLinkedListNode<T>* remainingListPtr = mHeadPtr->next; // next element in the line
+		SinglyLinkedListNode<T>* remainingListPtr = mHeadPtr->nextPtr; // next element in the line
+
+		SinglyLinkedListNode<T>* reversedHeadPtr = mHeadPtr;
+		reversedHeadPtr->nextPtr = nullptr; // last elements of the reversed list
 		
 		while (remainingListPtr != nullptr)
 		{
@@ -414,22 +431,29 @@ namespace SDA
 	void SinglyLinkedList<T>::InsertionSort()
 	{
 		/* Idea:
-			We use one extra pointer called reversed to which we add the elements from the initial list (in order)
+			We use one extra pointer called sorted to which we insert the elements from the initial list (in order)
+			at their place
 
-			Time complexity: O(n)
+			Time complexity: O(n^2)
 			Space complexity O(1)
 		*/
 
+		if (mHeadPtr == nullptr)
+		{
+			return;
+		}
+
 		SinglyLinkedListNode<T>* sortedHeadPtr = mHeadPtr;
 
-		SinglyLinkedListNode<T>* remainingListPtr = mHeadPtr->next; // next element in the line
+		SinglyLinkedListNode<T>* remainingListPtr = mHeadPtr->nextPtr; // next element in the line
+		sortedHeadPtr->nextPtr = nullptr;
 
 		while (remainingListPtr != nullptr)
 		{
 			SinglyLinkedListNode<T>* crrNodePtr = remainingListPtr;
 			remainingListPtr = remainingListPtr->nextPtr; // remaining ptr moves forward
 
-			// decresing order sort
+			// increasing order sort
 			if (crrNodePtr->data < sortedHeadPtr->data)
 			{
 				// insert before
@@ -439,8 +463,15 @@ namespace SDA
 			}
 			else
 			{
-				// insert after
-				sortedHeadPtr->nextPtr = crrNodePtr;
+				// insert after the last node with a smaller or equal value
+				SinglyLinkedListNode<T>* beforeNodePtr = sortedHeadPtr;
+				while (beforeNodePtr->nextPtr != nullptr && false == (crrNodePtr->data < beforeNodePtr->nextPtr->data))
+				{
+					beforeNodePtr = beforeNodePtr->nextPtr;
+				}
+
+				crrNodePtr->nextPtr = beforeNodePtr->nextPtr;
+				beforeNodePtr->nextPtr = crrNodePtr;
 			}
 		}
 
@@ -0,0 +1,245 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include "VectorBase.hpp"
+#include <cstddef> // size_t
+#include <cstring> // memcpy()
+#include <utility> // std::move()
+#include <type_traits>
+#include <iostream>
+
+/*
+SmallVector - a Vector that keeps its first N elements inside the object (inline buffer)
+and spills to the heap (or the Allocator) only when it grows beyond N.
+Has the same interface as Vector, the element management is shared with it (VectorBase.hpp).
+
+TIME COMPLEXITY:
+- same as Vector
+- the first heap allocation happens only at the (N + 1)th element, not at the first one
+- Move = O(1) when the elements are on the heap (the buffer is stolen), O(N) when inline
+
+SPACE COMPLEXITY:
+- O(N) inline even when empty, plus the heap buffer after the spill
+
+ADVANTAGES:
+ - no allocation at all for the vectors that stay small (most of them)
+ - the elements are next to the size/capacity, one cache miss less than Vector
+ - trivially copyable elements are moved with memcpy() and grown with realloc() once on the heap
+
+DISADVANTAGES:
+ - the object is bigger (N * sizeof(T)), bad for big N or when it is stored in big arrays
+ - moving an inline SmallVector moves every element, the pointers to the elements are invalidated by it
+
+USAGES:
+ - short lived vectors with a known typical size
+ e.g. the neighbours of a node, the tokens of a line, the results of a small query
+
+*/
+
+namespace SDA
+{
+	/* SmallVector container - dynamic size, the first N elements are stored inline */
+	template <class T, size_t N>
+	class SmallVector : public VectorBase<T, SmallVector<T, N>>
+	{
+		static_assert(N > 0, "use Vector when no inline element is wanted");
+
+	public:
+		// nullptr allocator means the global heap, used only after the spill
+		SmallVector(Allocator* allocator = nullptr);
+		SmallVector(size_t size, Allocator* allocator = nullptr);
+		SmallVector(size_t size, const T& val, Allocator* allocator = nullptr);
+		SmallVector(const SmallVector<T, N>& vec);
+		SmallVector(SmallVector<T, N>&& vec) noexcept(std::is_nothrow_move_constructible<T>::value);
+		~SmallVector();
+
+		SmallVector<T, N>& operator =(const SmallVector<T, N>& vec);
+		SmallVector<T, N>& operator =(SmallVector<T, N>&& vec) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+		// true while the elements are in the inline buffer
+		bool IsInline() const;
+
+		void Swap(SmallVector<T, N>& vec);
+
+	private:
+		typedef VectorBase<T, SmallVector<T, N>> Base;
+		friend Base;
+
+		using Base::mBuffer;
+		using Base::mCapacity;
+		using Base::mSize;
+		using Base::mAllocator;
+		using Base::IS_TRIVIALLY_COPYABLE;
+
+		void Copy(const SmallVector<T, N>& vec);
+		void Move(SmallVector<T, N>&& vec);
+		// destroys the elements, frees the heap buffer and goes back to the inline one
+		void Destroy();
+
+		T* InlineBuffer();
+		// the inline buffer is neither grown with realloc() nor freed
+		bool IsHeapBuffer() const;
+
+		alignas(T) unsigned char mInlineBuffer[N * sizeof(T)];
+	};
+}
+
+/* As we do use templates we have to provie the definition in the header */
+//////////////// IMPLEMENTATION ////////////
+
+namespace SDA
+{
+	template <class T, size_t N>
+	SmallVector<T, N>::SmallVector(Allocator* allocator)
+		: Base(nullptr, 0, allocator)
+	{
+		// the inline buffer is a member, its address is known only once the base is constructed
+		mBuffer = InlineBuffer();
+		mCapacity = N;
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>::SmallVector(size_t size, Allocator* allocator)
+		: SmallVector(allocator)
+	{
+		this->Resize(size);
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>::SmallVector(size_t size, const T& val, Allocator* allocator)
+		: SmallVector(allocator)
+	{
+		this->Fill(size, val);
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>::SmallVector(const SmallVector<T, N>& vec)
+		: SmallVector(vec.mAllocator) // the copy uses the same allocator
+	{
+		Copy(vec);
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>::SmallVector(SmallVector<T, N>&& vec) noexcept(std::is_nothrow_move_constructible<T>::value)
+		: SmallVector(vec.mAllocator)
+	{
+		Move(std::move(vec));
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>::~SmallVector()
+	{
+		Destroy();
+	}
+
+	template <class T, size_t N>
+	void SmallVector<T, N>::Copy(const SmallVector<T, N>& vec)
+	{
+		this->CopyElements(vec);
+	}
+
+	template <class T, size_t N>
+	void SmallVector<T, N>::Move(SmallVector<T, N>&& vec)
+	{
+		if (this != &vec)
+		{
+			// delete the old buffer
+			Destroy();
+
+			mAllocator = vec.mAllocator;
+
+			if (false == vec.IsInline())
+			{
+				// just copy the pointer, the buffer is freed with the allocator of vec
+				mBuffer = vec.mBuffer;
+				mCapacity = vec.mCapacity;
+				mSize = vec.mSize;
+
+				vec.mBuffer = vec.InlineBuffer();
+				vec.mCapacity = N;
+			}
+			else if constexpr (IS_TRIVIALLY_COPYABLE)
+			{
+				std::memcpy(mBuffer, vec.mBuffer, vec.mSize * sizeof(T));
+				mSize = vec.mSize;
+			}
+			else
+			{
+				// the inline elements can't be stolen, they are moved one by one
+				for (; mSize < vec.mSize; ++mSize)
+				{
+					new (mBuffer + mSize) T(std::move(vec.mBuffer[mSize]));
+				}
+				vec.DestroyElements(0, vec.mSize);
+			}
+
+			// vec is empty after move
+			vec.mSize = 0;
+		}
+	}
+
+	template <class T, size_t N>
+	void SmallVector<T, N>::Destroy()
+	{
+		this->ReleaseBuffer(InlineBuffer(), N);
+	}
+
+	template <class T, size_t N>
+	T* SmallVector<T, N>::InlineBuffer()
+	{
+		return reinterpret_cast<T*>(mInlineBuffer);
+	}
+
+	template <class T, size_t N>
+	bool SmallVector<T, N>::IsHeapBuffer() const
+	{
+		return false == IsInline();
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>& SmallVector<T, N>::operator =(const SmallVector<T, N>& vec)
+	{
+		Copy(vec);
+
+		return *this;
+	}
+
+	template <class T, size_t N>
+	SmallVector<T, N>& SmallVector<T, N>::operator =(SmallVector<T, N>&& vec) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		Move(std::move(vec));
+
+		return *this;
+	}
+
+	template <class T, size_t N>
+	bool SmallVector<T, N>::IsInline() const
+	{
+		return mBuffer == reinterpret_cast<const T*>(mInlineBuffer);
+	}
+
+	template <class T, size_t N>
+	void SmallVector<T, N>::Swap(SmallVector<T, N>& vec)
+	{
+		// the inline elements can't be exchanged by pointers, three moves handle every case
+		SmallVector<T, N> tmp(std::move(vec));
+		vec = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	/////////// INPUT & OUTPUT /////////////
+	template <class T, size_t N>
+	std::ostream& operator << (std::ostream& out, const SmallVector<T, N>& vec)
+	{
+		out << "vec: ";
+		for (size_t i = 0; i < vec.Size(); ++i)
+		{
+			out << vec.At(i) << " ";
+		}
+		out << std::endl;
+
+		return out;
+	}
+}
+
+#endif /* SMALL_VECTOR_HPP */
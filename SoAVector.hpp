@@ -0,0 +1,581 @@
+#ifndef SOA_VECTOR_HPP
+#define SOA_VECTOR_HPP
+
+#include "AllocatorUtility.hpp"
+#include "Span.hpp"
+#include <cstddef> // size_t
+#include <cstring> // memcpy()
+#include <tuple>
+#include <utility> // std::move(), std::forward(), std::index_sequence
+#include <type_traits>
+#include <cassert>
+
+/*
+SoAVector - struct of arrays, a vector of rows (Fields...) where every field has its own
+contiguous column instead of storing the rows one after the other (array of structs, Vector<Record>).
+A scan that reads 1-2 fields loads only their columns, every loaded cache line is useful
+and the compiler can vectorize the loop over a column.
+The columns are aligned to COLUMN_ALIGNMENT (the cache line, also enough for AVX-512 loads).
+
+TIME COMPLEXITY:
+- same as Vector, a row is added to every column
+- Index a field = O(1)
+
+SPACE COMPLEXITY:
+- O(N * sum of the field sizes), no padding between the fields of a row
+
+ADVANTAGES:
+ - scans over a few fields read only those columns
+ - no padding of the rows (e.g. { double, char } takes 9 bytes per row instead of 16)
+ - Column<I>() is a plain array, ready for SIMD and the std algorithms
+
+DISADVANTAGES:
+ - reading a whole row touches one cache line per field
+ - adding a row writes to every column
+
+USAGES:
+ - tables scanned by a few columns at a time
+ e.g. the filter and aggregation of a query, physics/particle updates, the components of an ECS
+
+	SDA::SoAVector<std::int64_t, double, int> orders; // id, price, quantity
+	orders.PushBack(std::make_tuple(1, 9.5, 3));
+	SDA::Span<const double> prices = orders.Column<1>();
+	orders.ForEachOf<1, 2>([&](double price, int quantity) { total += price * quantity; });
+*/
+
+namespace SDA
+{
+	/* SoAVector container - dynamic size, one contiguous column per field */
+	template <class... Fields>
+	class SoAVector
+	{
+		static_assert(sizeof...(Fields) > 0, "a row needs at least one field");
+
+	public:
+		typedef std::tuple<Fields...> Row;
+		// the references to the fields of one row
+		typedef std::tuple<Fields&...> RowRef;
+		typedef std::tuple<const Fields&...> ConstRowRef;
+
+		template <size_t I>
+		using FieldType = typename std::tuple_element<I, Row>::type;
+
+		static const size_t FIELD_COUNT = sizeof...(Fields);
+		static const size_t COLUMN_ALIGNMENT = 64;
+
+		// nullptr allocator means the global heap
+		SoAVector(Allocator* allocator = nullptr);
+		SoAVector(const SoAVector<Fields...>& vec);
+		SoAVector(SoAVector<Fields...>&& vec) noexcept;
+		virtual ~SoAVector();
+
+		SoAVector<Fields...>& operator =(const SoAVector<Fields...>& vec);
+		SoAVector<Fields...>& operator =(SoAVector<Fields...>&& vec) noexcept;
+
+		// the field I of the row index
+		template <size_t I>
+		FieldType<I>& Get(size_t index);
+		template <size_t I>
+		const FieldType<I>& Get(size_t index) const;
+
+		RowRef operator [](size_t index);
+		ConstRowRef operator [](size_t index) const;
+
+		bool IsEmpty() const;
+
+		size_t Capacity() const;
+		size_t Size() const;
+
+		void PushBack(const Row& row);
+		void PushBack(Row&& row);
+		// one value per field, e.g. EmplaceBack(id, price, quantity)
+		template <class... Args>
+		void EmplaceBack(Args&&... values);
+		void PopBack();
+
+		void Reserve(size_t capacity);
+		void Resize(size_t size);
+
+		// the column of the field I, valid until the vector grows
+		template <size_t I>
+		Span<FieldType<I>> Column();
+		template <size_t I>
+		Span<const FieldType<I>> Column() const;
+
+		// zipped iteration, func(Fields&...) is called for every row
+		template <class Func>
+		void ForEach(Func func);
+		template <class Func>
+		void ForEach(Func func) const;
+
+		// zipped iteration over the columns I..., only those are read
+		template <size_t... I, class Func>
+		void ForEachOf(Func func);
+		template <size_t... I, class Func>
+		void ForEachOf(Func func) const;
+
+		Allocator* GetAllocator() const;
+
+	private:
+		typedef std::tuple<Fields*...> Columns;
+		typedef std::index_sequence_for<Fields...> FieldIndices;
+
+		void Copy(const SoAVector<Fields...>& vec);
+		void Move(SoAVector<Fields...>&& vec);
+		void Destroy();
+
+		template <size_t... I>
+		RowRef GetRow(size_t index, std::index_sequence<I...>);
+		template <size_t... I>
+		ConstRowRef GetRow(size_t index, std::index_sequence<I...>) const;
+
+		template <class RowT, size_t... I>
+		void PushRow(RowT&& row, std::index_sequence<I...>);
+		template <size_t... I, class... Args>
+		void EmplaceRow(std::index_sequence<I...>, Args&&... values);
+		template <size_t... I>
+		void DestroyRows(size_t first, size_t last, std::index_sequence<I...>);
+		template <size_t... I>
+		void Relocate(size_t capacity, std::index_sequence<I...>);
+		template <size_t... I>
+		void FreeColumns(Columns& columns, std::index_sequence<I...>);
+
+		template <class F>
+		static constexpr size_t ColumnAlignment();
+		template <class F>
+		static void DestroyColumn(F* column, size_t first, size_t last);
+		template <class F>
+		static void MoveColumn(F* column, F* newColumn, size_t size);
+
+		size_t NextCapacity() const;
+
+		Columns mColumns; // raw memory, [0, mSize) are constructed in every column
+		size_t mCapacity;
+		size_t mSize;
+
+		Allocator* mAllocator; // not owned
+
+		static const size_t ORDER_OF_GROWTH = 2;
+	};
+}
+
+/* As we do use templates we have to provie the definition in the header */
+//////////////// IMPLEMENTATION ////////////
+
+namespace SDA
+{
+	template <class... Fields>
+	SoAVector<Fields...>::SoAVector(Allocator* allocator)
+		: mColumns(), mCapacity(0), mSize(0), mAllocator(allocator)
+	{}
+
+	template <class... Fields>
+	SoAVector<Fields...>::SoAVector(const SoAVector<Fields...>& vec)
+		: SoAVector(vec.mAllocator) // the copy uses the same allocator
+	{
+		Copy(vec);
+	}
+
+	template <class... Fields>
+	SoAVector<Fields...>::SoAVector(SoAVector<Fields...>&& vec) noexcept
+		: SoAVector(vec.mAllocator)
+	{
+		Move(std::move(vec));
+	}
+
+	template <class... Fields>
+	SoAVector<Fields...>::~SoAVector()
+	{
+		Destroy();
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::Copy(const SoAVector<Fields...>& vec)
+	{
+		if (this != &vec)
+		{
+			// the current columns are kept if they are big enough
+			DestroyRows(0, mSize, FieldIndices());
+			mSize = 0;
+
+			Reserve(vec.mSize);
+
+			for (size_t i = 0; i < vec.mSize; ++i)
+			{
+				PushRow(vec[i], FieldIndices());
+			}
+		}
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::Move(SoAVector<Fields...>&& vec)
+	{
+		if (this != &vec)
+		{
+			// delete the old columns
+			Destroy();
+
+			// just copy the pointers, the columns are freed with the allocator of vec
+			mColumns = vec.mColumns;
+			mCapacity = vec.mCapacity;
+			mSize = vec.mSize;
+			mAllocator = vec.mAllocator;
+
+			// vec is invalidated after move
+			vec.mColumns = Columns();
+			vec.mCapacity = 0;
+			vec.mSize = 0;
+		}
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::Destroy()
+	{
+		DestroyRows(0, mSize, FieldIndices());
+		FreeColumns(mColumns, FieldIndices());
+
+		mColumns = Columns();
+		mCapacity = 0;
+		mSize = 0;
+	}
+
+	template <class... Fields>
+	SoAVector<Fields...>& SoAVector<Fields...>::operator =(const SoAVector<Fields...>& vec)
+	{
+		Copy(vec);
+
+		return *this;
+	}
+
+	template <class... Fields>
+	SoAVector<Fields...>& SoAVector<Fields...>::operator =(SoAVector<Fields...>&& vec) noexcept
+	{
+		Move(std::move(vec));
+
+		return *this;
+	}
+
+	template <class... Fields>
+	template <size_t I>
+	typename SoAVector<Fields...>::template FieldType<I>& SoAVector<Fields...>::Get(size_t index)
+	{
+		assert(index < mSize);
+
+		return std::get<I>(mColumns)[index];
+	}
+
+	template <class... Fields>
+	template <size_t I>
+	const typename SoAVector<Fields...>::template FieldType<I>& SoAVector<Fields...>::Get(size_t index) const
+	{
+		assert(index < mSize);
+
+		return std::get<I>(mColumns)[index];
+	}
+
+	template <class... Fields>
+	typename SoAVector<Fields...>::RowRef SoAVector<Fields...>::operator [](size_t index)
+	{
+		assert(index < mSize);
+
+		return GetRow(index, FieldIndices());
+	}
+
+	template <class... Fields>
+	typename SoAVector<Fields...>::ConstRowRef SoAVector<Fields...>::operator [](size_t index) const
+	{
+		assert(index < mSize);
+
+		return GetRow(index, FieldIndices());
+	}
+
+	template <class... Fields>
+	template <size_t... I>
+	typename SoAVector<Fields...>::RowRef SoAVector<Fields...>::GetRow(size_t index, std::index_sequence<I...>)
+	{
+		return RowRef(std::get<I>(mColumns)[index]...);
+	}
+
+	template <class... Fields>
+	template <size_t... I>
+	typename SoAVector<Fields...>::ConstRowRef SoAVector<Fields...>::GetRow(size_t index, std::index_sequence<I...>) const
+	{
+		return ConstRowRef(std::get<I>(mColumns)[index]...);
+	}
+
+	template <class... Fields>
+	bool SoAVector<Fields...>::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	template <class... Fields>
+	size_t SoAVector<Fields...>::Capacity() const
+	{
+		return mCapacity;
+	}
+
+	template <class... Fields>
+	size_t SoAVector<Fields...>::Size() const
+	{
+		return mSize;
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::PushBack(const Row& row)
+	{
+		PushRow(row, FieldIndices());
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::PushBack(Row&& row)
+	{
+		PushRow(std::move(row), FieldIndices());
+	}
+
+	template <class... Fields>
+	template <class... Args>
+	void SoAVector<Fields...>::EmplaceBack(Args&&... values)
+	{
+		static_assert(sizeof...(Args) == sizeof...(Fields), "one value per field");
+
+		EmplaceRow(FieldIndices(), std::forward<Args>(values)...);
+	}
+
+	template <class... Fields>
+	template <class RowT, size_t... I>
+	void SoAVector<Fields...>::PushRow(RowT&& row, std::index_sequence<I...>)
+	{
+		// std::get<I>(std::forward<RowT>(row)) moves the fields of an rvalue row
+		EmplaceRow(FieldIndices(), std::get<I>(std::forward<RowT>(row))...);
+	}
+
+	template <class... Fields>
+	template <size_t... I, class... Args>
+	void SoAVector<Fields...>::EmplaceRow(std::index_sequence<I...>, Args&&... values)
+	{
+		if (mSize == mCapacity)
+		{
+			// the row may be a copy of one of our rows, the values are taken before the columns move
+			Row row(std::forward<Args>(values)...);
+
+			Reserve(NextCapacity());
+
+			(new (std::get<I>(mColumns) + mSize) Fields(std::move(std::get<I>(row))), ...);
+		}
+		else
+		{
+			(new (std::get<I>(mColumns) + mSize) Fields(std::forward<Args>(values)), ...);
+		}
+
+		++mSize;
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::PopBack()
+	{
+		assert(mSize > 0);
+
+		// destroy the last row as it is removed
+		DestroyRows(mSize - 1, mSize, FieldIndices());
+
+		--mSize;
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::Reserve(size_t capacity)
+	{
+		// we reserve new space only if required
+		if (capacity > mCapacity)
+		{
+			Relocate(capacity, FieldIndices());
+		}
+	}
+
+	template <class... Fields>
+	void SoAVector<Fields...>::Resize(size_t size)
+	{
+		// reallocate only if required, the capacity still grows geometrically
+		if (size > mCapacity)
+		{
+			Reserve(size > mCapacity * ORDER_OF_GROWTH ? size : mCapacity * ORDER_OF_GROWTH);
+		}
+
+		// the new rows are value initialized (0 for numbers), the removed ones are destroyed
+		for (; mSize < size; ++mSize)
+		{
+			std::apply([this](Fields*... columns)
+			{
+				(new (columns + mSize) Fields(), ...);
+			}, mColumns);
+		}
+
+		DestroyRows(size, mSize, FieldIndices());
+		mSize = size;
+	}
+
+	template <class... Fields>
+	template <size_t... I>
+	void SoAVector<Fields...>::Relocate(size_t capacity, std::index_sequence<I...>)
+	{
+		// all the new columns are allocated first, so a failed allocation leaves the vector unchanged
+		Columns newColumns;
+		try
+		{
+			((std::get<I>(newColumns) = static_cast<Fields*>(
+				SDA::AllocateMemory(mAllocator, capacity * sizeof(Fields), ColumnAlignment<Fields>()))), ...);
+		}
+		catch (...)
+		{
+			FreeColumns(newColumns, FieldIndices());
+			throw;
+		}
+
+		(MoveColumn(std::get<I>(mColumns), std::get<I>(newColumns), mSize), ...);
+		FreeColumns(mColumns, FieldIndices());
+
+		mColumns = newColumns;
+		mCapacity = capacity;
+	}
+
+	template <class... Fields>
+	template <class F>
+	void SoAVector<Fields...>::MoveColumn(F* column, F* newColumn, size_t size)
+	{
+		if constexpr (std::is_trivially_copyable<F>::value)
+		{
+			if (size > 0)
+			{
+				std::memcpy(newColumn, column, size * sizeof(F));
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				new (newColumn + i) F(std::move(column[i]));
+				column[i].~F();
+			}
+		}
+	}
+
+	template <class... Fields>
+	template <size_t... I>
+	void SoAVector<Fields...>::FreeColumns(Columns& columns, std::index_sequence<I...>)
+	{
+		(SDA::FreeMemory(mAllocator, std::get<I>(columns), ColumnAlignment<Fields>()), ...);
+	}
+
+	template <class... Fields>
+	template <class F>
+	constexpr size_t SoAVector<Fields...>::ColumnAlignment()
+	{
+		return (alignof(F) > COLUMN_ALIGNMENT) ? alignof(F) : COLUMN_ALIGNMENT;
+	}
+
+	template <class... Fields>
+	template <size_t... I>
+	void SoAVector<Fields...>::DestroyRows(size_t first, size_t last, std::index_sequence<I...>)
+	{
+		(DestroyColumn(std::get<I>(mColumns), first, last), ...);
+	}
+
+	template <class... Fields>
+	template <class F>
+	void SoAVector<Fields...>::DestroyColumn(F* column, size_t first, size_t last)
+	{
+		if constexpr (false == std::is_trivially_destructible<F>::value)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				column[i].~F();
+			}
+		}
+	}
+
+	template <class... Fields>
+	size_t SoAVector<Fields...>::NextCapacity() const
+	{
+		// if empty resize for 2 rows, otherwise double the capacity
+		return (mCapacity == 0) ? 2 : mCapacity * ORDER_OF_GROWTH;
+	}
+
+	template <class... Fields>
+	template <size_t I>
+	Span<typename SoAVector<Fields...>::template FieldType<I>> SoAVector<Fields...>::Column()
+	{
+		return Span<FieldType<I>>(std::get<I>(mColumns), mSize);
+	}
+
+	template <class... Fields>
+	template <size_t I>
+	Span<const typename SoAVector<Fields...>::template FieldType<I>> SoAVector<Fields...>::Column() const
+	{
+		return Span<const FieldType<I>>(std::get<I>(mColumns), mSize);
+	}
+
+	template <class... Fields>
+	template <class Func>
+	void SoAVector<Fields...>::ForEach(Func func)
+	{
+		std::apply([this, &func](Fields*... columns)
+		{
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				func(columns[i]...);
+			}
+		}, mColumns);
+	}
+
+	template <class... Fields>
+	template <class Func>
+	void SoAVector<Fields...>::ForEach(Func func) const
+	{
+		std::apply([this, &func](const Fields*... columns)
+		{
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				func(columns[i]...);
+			}
+		}, static_cast<std::tuple<const Fields*...>>(mColumns));
+	}
+
+	template <class... Fields>
+	template <size_t... I, class Func>
+	void SoAVector<Fields...>::ForEachOf(Func func)
+	{
+		// the column pointers are copied to locals, the compiler can keep them in registers
+		const std::tuple<FieldType<I>*...> columns(std::get<I>(mColumns)...);
+
+		std::apply([this, &func](FieldType<I>*... column)
+		{
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				func(column[i]...);
+			}
+		}, columns);
+	}
+
+	template <class... Fields>
+	template <size_t... I, class Func>
+	void SoAVector<Fields...>::ForEachOf(Func func) const
+	{
+		const std::tuple<const FieldType<I>*...> columns(std::get<I>(mColumns)...);
+
+		std::apply([this, &func](const FieldType<I>*... column)
+		{
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				func(column[i]...);
+			}
+		}, columns);
+	}
+
+	template <class... Fields>
+	Allocator* SoAVector<Fields...>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+}
+
+#endif /* SOA_VECTOR_HPP */
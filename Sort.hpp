@@ -3,250 +3,394 @@
 
 #include <cstddef> // size_t
 #include <cassert>
+#include <iterator> // std::iterator_traits
+#include <type_traits> // std::is_integral, std::make_unsigned
+#include <utility> // std::move()
 #include "Utility.hpp"
 #include "Vector.hpp"
 
+/*
+Sort - the sort algorithms, generic over the element type and the comparator.
+Every algorithm sorts the random access iterators (pointers) [first, last)
+or a whole contiguous container: Vector, SmallVector, Span, anything with GetData() and Size().
+comp(a, b) is true when a goes before b (a strict weak ordering), Less by default.
+The comparator is a template parameter, so Less, Greater or a lambda are inlined in the loops:
+no virtual call per comparison.
+
+TIME COMPLEXITY:
+- BubbleSort, SelectionSort, InsertionSort = O(n^2)
+- CountSort = O(n + range), integer keys only, O(n log n) (QuickSort) when range > 8 * n + 1024
+- QuickSort = O(n log n) average, O(n^2) worst case, not stable
+- MergeSort = O(n log n), stable
+
+SPACE COMPLEXITY:
+- CountSort = O(range), MergeSort = O(n), QuickSort = O(log n) stack, the others O(1)
+
+USAGES:
+	SDA::QuickSort(vec);
+	SDA::MergeSort(vec, SDA::Greater());
+	SDA::QuickSort(pairs, [](const SDA::Pair<K, V>& a, const SDA::Pair<K, V>& b) { return a.First() < b.First(); });
+	SDA::InsertionSort(data, data + count);
+*/
+
 namespace SDA
 {
-	struct Comparator
-	{
-		virtual bool operator () (const int& val1, const int& val2) const
-		{
-			return false;
-		}
-	};
-
-	struct Greater : public Comparator
+	struct Greater
 	{
-		bool operator () (const int& val1, const int& val2) const override
+		template <class T>
+		bool operator () (const T& val1, const T& val2) const
 		{
 			return val1 > val2;
 		}
 	};
 
-	struct Less : public Comparator
+	struct Less
 	{
-		bool operator () (const int& val1, const int& val2) const override
+		template <class T>
+		bool operator () (const T& val1, const T& val2) const
 		{
 			return val1 < val2;
 		}
 	};
 
-	void BubbleSort(SDA::Vector<int>& vec, const Comparator& comp)
-	{
-		assert(vec.Size() >= 2);
+	// below it QuickSort and MergeSort finish the ranges with InsertionSort
+	const ptrdiff_t INSERTION_SORT_THRESHOLD = 16;
+	// CountSort keeps one count per key of [min, max], at most COUNT_SORT_RANGE_FACTOR * n + COUNT_SORT_MIN_RANGE,
+	// a wider range is sorted with QuickSort
+	const size_t COUNT_SORT_RANGE_FACTOR = 8;
+	const size_t COUNT_SORT_MIN_RANGE = 1024;
 
+	template <class RandomIt, class Cmp = Less>
+	void BubbleSort(RandomIt first, RandomIt last, Cmp comp = Cmp())
+	{
 		// just compare each element with the other and swap
-		for (size_t i = 0; i < vec.Size(); ++i)
+		for (RandomIt i = first; i != last; ++i)
 		{
-			for (size_t j = 0; j < vec.Size(); ++j)
+			for (RandomIt j = first; j != last; ++j)
 			{
-				if ((i != j) && comp(vec[i], vec[j]))
+				if ((i != j) && comp(*i, *j))
 				{
-					SDA::Swap(vec[i], vec[j]);
+					SDA::Swap(*i, *j);
 				}
 			}
 		}
 	}
 
-	void SelectionSort(SDA::Vector<int>& vec, const Comparator& comp)
+	template <class RandomIt, class Cmp = Less>
+	void SelectionSort(RandomIt first, RandomIt last, Cmp comp = Cmp())
 	{
-		assert(vec.Size() >= 2);
+		if (last - first < 2)
+		{
+			return;
+		}
 
-		// One by one move boundary of unsorted subarray  
-		for (size_t i = 0; i < vec.Size() - 1; ++i)
+		// One by one move boundary of unsorted subarray
+		for (RandomIt i = first; i != last - 1; ++i)
 		{
 			// Find the minimum or maximum element in the unsorted subarray
-			size_t toSwapIdx = i;
-			for (size_t j = i + 1; j < vec.Size(); ++j)
+			RandomIt toSwap = i;
+			for (RandomIt j = i + 1; j != last; ++j)
 			{
-				if (comp(vec[j], vec[toSwapIdx]))
+				if (comp(*j, *toSwap))
 				{
-					toSwapIdx = j;
+					toSwap = j;
 				}
 			}
 
 			// Swap the found minimum or maxmimum element with the first element
-			if (toSwapIdx != i)
+			if (toSwap != i)
 			{
-				SDA::Swap(vec[toSwapIdx], vec[i]);
+				SDA::Swap(*toSwap, *i);
 			}
 		}
 	}
 
-	void InsertionSort(SDA::Vector<int>& vec, const Comparator& comp)
+	template <class RandomIt, class Cmp = Less>
+	void InsertionSort(RandomIt first, RandomIt last, Cmp comp = Cmp())
 	{
-		assert(vec.Size() >= 2);
+		typedef typename std::iterator_traits<RandomIt>::value_type ValueType;
+
+		if (last - first < 2)
+		{
+			return;
+		}
 
 		// unsorted subarray is on the right
-		for (int i = 0; i < vec.Size(); ++i)
+		for (RandomIt i = first + 1; i != last; ++i)
 		{
 			// store crr element
-			int crr = vec[i];
-			int j = i;
+			ValueType crr = std::move(*i);
+			RandomIt j = i;
 
-			// while comparison holds 
-			while (j > 0 && comp(crr, vec[j - 1]))
+			// while comparison holds
+			while (j != first && comp(crr, *(j - 1)))
 			{
 				// move the left element on the right
-				vec[j] = vec[j - 1];
-				j = j - 1;
+				*j = std::move(*(j - 1));
+				--j;
 			}
-			vec[j] = crr;
+			*j = std::move(crr);
 		}
 	}
 
-	void CountSort(SDA::Vector<int>& vec, const Comparator& comp)
+	// partitions [first, last) around the median of the first, middle and last elements,
+	// returns the final position of the pivot, the range must have at least 3 elements
+	template <class RandomIt, class Cmp>
+	RandomIt Partition(RandomIt first, RandomIt last, Cmp comp)
 	{
-		assert(vec.Size() >= 2);
+		assert(last - first >= 3);
 
-		int max = SDA::Max(vec);
-		int min = SDA::Min(vec);
-		int range = max - min + 1;
+		RandomIt mid = first + (last - first) / 2;
+		RandomIt back = last - 1;
 
-		SDA::Vector<int> count(range), output(vec.Size());
-		for (size_t i = 0; i < vec.Size(); i++)
-			count[vec[i] - min]++;
+		// sort the 3 candidates, the median is a better pivot on sorted or almost sorted input
+		if (comp(*mid, *first)) SDA::Swap(*mid, *first);
+		if (comp(*back, *mid))
+		{
+			SDA::Swap(*back, *mid);
+			if (comp(*mid, *first)) SDA::Swap(*mid, *first);
+		}
 
-		for (size_t i = 1; i < count.Size(); i++)
-			count[i] += count[i - 1];
+		// the pivot waits in front, *back isn't less than it so the left scan stops before last
+		SDA::Swap(*first, *mid);
 
-		for (size_t i = vec.Size() - 1; i >= 0; i--)
+		// Hoare partition: both scans stop on the elements equal to the pivot, the many duplicates are split evenly
+		RandomIt i = first;
+		RandomIt j = last;
+		for (;;)
 		{
-			output[--count[vec[i] - min]] = vec[i];
+			do { ++i; } while (comp(*i, *first));
+			do { --j; } while (comp(*first, *j));
+
+			if (i >= j)
+			{
+				break;
+			}
+			SDA::Swap(*i, *j);
 		}
 
-		for (int i = 0; i < vec.Size(); i++)
-			vec[i] = output[i];
-	}
+		// swap pivot with the last element of the left part
+		SDA::Swap(*first, *j);
 
-	size_t Partition(SDA::Vector<int>& vec, int low, int high, const Comparator& comp)
-	{
-		int pivot = vec[high]; // we select the high index as pivot (last element)  
-		int i = (low - 1); // Index of left most element  
+		return j;
+	}
 
-		std::cout << "pivot: " << pivot << std::endl;
+	// other info: https://www.geeksforgeeks.org/3-way-quicksort-dutch-national-flag/
 
-		// sort left subarray
-		for (size_t j = low; j <= high - 1; ++j)
+	template <class RandomIt, class Cmp = Less>
+	void QuickSort(RandomIt first, RandomIt last, Cmp comp = Cmp())
+	{
+		while (last - first > INSERTION_SORT_THRESHOLD)
 		{
-			std::cout << "j: " << j << std::endl;
+			RandomIt pivot = Partition(first, last, comp);
 
-			if (comp(vec[j], pivot))
+			// recurse into the smaller part and loop on the bigger one, the stack stays O(log n)
+			if (pivot - first < last - pivot)
 			{
-				std::cout << "comparison holds" << std::endl;
+				QuickSort(first, pivot, comp);
+				first = pivot + 1;
+			}
+			else
+			{
+				QuickSort(pivot + 1, last, comp);
+				last = pivot;
+			}
+		}
 
-				i++; // we increment the left most element while the comparison condition holds
-				std::cout << "i: " << i << std::endl;
+		// the small ranges are faster without the partitioning
+		InsertionSort(first, last, comp);
+	}
 
-				if (i != j)
-				{
-					std::cout << "swap" << std::endl;
-					SDA::Swap(vec[i], vec[j]);
-				}
-			}
+	// the keys are integers, the order is increasing unless comp puts the bigger keys first,
+	// a key range too wide for the counts falls back to QuickSort
+	template <class RandomIt, class Cmp = Less>
+	void CountSort(RandomIt first, RandomIt last, Cmp comp = Cmp())
+	{
+		typedef typename std::iterator_traits<RandomIt>::value_type ValueType;
+		static_assert(std::is_integral<ValueType>::value, "CountSort sorts integer keys");
+		typedef typename std::make_unsigned<ValueType>::type UnsignedType;
 
-			std::cout << vec;
+		if (last - first < 2)
+		{
+			return;
 		}
-		std::cout << "swap pivot" << std::endl;
-		// swap pivot with element after the last left most element
-		SDA::Swap(vec[i + 1], vec[high]);
 
-		std::cout << vec;
+		ValueType min = *first;
+		ValueType max = *first;
+		for (RandomIt it = first + 1; it != last; ++it)
+		{
+			if (*it < min) min = *it;
+			if (*it > max) max = *it;
+		}
 
-		return (i + 1);
-	}
+		// unsigned arithmetic, max - min doesn't overflow for the signed keys,
+		// the keys narrower than int are promoted, so the difference is cast back to UnsignedType
+		const UnsignedType span = (UnsignedType)((UnsignedType)max - (UnsignedType)min);
 
-	// other info: https://www.geeksforgeeks.org/3-way-quicksort-dutch-national-flag/
+		// the counts cost O(range): a range much wider than the key count (sparse 64 bit keys),
+		// which may not even fit in size_t, is sorted by comparisons instead
+		const size_t maxRange = (size_t)(last - first) * COUNT_SORT_RANGE_FACTOR + COUNT_SORT_MIN_RANGE;
+		if ((unsigned long long)span >= (unsigned long long)maxRange)
+		{
+			QuickSort(first, last, comp);
+			return;
+		}
 
-	void QuickSort(SDA::Vector<int>& vec, int low, int high, const Comparator& comp)
-	{
-		assert(vec.Size() >= 2);
+		const size_t range = (size_t)span + 1;
 
-		if (low < high)
+		SDA::Vector<size_t> count(range);
+		for (RandomIt it = first; it != last; ++it)
 		{
-			/* pi is partitioning index, vec[p] is now at right place */
-			int pi = Partition(vec, low, high, comp);
+			++count[(size_t)(UnsignedType)((UnsignedType)*it - (UnsignedType)min)];
+		}
+
+		// equal integers can't be told apart, so the keys are written back from the counts
+		RandomIt out = first;
+		for (size_t key = 0; key < range; ++key)
+		{
+			for (size_t i = 0; i < count[key]; ++i)
+			{
+				*out++ = (ValueType)(UnsignedType)((UnsignedType)min + (UnsignedType)key);
+			}
+		}
 
-			// Separately sort elements before  
-			// partition and after partition  
-			QuickSort(vec, low, pi - 1, comp);
-			QuickSort(vec, pi + 1, high, comp);
+		if (comp(max, min))
+		{
+			for (RandomIt left = first, right = last - 1; left < right; ++left, --right)
+			{
+				SDA::Swap(*left, *right);
+			}
 		}
 	}
 
-	// Merges two subarrays of arr[]. 
-	// First subarray is arr[l..m] 
-	// Second subarray is arr[m+1..r] 
-	void Merge(SDA::Vector<int>& vec, int left, int mid, int right, const Comparator& comp)
+	// Merges the sorted [first, mid) and [mid, last), buffer holds at least mid - first elements.
+	// The left part is moved to the buffer, then merged back, on ties the left element goes first (stable)
+	template <class RandomIt, class T, class Cmp>
+	void Merge(RandomIt first, RandomIt mid, RandomIt last, T* buffer, Cmp comp)
 	{
-		int i, j, k;
-		int nLeft = mid - left + 1;
-		int nRight = right - mid;
-
-		/* create temp arrays */
-		SDA::Vector<int> tempLeft, tempRight;
-		tempLeft.Resize(nLeft);
-		tempRight.Resize(nRight);
-
-		/* Copy data to temp arrays */
-		for (i = 0; i < nLeft; i++)
-			tempLeft[i] = vec[left + i];
-		for (j = 0; j < nRight; j++)
-			tempRight[j] = vec[mid + 1 + j];
+		T* left = buffer;
+		T* leftEnd = buffer;
+		for (RandomIt it = first; it != mid; ++it)
+		{
+			*leftEnd++ = std::move(*it);
+		}
 
-		/* Merge the temp arrays back into arr[l..r]*/
-		i = 0; // Initial index of first subarray 
-		j = 0; // Initial index of second subarray 
-		k = left; // Initial index of merged subarray 
-		while (i < nLeft && j < nRight)
+		RandomIt right = mid;
+		RandomIt out = first;
+		while (left != leftEnd && right != last)
 		{
-			if (comp(tempLeft[i], tempRight[j]))
+			if (comp(*right, *left))
 			{
-				vec[k] = tempLeft[i];
-				i++;
+				*out++ = std::move(*right++);
 			}
 			else
 			{
-				vec[k] = tempRight[j];
-				j++;
+				*out++ = std::move(*left++);
 			}
-			k++;
 		}
 
-		/* Copy the remaining elements of tempLeft, if there are any */
-		while (comp(i, nLeft))
+		// the rest of the right part is already in place
+		while (left != leftEnd)
+		{
+			*out++ = std::move(*left++);
+		}
+	}
+
+	template <class RandomIt, class T, class Cmp>
+	void MergeSort(RandomIt first, RandomIt last, T* buffer, Cmp comp)
+	{
+		if (last - first <= INSERTION_SORT_THRESHOLD)
 		{
-			vec[k] = tempLeft[i];
-			i++;
-			k++;
+			InsertionSort(first, last, comp);
+			return;
 		}
 
-		/* Copy the remaining elements of tempRight, if there are any */
-		while (comp(j, nRight))
+		RandomIt mid = first + (last - first) / 2;
+
+		// Separately sort first and second subarray
+		MergeSort(first, mid, buffer, comp);
+		MergeSort(mid, last, buffer, comp);
+
+		// the parts are already in order
+		if (false == comp(*mid, *(mid - 1)))
 		{
-			vec[k] = tempRight[j];
-			j++;
-			k++;
+			return;
 		}
+
+		// merge the 2 subarrays into a final array
+		Merge(first, mid, last, buffer, comp);
 	}
 
-	void MergeSort(SDA::Vector<int>& vec, int left, int right, const Comparator& comp)
+	template <class RandomIt, class Cmp = Less>
+	void MergeSort(RandomIt first, RandomIt last, Cmp comp = Cmp())
 	{
-		assert(vec.Size() >= 2);
+		typedef typename std::iterator_traits<RandomIt>::value_type ValueType;
 
-		if (left < right)
+		if (last - first < 2)
 		{
-			// Same as (left + right) / 2, but avoids overflow for large l and h 
-			int mid = left + (right - left) / 2;
+			return;
+		}
 
-			// Separately sort first subarray
-			// Separately sort second subarray
-			MergeSort(vec, left, mid, comp);
-			MergeSort(vec, mid + 1, right, comp);
+		// one buffer for all the merges, half of the range is enough
+		SDA::Vector<ValueType> buffer((size_t)(last - first) / 2 + 1);
+		MergeSort(first, last, buffer.GetData(), comp);
+	}
+
+	/////////// the whole container /////////////
+
+	template <class Container, class Cmp = Less>
+	auto BubbleSort(Container&& container, Cmp comp = Cmp()) -> decltype(container.GetData(), void())
+	{
+		BubbleSort(container.GetData(), container.GetData() + container.Size(), comp);
+	}
 
-			// merge the 2 subarrays into a final array
-			Merge(vec, left, mid, right, comp);
+	template <class Container, class Cmp = Less>
+	auto SelectionSort(Container&& container, Cmp comp = Cmp()) -> decltype(container.GetData(), void())
+	{
+		SelectionSort(container.GetData(), container.GetData() + container.Size(), comp);
+	}
+
+	template <class Container, class Cmp = Less>
+	auto InsertionSort(Container&& container, Cmp comp = Cmp()) -> decltype(container.GetData(), void())
+	{
+		InsertionSort(container.GetData(), container.GetData() + container.Size(), comp);
+	}
+
+	template <class Container, class Cmp = Less>
+	auto CountSort(Container&& container, Cmp comp = Cmp()) -> decltype(container.GetData(), void())
+	{
+		CountSort(container.GetData(), container.GetData() + container.Size(), comp);
+	}
+
+	template <class Container, class Cmp = Less>
+	auto QuickSort(Container&& container, Cmp comp = Cmp()) -> decltype(container.GetData(), void())
+	{
+		QuickSort(container.GetData(), container.GetData() + container.Size(), comp);
+	}
+
+	template <class Container, class Cmp = Less>
+	auto MergeSort(Container&& container, Cmp comp = Cmp()) -> decltype(container.GetData(), void())
+	{
+		MergeSort(container.GetData(), container.GetData() + container.Size(), comp);
+	}
+
+	// vec[low..high], both included
+	template <class T, class Cmp>
+	void QuickSort(SDA::Vector<T>& vec, int low, int high, Cmp comp)
+	{
+		if (low < high)
+		{
+			QuickSort(vec.GetData() + low, vec.GetData() + high + 1, comp);
+		}
+	}
+
+	// vec[left..right], both included
+	template <class T, class Cmp>
+	void MergeSort(SDA::Vector<T>& vec, int left, int right, Cmp comp)
+	{
+		if (left < right)
+		{
+			MergeSort(vec.GetData() + left, vec.GetData() + right + 1, comp);
 		}
 	}
 }
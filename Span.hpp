@@ -0,0 +1,70 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef> // size_t
+#include <cassert>
+
+/*
+Span - a view of count contiguous elements owned by someone else (a Vector, an array, a column).
+Copying a Span copies only the pointer and the size, the elements are never destroyed by it.
+It is valid as long as the memory it views isn't freed or reallocated.
+
+USAGES:
+	SDA::Span<const double> prices = table.Column<1>();
+	for (const double price : prices) { ... }
+*/
+
+namespace SDA
+{
+	template <class T>
+	class Span
+	{
+	public:
+		Span()
+			: mData(nullptr), mSize(0)
+		{}
+
+		Span(T* data, size_t size)
+			: mData(data), mSize(size)
+		{}
+
+		Span(T* first, T* last)
+			: mData(first), mSize(static_cast<size_t>(last - first))
+		{}
+
+		// Span<T> converts to Span<const T>
+		template <class U>
+		Span(const Span<U>& span)
+			: mData(span.GetData()), mSize(span.Size())
+		{}
+
+		T& operator [](size_t index) const
+		{
+			assert(index < mSize);
+
+			return mData[index];
+		}
+
+		T* GetData() const { return mData; }
+		size_t Size() const { return mSize; }
+		bool IsEmpty() const { return mSize == 0; }
+
+		// the elements [first, first + count)
+		Span<T> Subspan(size_t first, size_t count) const
+		{
+			assert(first + count <= mSize);
+
+			return Span<T>(mData + first, count);
+		}
+
+		// range-for and the std algorithms
+		T* begin() const { return mData; }
+		T* end() const { return mData + mSize; }
+
+	private:
+		T* mData; // not owned
+		size_t mSize;
+	};
+}
+
+#endif /* SPAN_HPP */
@@ -0,0 +1,144 @@
+#include "StackAllocator.hpp"
+#include "MemoryUtility.hpp"
+#include <cstdlib> // malloc(), free()
+#include <algorithm> // max
+#include <cassert>
+
+namespace SDA
+{
+	StackAllocator::StackAllocator()
+		: Allocator(), mMemoryBuffer(nullptr), mOffset(0)
+		, mIsVirtualMemory(false), mVirtualMemoryOptions(), mVirtualMemory()
+	{}
+
+	StackAllocator::StackAllocator(const std::size_t totalSize)
+		: Allocator(totalSize), mMemoryBuffer(nullptr), mOffset(0)
+		, mIsVirtualMemory(false), mVirtualMemoryOptions(), mVirtualMemory()
+	{}
+
+	StackAllocator::StackAllocator(const std::size_t totalSize, const VirtualMemoryOptions& options)
+		: Allocator(totalSize), mMemoryBuffer(nullptr), mOffset(0)
+		, mIsVirtualMemory(true), mVirtualMemoryOptions(options), mVirtualMemory()
+	{}
+
+	StackAllocator::~StackAllocator()
+	{
+		if (mMemoryBuffer && false == mIsVirtualMemory)
+		{
+			free(mMemoryBuffer);
+		}
+		mMemoryBuffer = nullptr;
+		mOffset = 0;
+	}
+
+	void StackAllocator::Init()
+	{
+		if (mIsVirtualMemory)
+		{
+			// only the address space is reserved, the pages are committed in Allocate()
+			mMemoryBuffer = mVirtualMemory.Reserve(mTotalSize, mVirtualMemoryOptions) ? mVirtualMemory.Base() : nullptr;
+		}
+		else
+		{
+			if (mMemoryBuffer)
+			{
+				free(mMemoryBuffer);
+			}
+			mMemoryBuffer = malloc(mTotalSize);
+		}
+
+		mOffset = 0;
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void StackAllocator::Reset()
+	{
+		if (mIsVirtualMemory && mVirtualMemoryOptions.releaseOnReset)
+		{
+			// give the pages back to the OS
+			mVirtualMemory.Decommit();
+		}
+
+		mOffset = 0;
+		mUsed = 0;
+		mPeak = 0;
+	}
+
+	void* StackAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+
+		const std::size_t currentAddress = (std::size_t)mMemoryBuffer + mOffset;
+
+		// the header itself must be correctly aligned
+		const std::size_t headerAlignment = std::max(alignment, alignof(AllocationHeader));
+		const std::size_t padding = SDA::CalculateMemoryPaddingWithHeader(currentAddress, headerAlignment, sizeof(AllocationHeader));
+
+		// check if there is space left to allocate
+		if (mOffset + padding + size > mTotalSize)
+		{
+			return nullptr;
+		}
+
+		// commit the pages lazily as the offset grows
+		if (mIsVirtualMemory && false == mVirtualMemory.Commit(mOffset + padding + size))
+		{
+			return nullptr;
+		}
+
+		const std::size_t nextAvailableAddress = currentAddress + padding;
+
+		// store the header right before the returned address
+		AllocationHeader* header = (AllocationHeader*)(nextAvailableAddress - sizeof(AllocationHeader));
+		header->padding = padding;
+		header->previousOffset = mOffset;
+#ifndef NDEBUG
+		header->size = size;
+#endif
+
+		mOffset += (size + padding);
+		mUsed = mOffset;
+		mPeak = std::max(mPeak, mUsed);
+
+		return (void*)nextAvailableAddress;
+	}
+
+	void StackAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		const std::size_t currentAddress = (std::size_t)ptr;
+
+		assert(currentAddress > (std::size_t)mMemoryBuffer &&
+			currentAddress < (std::size_t)mMemoryBuffer + mOffset && "Pointer not owned by this allocator");
+
+		const AllocationHeader* header = (const AllocationHeader*)(currentAddress - sizeof(AllocationHeader));
+
+		// the block has to start where the previous allocation ended
+		assert((std::size_t)mMemoryBuffer + header->previousOffset + header->padding == currentAddress && "Corrupted header");
+
+		// freeing a block below the top would silently free every block above it, use FreeToMarker() for that
+		assert(currentAddress + header->size == (std::size_t)mMemoryBuffer + mOffset && "Only the top block can be freed");
+
+		// roll back to the state before this allocation
+		mOffset = header->previousOffset;
+		mUsed = mOffset;
+	}
+
+	StackAllocator::Marker StackAllocator::GetMarker() const
+	{
+		return mOffset;
+	}
+
+	void StackAllocator::FreeToMarker(const Marker marker)
+	{
+		assert(marker <= mOffset && "Marker is above the top of the stack");
+
+		mOffset = marker;
+		mUsed = mOffset;
+	}
+}
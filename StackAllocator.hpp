@@ -0,0 +1,66 @@
+#ifndef STACK_ALLOCATOR_HPP
+#define STACK_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include "VirtualMemory.hpp"
+#include <cstddef> // size_t
+
+/*
+StackAllocator - a LiniarAllocator that can also free memory in LIFO order.
+Every allocation stores a small header right before the returned address
+with the padding used and the offset before the allocation.
+
+TIME COMPLEXITY:
+- Allocate = O(1)
+- Free = O(1) - only the top block can be freed
+- FreeToMarker = O(1) - rolls back everything allocated after the marker
+
+USAGES:
+- scratch memory of nested scopes freed in reverse order
+e.g. per request/frame temporaries
+*/
+
+namespace SDA
+{
+	class StackAllocator : public Allocator
+	{
+	public:
+		typedef std::size_t Marker;
+
+		StackAllocator();
+		StackAllocator(const std::size_t totalSize);
+		// backed by virtual memory instead of malloc()
+		StackAllocator(const std::size_t totalSize, const VirtualMemoryOptions& options);
+		virtual ~StackAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		Marker GetMarker() const;
+		void FreeToMarker(const Marker marker);
+
+	private:
+		NON_COPY_AND_MOVE(StackAllocator)
+
+		struct AllocationHeader
+		{
+			std::size_t padding;
+			std::size_t previousOffset;
+#ifndef NDEBUG
+			std::size_t size; // checks that Free() gets the top block
+#endif
+		};
+
+		void* mMemoryBuffer;
+		std::size_t mOffset;
+
+		bool mIsVirtualMemory;
+		VirtualMemoryOptions mVirtualMemoryOptions;
+		VirtualMemoryArena mVirtualMemory;
+	};
+}
+
+#endif /* STACK_ALLOCATOR_HPP */
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "ThreadCacheAllocator.hpp"
+#include <cassert>
+#include <utility> // pair
+
+namespace SDA
+{
+	namespace
+	{
+		// keeps the user pointer max aligned
+		const std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+		// size class stored in the header of the big blocks
+		const std::size_t LARGE_SIZE_CLASS = ThreadCacheAllocator::SIZE_CLASS_COUNT;
+
+		std::size_t SizeClass(const std::size_t size)
+		{
+			return (size - 1) / ThreadCacheAllocator::SIZE_CLASS_GRANULARITY;
+		}
+
+		std::size_t SizeClassBlockSize(const std::size_t sizeClass)
+		{
+			return HEADER_SIZE + (sizeClass + 1) * ThreadCacheAllocator::SIZE_CLASS_GRANULARITY;
+		}
+	}
+
+	std::atomic<std::size_t> ThreadCacheAllocator::sNextId(0);
+
+	ThreadCacheAllocator::ThreadCacheAllocator(Allocator& centralAllocator)
+		: Allocator(centralAllocator.TotalSize()), mCentralAllocator(centralAllocator), mCentralMutex()
+		, mThreadCaches(), mId(sNextId++)
+	{}
+
+	ThreadCacheAllocator::~ThreadCacheAllocator()
+	{
+		std::lock_guard<std::mutex> lock(mCentralMutex);
+
+		for (ThreadCache* cache : mThreadCaches)
+		{
+			delete cache;
+		}
+		mThreadCaches.clear();
+	}
+
+	void ThreadCacheAllocator::Init()
+	{
+		std::lock_guard<std::mutex> lock(mCentralMutex);
+
+		mCentralAllocator.Init();
+		ClearThreadCaches();
+		UpdateStatistics();
+	}
+
+	void ThreadCacheAllocator::Reset()
+	{
+		std::lock_guard<std::mutex> lock(mCentralMutex);
+
+		// the central allocator takes back all the memory, including the cached blocks
+		mCentralAllocator.Reset();
+		ClearThreadCaches();
+		UpdateStatistics();
+	}
+
+	void* ThreadCacheAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+	{
+		assert(size > 0);
+		assert(alignment <= HEADER_SIZE && "Alignment not supported");
+
+		if (size > MAX_SMALL_SIZE)
+		{
+			std::lock_guard<std::mutex> lock(mCentralMutex);
+
+			void* block = mCentralAllocator.Allocate(HEADER_SIZE + size, HEADER_SIZE);
+			UpdateStatistics();
+
+			if (nullptr == block)
+			{
+				return nullptr;
+			}
+
+			*(std::size_t*)block = LARGE_SIZE_CLASS;
+
+			return (void*)((std::size_t)block + HEADER_SIZE);
+		}
+
+		const std::size_t sizeClass = SizeClass(size);
+		ThreadCache* cache = GetThreadCache();
+
+		// fast path, no synchronization
+		if (nullptr == cache->freeLists[sizeClass] && false == Refill(cache, sizeClass))
+		{
+			return nullptr;
+		}
+
+		FreeBlock* block = cache->freeLists[sizeClass];
+		cache->freeLists[sizeClass] = block->next;
+		--cache->freeCounts[sizeClass];
+
+		*(std::size_t*)block = sizeClass;
+
+		return (void*)((std::size_t)block + HEADER_SIZE);
+	}
+
+	void ThreadCacheAllocator::Free(void* ptr)
+	{
+		if (nullptr == ptr)
+		{
+			return;
+		}
+
+		void* block = (void*)((std::size_t)ptr - HEADER_SIZE);
+		const std::size_t sizeClass = *(std::size_t*)block;
+
+		if (LARGE_SIZE_CLASS == sizeClass)
+		{
+			std::lock_guard<std::mutex> lock(mCentralMutex);
+
+			mCentralAllocator.Free(block);
+			UpdateStatistics();
+
+			return;
+		}
+
+		assert(sizeClass < SIZE_CLASS_COUNT && "Corrupted header");
+
+		// the block goes to the cache of the current thread (not necessarily the one that allocated it)
+		ThreadCache* cache = GetThreadCache();
+
+		FreeBlock* freeBlock = (FreeBlock*)block;
+		freeBlock->next = cache->freeLists[sizeClass];
+		cache->freeLists[sizeClass] = freeBlock;
+		++cache->freeCounts[sizeClass];
+
+		if (cache->freeCounts[sizeClass] > MAX_CACHED_BLOCKS)
+		{
+			Return(cache, sizeClass);
+		}
+	}
+
+	float ThreadCacheAllocator::Fragmentation()
+	{
+		std::lock_guard<std::mutex> lock(mCentralMutex);
+
+		return mCentralAllocator.Fragmentation();
+	}
+
+	ThreadCacheAllocator::ThreadCache* ThreadCacheAllocator::GetThreadCache()
+	{
+		// the caches of the current thread, one for every allocator it used
+		static thread_local std::vector<std::pair<std::size_t, ThreadCache*>> threadCaches;
+
+		for (const std::pair<std::size_t, ThreadCache*>& threadCache : threadCaches)
+		{
+			if (threadCache.first == mId)
+			{
+				return threadCache.second;
+			}
+		}
+
+		// first use of this allocator from the current thread
+		ThreadCache* cache = new ThreadCache();
+		for (std::size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass)
+		{
+			cache->freeLists[sizeClass] = nullptr;
+			cache->freeCounts[sizeClass] = 0;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mCentralMutex);
+
+			mThreadCaches.push_back(cache);
+		}
+
+		threadCaches.push_back(std::make_pair(mId, cache));
+
+		return cache;
+	}
+
+	void ThreadCacheAllocator::ClearThreadCaches()
+	{
+		for (ThreadCache* cache : mThreadCaches)
+		{
+			for (std::size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass)
+			{
+				cache->freeLists[sizeClass] = nullptr;
+				cache->freeCounts[sizeClass] = 0;
+			}
+		}
+	}
+
+	bool ThreadCacheAllocator::Refill(ThreadCache* cache, const std::size_t sizeClass)
+	{
+		const std::size_t blockSize = SizeClassBlockSize(sizeClass);
+
+		std::lock_guard<std::mutex> lock(mCentralMutex);
+
+		for (std::size_t i = 0; i < BATCH_SIZE; ++i)
+		{
+			FreeBlock* block = (FreeBlock*)mCentralAllocator.Allocate(blockSize, HEADER_SIZE);
+			if (nullptr == block)
+			{
+				break;
+			}
+
+			block->next = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block;
+			++cache->freeCounts[sizeClass];
+		}
+
+		UpdateStatistics();
+
+		return nullptr != cache->freeLists[sizeClass];
+	}
+
+	void ThreadCacheAllocator::Return(ThreadCache* cache, const std::size_t sizeClass)
+	{
+		std::lock_guard<std::mutex> lock(mCentralMutex);
+
+		for (std::size_t i = 0; i < BATCH_SIZE; ++i)
+		{
+			FreeBlock* block = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block->next;
+			--cache->freeCounts[sizeClass];
+
+			mCentralAllocator.Free(block);
+		}
+
+		UpdateStatistics();
+	}
+
+	void ThreadCacheAllocator::UpdateStatistics()
+	{
+		mUsed = mCentralAllocator.Used();
+		mPeak = mCentralAllocator.Peak();
+	}
+}
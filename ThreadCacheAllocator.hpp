@@ -0,0 +1,83 @@
+#ifndef THREAD_CACHE_ALLOCATOR_HPP
+#define THREAD_CACHE_ALLOCATOR_HPP
+
+#include "Allocator.hpp"
+#include <cstddef> // size_t
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/*
+ThreadCacheAllocator - thread caching front-end for a shared (central) Allocator.
+Every thread gets its own cache with a free list per size class,
+so most of the small allocations/frees do not need any synchronization.
+The central allocator is locked only to move blocks in batches:
+- refill - an empty cache takes BATCH_SIZE blocks at once
+- return - a cache with too many free blocks gives BATCH_SIZE blocks back
+Big allocations (> MAX_SMALL_SIZE) go directly to the central allocator (under lock).
+
+Every block has a small header with its size class.
+Used()/Peak() are the ones of the central allocator, the blocks kept by the caches count as used.
+
+NOTE:
+- the central allocator must support Free() (e.g. PoolAllocator, FreeListAllocator, BuddyAllocator)
+- the caches of the finished threads are kept until Reset() or the destruction of the allocator
+- Init()/Reset() and the destruction must not run concurrently with Allocate()/Free()
+*/
+
+namespace SDA
+{
+	class ThreadCacheAllocator : public Allocator
+	{
+	public:
+		ThreadCacheAllocator(Allocator& centralAllocator);
+		virtual ~ThreadCacheAllocator();
+
+		void Init();
+		void Reset();
+
+		void* Allocate(const std::size_t size, const std::size_t alignment = 0);
+		void Free(void* ptr);
+
+		float Fragmentation();
+
+		static const std::size_t SIZE_CLASS_GRANULARITY = 16;
+		static const std::size_t MAX_SMALL_SIZE = 256;
+		static const std::size_t SIZE_CLASS_COUNT = MAX_SMALL_SIZE / SIZE_CLASS_GRANULARITY;
+		static const std::size_t BATCH_SIZE = 32;
+		static const std::size_t MAX_CACHED_BLOCKS = 2 * BATCH_SIZE; // per size class
+
+	private:
+		NON_COPY_AND_MOVE(ThreadCacheAllocator)
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct ThreadCache
+		{
+			FreeBlock* freeLists[SIZE_CLASS_COUNT];
+			std::size_t freeCounts[SIZE_CLASS_COUNT];
+		};
+
+		ThreadCache* GetThreadCache();
+		void ClearThreadCaches(); // called under lock
+
+		bool Refill(ThreadCache* cache, const std::size_t sizeClass);
+		void Return(ThreadCache* cache, const std::size_t sizeClass);
+
+		// keeps Used()/Peak() in sync with the central allocator, called under lock
+		void UpdateStatistics();
+
+		Allocator& mCentralAllocator;
+		std::mutex mCentralMutex;
+
+		std::vector<ThreadCache*> mThreadCaches; // guarded by mCentralMutex
+		const std::size_t mId; // identifies the caches of this allocator in every thread
+
+		static std::atomic<std::size_t> sNextId;
+	};
+}
+
+#endif /* THREAD_CACHE_ALLOCATOR_HPP */
\ No newline at end of file
@@ -1,16 +1,24 @@
 #include "Timer.hpp"
+#include "TimerWheel.hpp"
 #include <cmath>
 #include <iostream>
 
 namespace SDA
 {
 	Timer::Timer(const OnTimeOutFunc& func, bool isRepeat, Timer::long_t timeOutInterval)
-		: mIsRunning(false), mIsRepeat(isRepeat), mTimeOutInterval(timeOutInterval)
-		, mStartTime(), mEndTime(), mWorker(), mOnTimeOut(func)
+		: mStartTime(0), mEndTime(0), mClockSource(CLOCK_STEADY), mIsRunning(false), mIsRepeat(isRepeat)
+		, mTimeOutInterval(timeOutInterval), mWorker(), mOnTimeOut(func)
+		, mWheel(nullptr), mWheelTimerId(0)
 	{
 		mWorker = std::thread([this] { Run(); });
 	}
 
+	Timer::Timer(TimerWheel& wheel, const OnTimeOutFunc& func, bool isRepeat, Timer::long_t timeOutInterval)
+		: mStartTime(0), mEndTime(0), mClockSource(CLOCK_STEADY), mIsRunning(false), mIsRepeat(isRepeat)
+		, mTimeOutInterval(timeOutInterval), mWorker(), mOnTimeOut(func)
+		, mWheel(&wheel), mWheelTimerId(0)
+	{}
+
 	Timer::~Timer()
 	{
 		// we let it run until it finishes
@@ -20,6 +28,12 @@ namespace SDA
 
 		if (mWorker.joinable())
 			mWorker.join();
+
+		if (mWheel)
+		{
+			// also waits if the callback is running right now, it uses this
+			mWheel->Cancel(mWheelTimerId);
+		}
 	}
 
 	void Timer::Start()
@@ -27,8 +41,26 @@ namespace SDA
 		if (mIsRunning)
 			return;
 
+		mStartTime = ClockNow(mClockSource);
 		mIsRunning = true;
-		mStartTime = std::chrono::high_resolution_clock::now();
+
+		if (mWheel && mOnTimeOut)
+		{
+			// same behaviour as Run(), but driven by the wheel thread
+			mWheelTimerId = mWheel->Schedule(mTimeOutInterval, [this]()
+			{
+				mOnTimeOut();
+
+				if (mIsRepeat)
+				{
+					mStartTime = ClockNow(mClockSource);
+				}
+				else
+				{
+					Stop();
+				}
+			}, mIsRepeat);
+		}
 
 	//	std::cout << "Timer Start!" << std::endl;
 	}
@@ -50,11 +82,17 @@ namespace SDA
 
 	void Timer::Stop()
 	{
-		if (false == mIsRunning)
+		// Stop() may be called by the user and by the timeout callback at the same time, only one goes on
+		if (false == mIsRunning.exchange(false))
 			return;
 
-		mEndTime = std::chrono::high_resolution_clock::now();
-		mIsRunning = false;
+		mEndTime = ClockNow(mClockSource);
+
+		if (mWheel)
+		{
+			// waits for the callback if it is running on the wheel thread
+			mWheel->Cancel(mWheelTimerId);
+		}
 
 	//	std::cout << "Timer Stop!" << std::endl;
 	}
@@ -65,7 +103,7 @@ namespace SDA
 		{
 			// Timeout
 
-			double timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - mStartTime).count();
+			double timeDiff = static_cast<double>((ClockNow(mClockSource) - mStartTime) / 1000000);
 	
 			if (timeDiff >= static_cast<double>(mTimeOutInterval))
 			{
@@ -74,7 +112,7 @@ namespace SDA
 
 				if (mIsRepeat)
 				{
-					mStartTime = std::chrono::high_resolution_clock::now();
+					mStartTime = ClockNow(mClockSource);
 				}
 				else
 				{
@@ -86,28 +124,28 @@ namespace SDA
 
 	Timer::long_t Timer::ElapsedTimeInNanoseconds()
 	{
-		Timer::long_t elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mEndTime - mStartTime).count();
+		Timer::long_t elapsedTime = static_cast<Timer::long_t>(mEndTime - mStartTime);
 
 		return elapsedTime;
 	}
 
 	Timer::long_t Timer::ElapsedTimeInMicroseconds()
 	{
-		Timer::long_t elapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(mEndTime - mStartTime).count();
+		Timer::long_t elapsedTime = static_cast<Timer::long_t>(mEndTime - mStartTime) / 1000;
 
 		return elapsedTime;
 	}
 
 	Timer::long_t Timer::ElapsedTimeInMiliseconds()
 	{
-		Timer::long_t elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(mEndTime - mStartTime).count();
+		Timer::long_t elapsedTime = static_cast<Timer::long_t>(mEndTime - mStartTime) / 1000000;
 
 		return elapsedTime;
 	}
 
 	Timer::long_t Timer::ElapsedTimeInSeconds()
 	{
-		Timer::long_t elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(mEndTime - mStartTime).count();
+		Timer::long_t elapsedTime = static_cast<Timer::long_t>(mEndTime - mStartTime) / 1000000000;
 
 		return elapsedTime;
 	}
@@ -126,4 +164,20 @@ namespace SDA
 	{
 		return mTimeOutInterval;
 	}
+
+	void Timer::SetClockSource(const ClockSource clockSource)
+	{
+		// the TSC is calibrated now and not in the middle of a measurement
+		if (CLOCK_TSC == clockSource)
+		{
+			TscClock::IsAvailable();
+		}
+
+		mClockSource = clockSource;
+	}
+
+	ClockSource Timer::GetClockSource() const
+	{
+		return mClockSource;
+	}
 }
\ No newline at end of file
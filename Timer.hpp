@@ -2,17 +2,22 @@
 #define TIMER_HPP
 
 #include "ClassHelper.h"
+#include "Clock.hpp"
 #include <chrono>
 #include <thread>
 #include <functional>
 #include <cstddef> // size_t
+#include <cstdint>
+#include <atomic>
 // IMPLEMENT SOMETHING PLATFORM INDEPENDENT
-// Non-multi thread safe!
+// The state shared with the worker/wheel thread is atomic, the rest is not multi thread safe!
 // More info: https://github.com/eglimi/cpptime/blob/master/cpptime.h
 
 
 namespace SDA
 {
+	class TimerWheel;
+
 	class Timer
 	{
 	public:
@@ -20,6 +25,8 @@ namespace SDA
 		typedef std::function<void()> OnTimeOutFunc;
 
 		Timer(const OnTimeOutFunc& func = {}, bool isRepeat = false, Timer::long_t timeOutInterval = DEFAULT_TIMEOUT_INTERVAL);
+		// the timeout is scheduled on the wheel, no thread of its own
+		Timer(TimerWheel& wheel, const OnTimeOutFunc& func, bool isRepeat = false, Timer::long_t timeOutInterval = DEFAULT_TIMEOUT_INTERVAL);
 		virtual ~Timer();
 
 		void Start();
@@ -35,17 +42,26 @@ namespace SDA
 		bool IsRepeat() const;
 		Timer::long_t TimeoutInterval() const;
 
+		// CLOCK_TSC is much cheaper to read, for short measurements
+		void SetClockSource(const ClockSource clockSource);
+		ClockSource GetClockSource() const;
+
 	private:
 		NON_COPY_AND_MOVE(Timer)
 
-		std::chrono::time_point<std::chrono::high_resolution_clock> mStartTime, mEndTime;
-		bool mIsRunning;
+		// written by the timeout callback on the worker/wheel thread too
+		std::atomic<std::uint64_t> mStartTime, mEndTime; // nanoseconds
+		std::atomic<ClockSource> mClockSource; // read by the worker thread
+		std::atomic<bool> mIsRunning;
 		bool mIsRepeat;
 		Timer::long_t mTimeOutInterval;
 
 		std::thread mWorker;
 		OnTimeOutFunc mOnTimeOut;
 
+		TimerWheel* mWheel; // not owned
+		std::atomic<std::uint64_t> mWheelTimerId; // the last scheduled, ~Timer() waits for its callback
+
 		static const Timer::long_t DEFAULT_TIMEOUT_INTERVAL = 1000; // miliseconds
 
 		void Run();
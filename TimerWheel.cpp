@@ -0,0 +1,357 @@
+#include "TimerWheel.hpp"
+#include <chrono>
+#include <algorithm> // min
+#include <cassert>
+
+namespace SDA
+{
+	// bound to a const reference by std::vector, so it needs a definition
+	const std::uint32_t TimerWheel::INVALID_INDEX;
+
+	TimerWheel::TimerWheel(const Timer::long_t tickInterval)
+		: mNodes(), mFreeNodes(INVALID_INDEX), mSlots(LEVEL_COUNT * SLOT_COUNT, INVALID_INDEX)
+		, mCurrentTick(0), mSize(0), mTickInterval(tickInterval), mMutex(), mCondition()
+		, mWorker(), mIsRunning(false), mBatch(), mRunningId(0), mRunningThread(), mCallbackDone()
+	{
+		assert(tickInterval > 0);
+	}
+
+	TimerWheel::~TimerWheel()
+	{
+		Stop();
+	}
+
+	void TimerWheel::Start()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (mIsRunning)
+		{
+			return;
+		}
+
+		mIsRunning = true;
+		mWorker = std::thread([this] { Run(); });
+	}
+
+	void TimerWheel::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mIsRunning = false;
+		}
+		mCondition.notify_all();
+
+		// a callback may stop the wheel, the thread can't join itself
+		if (mWorker.joinable() && std::this_thread::get_id() != mWorker.get_id())
+		{
+			mWorker.join();
+		}
+	}
+
+	bool TimerWheel::IsRunning() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		return mIsRunning;
+	}
+
+	TimerWheel::TimerId TimerWheel::Schedule(const Timer::long_t delay, const CallbackFunc& callback, const bool isRepeat)
+	{
+		assert(delay >= 0);
+
+		// at least one tick, the current one is already being processed
+		const std::uint64_t delayTicks = std::max<std::uint64_t>(1, (delay + mTickInterval - 1) / mTickInterval);
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		const std::uint32_t index = NewNode();
+		Node& node = mNodes[index];
+		node.callback = callback;
+		node.expires = mCurrentTick + delayTicks;
+		node.interval = isRepeat ? delayTicks : 0;
+
+		Insert(index);
+		++mSize;
+
+		return MakeId(node.generation, index);
+	}
+
+	bool TimerWheel::Cancel(const TimerId id)
+	{
+		const std::uint32_t index = (std::uint32_t)(id & 0xFFFFFFFF);
+		const std::uint32_t generation = (std::uint32_t)(id >> 32);
+
+		if (0 == id)
+		{
+			return false;
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+
+		bool isCancelled = false;
+		if (index < mNodes.size() && mNodes[index].generation == generation && INVALID_INDEX != mNodes[index].slot)
+		{
+			Unlink(index);
+			DeleteNode(index);
+			--mSize;
+			isCancelled = true;
+		}
+
+		// expired, but not called yet
+		for (Expired& expired : mBatch)
+		{
+			if (expired.id == id)
+			{
+				expired.id = 0;
+				isCancelled = true;
+			}
+		}
+
+		// being called by another thread, the caller may free what the callback uses as soon as we return
+		// (a callback cancelling its own timer doesn't wait for itself)
+		const std::thread::id thisThread = std::this_thread::get_id();
+		mCallbackDone.wait(lock, [this, id, thisThread] { return mRunningId != id || mRunningThread == thisThread; });
+
+		return isCancelled;
+	}
+
+	std::size_t TimerWheel::Advance(const std::size_t tickCount)
+	{
+		std::size_t firedCount = 0;
+
+		std::unique_lock<std::mutex> lock(mMutex);
+
+		for (std::size_t tick = 0; tick < tickCount; ++tick)
+		{
+			Tick(mBatch);
+
+			// the callbacks run without the lock, they may use the wheel
+			// (Cancel() may clear the ids of the next ones meanwhile)
+			for (std::size_t i = 0; i < mBatch.size(); ++i)
+			{
+				if (0 == mBatch[i].id || !mBatch[i].callback)
+				{
+					continue;
+				}
+
+				CallbackFunc callback = std::move(mBatch[i].callback);
+				mRunningId = mBatch[i].id;
+				mRunningThread = std::this_thread::get_id();
+
+				lock.unlock();
+				callback();
+				lock.lock();
+
+				mRunningId = 0;
+				mCallbackDone.notify_all();
+				++firedCount;
+			}
+
+			mBatch.clear();
+		}
+
+		return firedCount;
+	}
+
+	std::size_t TimerWheel::Size() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		return mSize;
+	}
+
+	Timer::long_t TimerWheel::TickInterval() const
+	{
+		return mTickInterval;
+	}
+
+	TimerWheel::TimerId TimerWheel::MakeId(const std::uint32_t generation, const std::uint32_t index)
+	{
+		return ((TimerId)generation << 32) | index;
+	}
+
+	std::uint32_t TimerWheel::NewNode()
+	{
+		std::uint32_t index = mFreeNodes;
+		if (INVALID_INDEX != index)
+		{
+			mFreeNodes = mNodes[index].next;
+		}
+		else
+		{
+			index = (std::uint32_t)mNodes.size();
+			mNodes.emplace_back();
+			mNodes[index].generation = 1; // so that no id is 0
+		}
+
+		Node& node = mNodes[index];
+		node.prev = INVALID_INDEX;
+		node.next = INVALID_INDEX;
+		node.slot = INVALID_INDEX;
+
+		return index;
+	}
+
+	void TimerWheel::DeleteNode(const std::uint32_t index)
+	{
+		Node& node = mNodes[index];
+		node.callback = nullptr;
+		node.slot = INVALID_INDEX;
+		++node.generation; // the old id is not valid anymore
+		if (0 == node.generation)
+		{
+			node.generation = 1;
+		}
+
+		node.next = mFreeNodes;
+		mFreeNodes = index;
+	}
+
+	void TimerWheel::Insert(const std::uint32_t index)
+	{
+		Node& node = mNodes[index];
+
+		// the first level which covers the delay
+		const std::uint64_t delay = (node.expires > mCurrentTick) ? node.expires - mCurrentTick : 0;
+
+		std::size_t level = 0;
+		while (level < LEVEL_COUNT - 1 && delay >= ((std::uint64_t)1 << ((level + 1) * SLOT_BITS)))
+		{
+			++level;
+		}
+
+		// longer than the whole wheel: parked in the last slot reached, cascaded again later
+		std::uint64_t expires = node.expires;
+		const std::uint64_t maxDelay = ((std::uint64_t)1 << (LEVEL_COUNT * SLOT_BITS)) - 1;
+		if (delay > maxDelay)
+		{
+			expires = mCurrentTick + maxDelay;
+		}
+
+		const std::size_t slot = level * SLOT_COUNT + ((expires >> (level * SLOT_BITS)) & (SLOT_COUNT - 1));
+
+		// push front
+		node.slot = (std::uint32_t)slot;
+		node.prev = INVALID_INDEX;
+		node.next = mSlots[slot];
+		if (INVALID_INDEX != node.next)
+		{
+			mNodes[node.next].prev = index;
+		}
+		mSlots[slot] = index;
+	}
+
+	void TimerWheel::Unlink(const std::uint32_t index)
+	{
+		Node& node = mNodes[index];
+
+		if (INVALID_INDEX != node.prev)
+		{
+			mNodes[node.prev].next = node.next;
+		}
+		else
+		{
+			mSlots[node.slot] = node.next;
+		}
+
+		if (INVALID_INDEX != node.next)
+		{
+			mNodes[node.next].prev = node.prev;
+		}
+
+		node.prev = INVALID_INDEX;
+		node.next = INVALID_INDEX;
+		node.slot = INVALID_INDEX;
+	}
+
+	void TimerWheel::Cascade(const std::size_t level)
+	{
+		// the timers of the current slot of this level move to the finer levels
+		const std::size_t slot = level * SLOT_COUNT + ((mCurrentTick >> (level * SLOT_BITS)) & (SLOT_COUNT - 1));
+
+		std::uint32_t index = mSlots[slot];
+		mSlots[slot] = INVALID_INDEX;
+
+		while (INVALID_INDEX != index)
+		{
+			const std::uint32_t next = mNodes[index].next;
+			Insert(index);
+			index = next;
+		}
+	}
+
+	void TimerWheel::Tick(std::vector<Expired>& batch)
+	{
+		++mCurrentTick;
+
+		// a full turn of a level moves one slot of the next level down
+		for (std::size_t level = 1; level < LEVEL_COUNT; ++level)
+		{
+			if (0 != (mCurrentTick & (((std::uint64_t)1 << (level * SLOT_BITS)) - 1)))
+			{
+				break;
+			}
+			Cascade(level);
+		}
+
+		// cascading may also have put timers in this slot, all of them expire now
+		const std::size_t slot = mCurrentTick & (SLOT_COUNT - 1);
+
+		std::uint32_t index = mSlots[slot];
+		mSlots[slot] = INVALID_INDEX;
+
+		while (INVALID_INDEX != index)
+		{
+			Node& node = mNodes[index];
+			const std::uint32_t next = node.next;
+
+			node.prev = INVALID_INDEX;
+			node.next = INVALID_INDEX;
+			node.slot = INVALID_INDEX;
+
+			if (node.interval > 0)
+			{
+				// the id stays the same, so a repeat timer can be cancelled
+				batch.push_back(Expired{ MakeId(node.generation, index), node.callback });
+
+				node.expires = mCurrentTick + node.interval;
+				Insert(index);
+			}
+			else
+			{
+				batch.push_back(Expired{ MakeId(node.generation, index), std::move(node.callback) });
+
+				DeleteNode(index);
+				--mSize;
+			}
+
+			index = next;
+		}
+	}
+
+	void TimerWheel::Run()
+	{
+		const std::chrono::milliseconds tickInterval(mTickInterval);
+		std::chrono::steady_clock::time_point nextTick = std::chrono::steady_clock::now() + tickInterval;
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (mIsRunning)
+		{
+			// sleeps until the next tick, wakes up earlier only to stop
+			if (mCondition.wait_until(lock, nextTick, [this] { return false == mIsRunning; }))
+			{
+				break;
+			}
+
+			// catch up if the callbacks took longer than a tick
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			const std::size_t tickCount = 1 + (std::size_t)((now - nextTick) / tickInterval);
+			nextTick += tickInterval * tickCount;
+
+			lock.unlock();
+			Advance(tickCount);
+			lock.lock();
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include "ClassHelper.h"
+#include "Timer.hpp"
+#include <cstddef> // size_t
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*
+TimerWheel - one thread for any number of timeouts, instead of one spinning thread per Timer.
+
+Hierarchical timing wheel: LEVEL_COUNT wheels of SLOT_COUNT slots, every level is SLOT_COUNT times
+coarser than the previous one. A timer goes to the level which covers its delay and moves
+(cascades) to the finer levels as its time comes, so with a 1ms tick the wheels cover ~49 days
+(longer delays are cascaded again). The thread sleeps until the next tick, it does not spin.
+
+The timers of a slot are kept in an intrusive doubly linked list (indices in a node pool),
+the expired callbacks of a tick are collected under the lock and called in one batch without it,
+so the callbacks can Schedule()/Cancel() timers.
+Cancel() also drops an expired callback not called yet and waits for one being called right now,
+so after Cancel() returns the callback doesn't use what the caller is about to destroy.
+
+TIME COMPLEXITY:
+- Schedule = O(1)
+- Cancel = O(1)
+- Tick = O(1) + O(expired timers) + O(cascaded timers), every timer cascades at most LEVEL_COUNT times
+
+USAGES:
+	SDA::TimerWheel wheel; // 1ms tick
+	wheel.Start();
+	SDA::TimerWheel::TimerId id = wheel.Schedule(500, []() { std::cout << "Timeout!" << std::endl; });
+	wheel.Cancel(id);
+
+Without Start() the wheel is driven by hand with Advance(), e.g. from an existing loop.
+*/
+
+namespace SDA
+{
+	class TimerWheel
+	{
+	public:
+		typedef std::uint64_t TimerId; // 0 is never a valid id
+		typedef std::function<void()> CallbackFunc;
+
+		TimerWheel(const Timer::long_t tickInterval = DEFAULT_TICK_INTERVAL);
+		virtual ~TimerWheel();
+
+		// the wheel thread
+		void Start();
+		void Stop();
+		bool IsRunning() const;
+
+		// delay in miliseconds, rounded up to whole ticks; repeat timers run until cancelled
+		TimerId Schedule(const Timer::long_t delay, const CallbackFunc& callback, const bool isRepeat = false);
+		// returns false if the timer already fired (one shot) or was cancelled,
+		// waits if the callback is running on another thread
+		bool Cancel(const TimerId id);
+
+		// moves the time forward by tickCount ticks and runs the expired callbacks, returns how many ran
+		// only one thread at a time should advance the wheel (the wheel thread if it was started)
+		std::size_t Advance(const std::size_t tickCount = 1);
+
+		std::size_t Size() const; // outstanding timers
+		Timer::long_t TickInterval() const;
+
+	private:
+		NON_COPY_AND_MOVE(TimerWheel)
+
+		struct Node
+		{
+			CallbackFunc callback;
+			std::uint64_t expires; // tick
+			std::uint64_t interval; // ticks, 0 for one shot timers
+			std::uint32_t prev;
+			std::uint32_t next;
+			std::uint32_t generation; // part of the id, a cancelled id can't cancel a reused node
+			std::uint32_t slot; // level * SLOT_COUNT + slot, INVALID_INDEX if not in the wheel
+		};
+
+		// an expired timer waiting to be called
+		struct Expired
+		{
+			TimerId id; // 0 once cancelled
+			CallbackFunc callback;
+		};
+
+		static TimerId MakeId(const std::uint32_t generation, const std::uint32_t index);
+
+		// all called under lock
+		std::uint32_t NewNode();
+		void DeleteNode(const std::uint32_t index);
+		void Insert(const std::uint32_t index);
+		void Unlink(const std::uint32_t index);
+		void Cascade(const std::size_t level);
+		void Tick(std::vector<Expired>& batch);
+
+		void Run();
+
+		std::vector<Node> mNodes;
+		std::uint32_t mFreeNodes;
+		std::vector<std::uint32_t> mSlots; // LEVEL_COUNT * SLOT_COUNT list heads
+		std::uint64_t mCurrentTick;
+		std::size_t mSize;
+
+		Timer::long_t mTickInterval;
+		mutable std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::thread mWorker;
+		bool mIsRunning;
+
+		// filled by the thread advancing the wheel, changed only under lock
+		std::vector<Expired> mBatch;
+		TimerId mRunningId; // the callback being called, 0 if none
+		std::thread::id mRunningThread;
+		std::condition_variable mCallbackDone;
+
+		static const std::size_t SLOT_BITS = 8;
+		static const std::size_t SLOT_COUNT = 1 << SLOT_BITS;
+		static const std::size_t LEVEL_COUNT = 4;
+		static const std::uint32_t INVALID_INDEX = 0xFFFFFFFF;
+		static const Timer::long_t DEFAULT_TICK_INTERVAL = 1; // miliseconds
+	};
+}
+
+#endif /* TIMER_WHEEL_HPP */
\ No newline at end of file
@@ -1,11 +1,15 @@
 #ifndef UTILITY_HPP
 #define UTILITY_HPP
 
+#include <cstddef> // size_t
 #include <utility> // std::move()
-#include "Vector.hpp"
 
 namespace SDA
 {
+	// Vector.hpp includes this header, the declaration is enough for Min() and Max()
+	template <class T>
+	class Vector;
+
 	template <class T>
 	void Swap(T& t1, T& t2)
 	{
@@ -2,9 +2,9 @@
 #define VECTOR_HPP
 
 #include "Utility.hpp"
+#include "VectorBase.hpp"
 #include <cstddef> // size_t
 #include <utility> // std::move()
-#include <cassert>
 #include <iostream>
 
 /*
@@ -20,6 +20,14 @@ TIME COMPLEXITY:
 SPACE COMPLEXITY:
 - O(N) as we use a contiguos memory space to allocate the vector elements
 
+STORAGE:
+- the buffer is raw memory, only the first Size() slots hold constructed elements (placement new),
+so growing doesn't default construct the free slots
+- trivially copyable elements are relocated with realloc()/memcpy() instead of one move per element
+- EmplaceBack()/Emplace() construct the element in place, PushBack(T&&)/Insert(T&&) move it,
+Append() reserves once for a forward range
+- the element management is shared with SmallVector (VectorBase.hpp), Vector only owns a heap buffer
+
 ADVANTAGES:
  - fast indexing of an element
  - fast traversal
@@ -43,59 +51,37 @@ namespace SDA
 {
 	/* Vector container - dynamic size */
 	template <class T>
-	class Vector
+	class Vector : public VectorBase<T, Vector<T>>
 	{
 	public:
-		Vector();
-		Vector(size_t size);
-		Vector(size_t size, const T& val);
+		// nullptr allocator means the global heap
+		Vector(Allocator* allocator = nullptr);
+		Vector(size_t size, Allocator* allocator = nullptr);
+		Vector(size_t size, const T& val, Allocator* allocator = nullptr);
 		Vector(const Vector<T>& vec);
-		Vector(Vector<T>&& vec);
+		Vector(Vector<T>&& vec) noexcept;
 		virtual ~Vector();
 
 		Vector<T>& operator =(const Vector<T>& vec);
-		Vector<T>& operator =(Vector<T>&& vec);
-
-		T& operator [](size_t index);
-		const T& operator [](size_t index) const;
-		T& At(size_t index);
-		const T& At(size_t index) const;
-
-		T& Front();
-		const T& Front() const;
-		T& Back();
-		const T& Back() const;
-
-		bool IsEmpty() const;
-		bool IsFull() const;
-
-		size_t Capacity() const;
-		size_t Size() const;
-
-		void Insert(size_t index, const T& val);
-		void Erase(size_t index);
-
-		void PushBack(const T& val);
-		void PopBack();
-
-		void Reserve(size_t capacity);
-		void Resize(size_t size);
+		Vector<T>& operator =(Vector<T>&& vec) noexcept;
 
 		void Swap(Vector<T>& vec);
 
-		T* GetData();
-		const T* GetData() const;
-
 	private:
+		typedef VectorBase<T, Vector<T>> Base;
+		friend Base;
+
+		using Base::mBuffer;
+		using Base::mCapacity;
+		using Base::mSize;
+		using Base::mAllocator;
+
 		void Copy(const Vector<T>& vec);
 		void Move(Vector<T>&& vec);
 		void Destroy();
 
-		T* mBuffer;
-		size_t mCapacity; //at least double of the size
-		size_t mSize;
-
-		static const size_t ORDER_OF_GROWTH = 2;
+		// the buffer is always from the allocator (or nullptr)
+		bool IsHeapBuffer() const;
 	};
 }
 
@@ -111,38 +97,36 @@ namespace SDA
 	 */
 
 	template <class T>
-	Vector<T>::Vector()
-		: mCapacity(0), mSize(0), mBuffer(nullptr) //avoid nullptr buffer
+	Vector<T>::Vector(Allocator* allocator)
+		: Base(nullptr, 0, allocator) //avoid nullptr buffer
 	{}
 
 	template <class T>
-	Vector<T>::Vector(size_t size)
-		: mCapacity(size * ORDER_OF_GROWTH), mSize(size)
+	Vector<T>::Vector(size_t size, Allocator* allocator)
+		: Base(nullptr, 0, allocator)
 	{
-		mBuffer = new T[mCapacity];
+		this->Resize(size);
 	}
 
 	template <class T>
-	Vector<T>::Vector(size_t size, const T& val)
-		: Vector(size)
+	Vector<T>::Vector(size_t size, const T& val, Allocator* allocator)
+		: Base(nullptr, 0, allocator)
 	{
-		for (size_t i = 0; i < mSize; ++i)
-		{
-			// create element via placement new()
-			new (mBuffer + i) T(val);
-		}
+		this->Fill(size, val);
 	}
 
 	template <class T>
 	Vector<T>::Vector(const Vector<T>& vec)
+		: Base(nullptr, 0, vec.mAllocator) // the copy uses the same allocator
 	{
 		Copy(vec);
 	}
 
 	template <class T>
-	Vector<T>::Vector(Vector<T>&& vec)
+	Vector<T>::Vector(Vector<T>&& vec) noexcept
+		: Base(nullptr, 0, vec.mAllocator)
 	{
-		Move(vec);
+		Move(std::move(vec));
 	}
 
 	template <class T>
@@ -154,23 +138,7 @@ namespace SDA
 	template <class T>
 	void Vector<T>::Copy(const Vector<T>& vec)
 	{
-		if (this != &vec)
-		{
-			// delete the old buffer
-			Destroy();
-
-			mCapacity = vec.mCapacity;
-			mSize = vec.mSize;
-
-			mBuffer = new T[mCapacity];
-
-			for (size_t i = 0; i < mSize; ++i)
-			{
-				// here we copy the elements as we do not want
-				// to invalidate vec elements by moving them to this vec 
-				mBuffer[i] = vec.mBuffer[i];
-			}
-		}
+		this->CopyElements(vec);
 	}
 
 	template <class T>
@@ -184,8 +152,9 @@ namespace SDA
 			mCapacity = vec.mCapacity;
 			mSize = vec.mSize;
 
-			// just copy the pointer
+			// just copy the pointer, the buffer is freed with the allocator of vec
 			mBuffer = vec.mBuffer;
+			mAllocator = vec.mAllocator;
 
 			// vec is invalidated after move
 			vec.mBuffer = nullptr;
@@ -197,258 +166,29 @@ namespace SDA
 	template <class T>
 	void Vector<T>::Destroy()
 	{
-		if (mBuffer)
-		{
-			delete[] mBuffer;
-		}
-
-		mCapacity = 0;
-		mSize = 0;
+		this->ReleaseBuffer(nullptr, 0);
 	}
 
 	template <class T>
-	Vector<T>& Vector<T>::operator =(const Vector<T>& vec)
+	bool Vector<T>::IsHeapBuffer() const
 	{
-		Copy(vec);
-
-		return *this;
+		return true;
 	}
 
 	template <class T>
-	Vector<T>& Vector<T>::operator =(Vector<T>&& vec)
+	Vector<T>& Vector<T>::operator =(const Vector<T>& vec)
 	{
-		Move(vec);
+		Copy(vec);
 
 		return *this;
 	}
 
 	template <class T>
-	T& Vector<T>::operator [](size_t index)
-	{
-		assert(index < mSize);
-
-		return mBuffer[index];
-	}
-
-	template <class T>
-	const T& Vector<T>::operator [](size_t index) const
-	{
-		assert(index < mSize);
-
-		return mBuffer[index];
-	}
-
-	template <class T>
-	T& Vector<T>::At(size_t index)
-	{
-		return operator [](index);
-	}
-
-	template <class T>
-	const T& Vector<T>::At(size_t index) const
-	{
-		return operator [](index);
-	}
-
-	template <class T>
-	T& Vector<T>::Front()
-	{
-		assert(mSize > 0);
-
-		return mBuffer[0];
-	}
-
-	template <class T>
-	const T& Vector<T>::Front() const
-	{
-		assert(mSize > 0);
-
-		return mBuffer[0];
-	}
-
-	template <class T>
-	T& Vector<T>::Back()
-	{
-		assert(mSize > 0);
-
-		return mBuffer[mSize - 1];
-	}
-
-	template <class T>
-	const T& Vector<T>::Back() const
-	{
-		assert(mSize > 0);
-
-		return mBuffer[mSize - 1];
-	}
-
-	template <class T>
-	bool Vector<T>::IsEmpty() const
-	{
-		return mSize == 0;
-	}
-
-	template <class T>
-	bool Vector<T>::IsFull() const
-	{
-		return mSize == mCapacity;
-	}
-
-
-	template <class T>
-	size_t Vector<T>::Capacity() const
-	{
-		return mCapacity;
-	}
-
-	template <class T>
-	size_t Vector<T>::Size() const
-	{
-		return mSize;
-	}
-
-	template <class T>
-	void Vector<T>::Insert(size_t index, const T& val)
-	{
-		assert(index < mSize);
-
-		// check if we have to reallocate
-		if (mSize + 1 > mCapacity)
-		{
-			Reserve(mCapacity * ORDER_OF_GROWTH);
-		}
-
-		// shift the other elements to make free one slot for the new one
-		if (index == 0) // the first
-		{
-			// shift elements to right with 1 position
-			for (size_t i = mSize - 1; i > 0; --i)
-			{
-				// better move them then copy
-				mBuffer[i + 1] = std::move(mBuffer[i]);
-			}
-		}
-		else if (index == mSize - 1) // the last
-		{
-			// nothing to do 
-		}
-		else // in between
-		{
-			// shift elements after the required position to right with 1 position
-			for (size_t i = mSize - index; i > index; --i)
-			{
-				// better move them then copy
-				mBuffer[i + 1] = std::move(mBuffer[i]);
-			}
-		}
-		// add the new element
-		mBuffer[index] = val;
-
-		++mSize;
-	}
-
-	template <class T>
-	void Vector<T>::Erase(size_t index)
-	{
-		assert(index < mSize);
-
-		// shift the other elements thus deleting the required one
-		if (index == 0) // the first
-		{
-			// destroy the element
-			mBuffer[0].~T();
-
-			// shift elements to left with 1 position
-			for (size_t i = 0; i < mSize; ++i)
-			{
-				// better move them then copy
-				mBuffer[i] = std::move(mBuffer[i + 1]);
-			}
-		}
-		else if (index == mSize - 1) // the last
-		{
-			// destroy the element
-			mBuffer[mSize - 1].~T();
-		}
-		else // in between
-		{
-			// destroy the element
-			mBuffer[index].~T();
-
-			// shift elements after the required position to left with 1 position
-			for (size_t i = index; i < mSize - index; ++i)
-			{
-				// better move them then copy
-				mBuffer[i] = std::move(mBuffer[i + 1]);
-			}
-		}
-
-		--mSize;
-	}
-
-	template <class T>
-	void Vector<T>::PushBack(const T& val)
+	Vector<T>& Vector<T>::operator =(Vector<T>&& vec) noexcept
 	{
-		if (mSize == 0)
-		{
-			Reserve(2); // if empty resize for 2 elements
-		}
-		// we reserve new space if required by doubing the capacity
-		else if (mSize == mCapacity)
-		{
-			Reserve(2 * mCapacity);
-		}
-
-		mBuffer[mSize++] = val;
-	}
+		Move(std::move(vec));
 
-	template <class T>
-	void Vector<T>::PopBack()
-	{
-		assert(mSize > 0);
-
-		// destroy the last element as it is removed
-		mBuffer[mSize - 1].~T();
-
-		--mSize;
-	}
-
-	template <class T>
-	void Vector<T>::Reserve(size_t capacity)
-	{
-		// we reserve new space only if required
-		if (capacity > mCapacity)
-		{
-			// create the new buffer
-			T* newBuffer = new T[capacity];
-
-			// the elements from the old to the new one
-			for (size_t i = 0; i < mSize; ++i)
-			{
-				// better move them then copy
-				newBuffer[i] = std::move(mBuffer[i]);
-			}
-			size_t oldSize = mSize;
-
-			// free the old buffer
-			Destroy();
-
-			// update buffer, capacity and size
-			mBuffer = newBuffer;
-			mCapacity = capacity;
-			mSize = oldSize;
-		}
-	}
-
-	template <class T>
-	void Vector<T>::Resize(size_t size)
-	{
-		// resize only if required
-		if (size > mCapacity)
-		{
-			Reserve(size * ORDER_OF_GROWTH); // still double the capcity
-		}
-		mSize = size;
+		return *this;
 	}
 
 	template <class T>
@@ -459,18 +199,6 @@ namespace SDA
 //		SDA::Swap(mSize, vec.mSize);
 	}
 
-	template <class T>
-	T* Vector<T>::GetData()
-	{
-		return mBuffer;
-	}
-
-	template <class T>
-	const T* Vector<T>::GetData() const
-	{
-		return mBuffer;
-	}
-
 	/////////// INPUT & OUTPUT /////////////
 	template <class T>
 	std::ostream& operator << (std::ostream& out, const Vector<T>& vec)
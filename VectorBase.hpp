@@ -0,0 +1,562 @@
+#ifndef VECTOR_BASE_HPP
+#define VECTOR_BASE_HPP
+
+#include "AllocatorUtility.hpp"
+#ifdef SDA_PROFILING
+#include "Profiler.hpp" // SDA_PROFILE_ZONE
+#elif !defined(SDA_PROFILE_ZONE)
+#define SDA_PROFILE_ZONE(name) ((void)0)
+#endif
+#include <cstddef> // size_t
+#include <cstring> // memcpy(), memmove()
+#include <utility> // std::move(), std::forward()
+#include <iterator> // std::iterator_traits, std::distance()
+#include <type_traits>
+#include <cassert>
+
+/*
+VectorBase - the element management shared by Vector and SmallVector.
+
+The elements live in one contiguous raw buffer, only the first Size() slots hold constructed elements.
+Indexing, insertion, erasure, growth and relocation don't depend on where the buffer comes from,
+only the storage does, so it is the template parameter (CRTP, no virtual call):
+- Storage::IsHeapBuffer() - true when mBuffer came from the Allocator (or is nullptr),
+  so it may be grown with realloc() and must be freed.
+  Vector always owns its buffer, SmallVector doesn't own its inline buffer.
+- the empty buffer, Copy/Move and Swap stay in Storage.
+
+Not meant to be used directly, there is no public constructor.
+*/
+
+namespace SDA
+{
+	template <class T, class Storage>
+	class VectorBase
+	{
+	public:
+		T& operator [](size_t index);
+		const T& operator [](size_t index) const;
+		T& At(size_t index);
+		const T& At(size_t index) const;
+
+		T& Front();
+		const T& Front() const;
+		T& Back();
+		const T& Back() const;
+
+		bool IsEmpty() const;
+		bool IsFull() const;
+
+		size_t Capacity() const;
+		size_t Size() const;
+
+		void Insert(size_t index, const T& val);
+		void Insert(size_t index, T&& val);
+		// constructs the element from args at index, args may refer to an element of this vector
+		template <class... Args>
+		T& Emplace(size_t index, Args&&... args);
+		void Erase(size_t index);
+
+		void PushBack(const T& val);
+		void PushBack(T&& val);
+		// constructs the element from args at the end, args may refer to an element of this vector
+		template <class... Args>
+		T& EmplaceBack(Args&&... args);
+		// adds the elements of [first, last), which must not belong to this vector
+		template <class InputIt>
+		void Append(InputIt first, InputIt last);
+		void PopBack();
+
+		void Reserve(size_t capacity);
+		void Resize(size_t size);
+
+		T* GetData();
+		const T* GetData() const;
+
+		Allocator* GetAllocator() const;
+
+	protected:
+		VectorBase(T* buffer, size_t capacity, Allocator* allocator);
+		// the elements are destroyed by Storage, it knows which buffer to fall back to
+		~VectorBase();
+
+		// size copies of val, the vector must be empty
+		void Fill(size_t size, const T& val);
+		// copies the elements of vec, the current buffer is kept if it is big enough
+		void CopyElements(const VectorBase<T, Storage>& vec);
+		// destroys the elements, frees the heap buffer and switches to the empty one
+		void ReleaseBuffer(T* emptyBuffer, size_t emptyCapacity);
+
+		// the capacity PushBack() and Insert() grow to when the vector is full
+		size_t NextCapacity() const;
+		// moves the elements to newBuffer (the new element may already be there) and frees the old heap buffer
+		void Relocate(T* newBuffer, size_t capacity);
+		void DestroyElements(size_t first, size_t last);
+
+		bool IsHeapBuffer() const;
+
+		T* mBuffer; // raw memory, [0, mSize) are constructed
+		size_t mCapacity;
+		size_t mSize;
+
+		Allocator* mAllocator; // not owned
+
+		static const size_t ORDER_OF_GROWTH = 2;
+		static constexpr bool IS_TRIVIALLY_COPYABLE = std::is_trivially_copyable<T>::value;
+	};
+}
+
+/* As we do use templates we have to provie the definition in the header */
+//////////////// IMPLEMENTATION ////////////
+
+namespace SDA
+{
+	template <class T, class Storage>
+	VectorBase<T, Storage>::VectorBase(T* buffer, size_t capacity, Allocator* allocator)
+		: mBuffer(buffer), mCapacity(capacity), mSize(0), mAllocator(allocator)
+	{}
+
+	template <class T, class Storage>
+	VectorBase<T, Storage>::~VectorBase()
+	{}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Fill(size_t size, const T& val)
+	{
+		assert(0 == mSize);
+
+		Reserve(size);
+
+		for (; mSize < size; ++mSize)
+		{
+			// create element via placement new()
+			new (mBuffer + mSize) T(val);
+		}
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::CopyElements(const VectorBase<T, Storage>& vec)
+	{
+		if (this != &vec)
+		{
+			DestroyElements(0, mSize);
+			mSize = 0;
+
+			// the copy gets only the capacity it needs
+			Reserve(vec.mSize);
+
+			if constexpr (IS_TRIVIALLY_COPYABLE)
+			{
+				if (vec.mSize > 0)
+				{
+					std::memcpy(mBuffer, vec.mBuffer, vec.mSize * sizeof(T));
+				}
+				mSize = vec.mSize;
+			}
+			else
+			{
+				for (; mSize < vec.mSize; ++mSize)
+				{
+					// here we copy the elements as we do not want
+					// to invalidate vec elements by moving them to this vec
+					new (mBuffer + mSize) T(vec.mBuffer[mSize]);
+				}
+			}
+		}
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::ReleaseBuffer(T* emptyBuffer, size_t emptyCapacity)
+	{
+		DestroyElements(0, mSize);
+
+		if (IsHeapBuffer())
+		{
+			SDA::FreeArray(mAllocator, mBuffer);
+		}
+
+		mBuffer = emptyBuffer;
+		mCapacity = emptyCapacity;
+		mSize = 0;
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::DestroyElements(size_t first, size_t last)
+	{
+		if constexpr (false == std::is_trivially_destructible<T>::value)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				mBuffer[i].~T();
+			}
+		}
+	}
+
+	template <class T, class Storage>
+	bool VectorBase<T, Storage>::IsHeapBuffer() const
+	{
+		return static_cast<const Storage*>(this)->IsHeapBuffer();
+	}
+
+	template <class T, class Storage>
+	T& VectorBase<T, Storage>::operator [](size_t index)
+	{
+		assert(index < mSize);
+
+		return mBuffer[index];
+	}
+
+	template <class T, class Storage>
+	const T& VectorBase<T, Storage>::operator [](size_t index) const
+	{
+		assert(index < mSize);
+
+		return mBuffer[index];
+	}
+
+	template <class T, class Storage>
+	T& VectorBase<T, Storage>::At(size_t index)
+	{
+		return operator [](index);
+	}
+
+	template <class T, class Storage>
+	const T& VectorBase<T, Storage>::At(size_t index) const
+	{
+		return operator [](index);
+	}
+
+	template <class T, class Storage>
+	T& VectorBase<T, Storage>::Front()
+	{
+		assert(mSize > 0);
+
+		return mBuffer[0];
+	}
+
+	template <class T, class Storage>
+	const T& VectorBase<T, Storage>::Front() const
+	{
+		assert(mSize > 0);
+
+		return mBuffer[0];
+	}
+
+	template <class T, class Storage>
+	T& VectorBase<T, Storage>::Back()
+	{
+		assert(mSize > 0);
+
+		return mBuffer[mSize - 1];
+	}
+
+	template <class T, class Storage>
+	const T& VectorBase<T, Storage>::Back() const
+	{
+		assert(mSize > 0);
+
+		return mBuffer[mSize - 1];
+	}
+
+	template <class T, class Storage>
+	bool VectorBase<T, Storage>::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	template <class T, class Storage>
+	bool VectorBase<T, Storage>::IsFull() const
+	{
+		return mSize == mCapacity;
+	}
+
+	template <class T, class Storage>
+	size_t VectorBase<T, Storage>::Capacity() const
+	{
+		return mCapacity;
+	}
+
+	template <class T, class Storage>
+	size_t VectorBase<T, Storage>::Size() const
+	{
+		return mSize;
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Insert(size_t index, const T& val)
+	{
+		Emplace(index, val);
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Insert(size_t index, T&& val)
+	{
+		Emplace(index, std::move(val));
+	}
+
+	template <class T, class Storage>
+	template <class... Args>
+	T& VectorBase<T, Storage>::Emplace(size_t index, Args&&... args)
+	{
+		assert(index <= mSize);
+
+		if (index == mSize) // the last
+		{
+			return EmplaceBack(std::forward<Args>(args)...);
+		}
+
+		// args may refer to an element of this vector, the new element is created before the elements are shifted
+		T newVal(std::forward<Args>(args)...);
+
+		// check if we have to reallocate
+		if (mSize == mCapacity)
+		{
+			Reserve(NextCapacity());
+		}
+
+		// shift the other elements to make free one slot for the new one
+		if constexpr (IS_TRIVIALLY_COPYABLE)
+		{
+			std::memmove(mBuffer + index + 1, mBuffer + index, (mSize - index) * sizeof(T));
+			new (mBuffer + index) T(std::move(newVal));
+		}
+		else
+		{
+			// the slot after the last element is raw memory, the last element is constructed there
+			new (mBuffer + mSize) T(std::move(mBuffer[mSize - 1]));
+
+			// shift elements after the required position to right with 1 position
+			for (size_t i = mSize - 1; i > index; --i)
+			{
+				// better move them then copy
+				mBuffer[i] = std::move(mBuffer[i - 1]);
+			}
+
+			// add the new element
+			mBuffer[index] = std::move(newVal);
+		}
+
+		++mSize;
+
+		return mBuffer[index];
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Erase(size_t index)
+	{
+		assert(index < mSize);
+
+		// shift elements after the required position to left with 1 position, this overwrites the erased one
+		if constexpr (IS_TRIVIALLY_COPYABLE)
+		{
+			std::memmove(mBuffer + index, mBuffer + index + 1, (mSize - index - 1) * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = index; i + 1 < mSize; ++i)
+			{
+				// better move them then copy
+				mBuffer[i] = std::move(mBuffer[i + 1]);
+			}
+		}
+
+		// destroy the last element, it was moved to the left
+		DestroyElements(mSize - 1, mSize);
+
+		--mSize;
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::PushBack(const T& val)
+	{
+		EmplaceBack(val);
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::PushBack(T&& val)
+	{
+		EmplaceBack(std::move(val));
+	}
+
+	template <class T, class Storage>
+	template <class... Args>
+	T& VectorBase<T, Storage>::EmplaceBack(Args&&... args)
+	{
+		if (mSize < mCapacity)
+		{
+			new (mBuffer + mSize) T(std::forward<Args>(args)...);
+		}
+		else if constexpr (IS_TRIVIALLY_COPYABLE)
+		{
+			// args may refer to an element of this vector, realloc() could free it
+			T newVal(std::forward<Args>(args)...);
+
+			Reserve(NextCapacity());
+			new (mBuffer + mSize) T(newVal);
+		}
+		else
+		{
+			const size_t capacity = NextCapacity();
+			T* newBuffer = SDA::AllocateArray<T>(mAllocator, capacity);
+
+			// the new element is created before the old ones are moved, as args may refer to one of them
+			try
+			{
+				new (newBuffer + mSize) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				SDA::FreeArray(mAllocator, newBuffer);
+				throw;
+			}
+
+			Relocate(newBuffer, capacity);
+		}
+
+		return mBuffer[mSize++];
+	}
+
+	template <class T, class Storage>
+	template <class InputIt>
+	void VectorBase<T, Storage>::Append(InputIt first, InputIt last)
+	{
+		typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+
+		// a forward range can be measured, so the buffer grows at most once
+		if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value)
+		{
+			const size_t count = static_cast<size_t>(std::distance(first, last));
+
+			if (mSize + count > mCapacity)
+			{
+				const size_t grownCapacity = mCapacity * ORDER_OF_GROWTH;
+				Reserve(mSize + count > grownCapacity ? mSize + count : grownCapacity);
+			}
+
+			for (; first != last; ++first)
+			{
+				new (mBuffer + mSize) T(*first);
+				++mSize;
+			}
+		}
+		else
+		{
+			for (; first != last; ++first)
+			{
+				EmplaceBack(*first);
+			}
+		}
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::PopBack()
+	{
+		assert(mSize > 0);
+
+		// destroy the last element as it is removed
+		DestroyElements(mSize - 1, mSize);
+
+		--mSize;
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Reserve(size_t capacity)
+	{
+		// we reserve new space only if required, a SmallVector never shrinks back to its inline buffer
+		if (capacity > mCapacity)
+		{
+			SDA_PROFILE_ZONE("Vector::Reserve");
+
+			if constexpr (IS_TRIVIALLY_COPYABLE)
+			{
+				if (IsHeapBuffer())
+				{
+					// one realloc() or memcpy(), a big block can be remapped without copying
+					mBuffer = SDA::ReallocateArray<T>(mAllocator, mBuffer, mSize, capacity);
+					mCapacity = capacity;
+					return;
+				}
+			}
+
+			Relocate(SDA::AllocateArray<T>(mAllocator, capacity), capacity);
+		}
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Relocate(T* newBuffer, size_t capacity)
+	{
+		if constexpr (IS_TRIVIALLY_COPYABLE)
+		{
+			if (mSize > 0)
+			{
+				std::memcpy(newBuffer, mBuffer, mSize * sizeof(T));
+			}
+		}
+		else
+		{
+			// the elements from the old to the new one, one pass keeps the old element in cache for its destruction
+			for (size_t i = 0; i < mSize; ++i)
+			{
+				// better move them then copy
+				new (newBuffer + i) T(std::move(mBuffer[i]));
+				mBuffer[i].~T();
+			}
+		}
+
+		// only the heap buffer is freed
+		if (IsHeapBuffer())
+		{
+			SDA::FreeArray(mAllocator, mBuffer);
+		}
+
+		// update buffer and capacity, the size stays
+		mBuffer = newBuffer;
+		mCapacity = capacity;
+	}
+
+	template <class T, class Storage>
+	size_t VectorBase<T, Storage>::NextCapacity() const
+	{
+		// if empty resize for 2 elements, otherwise double the capacity
+		return (mCapacity == 0) ? 2 : mCapacity * ORDER_OF_GROWTH;
+	}
+
+	template <class T, class Storage>
+	void VectorBase<T, Storage>::Resize(size_t size)
+	{
+		// reallocate only if required, the capacity still grows geometrically
+		if (size > mCapacity)
+		{
+			Reserve(size > mCapacity * ORDER_OF_GROWTH ? size : mCapacity * ORDER_OF_GROWTH);
+		}
+
+		// the new elements are value initialized (0 for numbers), the removed ones are destroyed
+		for (; mSize < size; ++mSize)
+		{
+			new (mBuffer + mSize) T();
+		}
+
+		DestroyElements(size, mSize);
+		mSize = size;
+	}
+
+	template <class T, class Storage>
+	T* VectorBase<T, Storage>::GetData()
+	{
+		return mBuffer;
+	}
+
+	template <class T, class Storage>
+	const T* VectorBase<T, Storage>::GetData() const
+	{
+		return mBuffer;
+	}
+
+	template <class T, class Storage>
+	Allocator* VectorBase<T, Storage>::GetAllocator() const
+	{
+		return mAllocator;
+	}
+}
+
+#endif /* VECTOR_BASE_HPP */
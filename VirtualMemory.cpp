@@ -0,0 +1,231 @@
+#include "VirtualMemory.hpp"
+#include <algorithm> // min, max
+#include <cassert>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h> // sysconf()
+#endif
+
+namespace SDA
+{
+	VirtualMemoryArena::VirtualMemoryArena()
+		: mBase(nullptr), mReserved(0), mCommitted(0), mOptions()
+	{}
+
+	VirtualMemoryArena::~VirtualMemoryArena()
+	{
+		Release();
+	}
+
+	bool VirtualMemoryArena::Reserve(const std::size_t size, const VirtualMemoryOptions& options)
+	{
+		assert(size > 0);
+
+		Release();
+
+		mOptions = options;
+
+		// whole pages only
+		const std::size_t pageSize = options.useHugePages ? HUGE_PAGE_SIZE : PageSize();
+		const std::size_t reservedSize = ((size + pageSize - 1) / pageSize) * pageSize;
+
+#ifdef _WIN32
+		// large pages need special privileges on Windows, the option is ignored
+		void* base = VirtualAlloc(nullptr, reservedSize, MEM_RESERVE, PAGE_NOACCESS);
+		if (nullptr == base)
+		{
+			return false;
+		}
+#else
+		// prefault: all the pages are mapped and populated now, nothing to commit later
+		const int protection = options.prefault ? (PROT_READ | PROT_WRITE) : PROT_NONE;
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#ifdef MAP_POPULATE
+		if (options.prefault && false == options.useHugePages)
+		{
+			flags |= MAP_POPULATE;
+		}
+#endif
+
+		// mmap() gives only page alignment, a huge page needs a 2 MB aligned base:
+		// reserve 2 MB more and unmap the unaligned head and the rest of the tail
+		const std::size_t mappedSize = options.useHugePages ? reservedSize + HUGE_PAGE_SIZE : reservedSize;
+
+		void* mapped = mmap(nullptr, mappedSize, protection, flags, -1, 0);
+		if (MAP_FAILED == mapped)
+		{
+			return false;
+		}
+
+		void* base = mapped;
+		if (options.useHugePages)
+		{
+			const std::size_t head = (HUGE_PAGE_SIZE - (std::size_t)mapped % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+			const std::size_t tail = mappedSize - head - reservedSize;
+
+			base = (void*)((std::size_t)mapped + head);
+			if (head > 0)
+			{
+				munmap(mapped, head);
+			}
+			if (tail > 0)
+			{
+				munmap((void*)((std::size_t)base + reservedSize), tail);
+			}
+		}
+
+#ifdef MADV_HUGEPAGE
+		if (options.useHugePages)
+		{
+			madvise(base, reservedSize, MADV_HUGEPAGE);
+		}
+#endif
+
+		// MAP_POPULATE would fault the pages before madvise(), touch them now
+		if (options.prefault && options.useHugePages)
+		{
+			for (std::size_t offset = 0; offset < reservedSize; offset += pageSize)
+			{
+				((volatile char*)base)[offset] = 0;
+			}
+		}
+#endif
+
+		mBase = base;
+		mReserved = reservedSize;
+		mCommitted = 0;
+
+		if (options.prefault)
+		{
+			return Commit(reservedSize);
+		}
+
+		return true;
+	}
+
+	void VirtualMemoryArena::Release()
+	{
+		if (nullptr == mBase)
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		VirtualFree(mBase, 0, MEM_RELEASE);
+#else
+		munmap(mBase, mReserved);
+#endif
+
+		mBase = nullptr;
+		mReserved = 0;
+		mCommitted = 0;
+	}
+
+	bool VirtualMemoryArena::Commit(const std::size_t size)
+	{
+		if (size <= mCommitted)
+		{
+			return true;
+		}
+
+		if (size > mReserved)
+		{
+			return false;
+		}
+
+		// commit in big steps to make less system calls
+		const std::size_t granularity = std::max(mOptions.commitGranularity, mOptions.useHugePages ? HUGE_PAGE_SIZE : PageSize());
+		std::size_t newCommitted = std::min(((size + granularity - 1) / granularity) * granularity, mReserved);
+		if (mOptions.prefault)
+		{
+			newCommitted = mReserved;
+		}
+
+		void* address = (void*)((std::size_t)mBase + mCommitted);
+		const std::size_t length = newCommitted - mCommitted;
+
+#ifdef _WIN32
+		if (nullptr == VirtualAlloc(address, length, MEM_COMMIT, PAGE_READWRITE))
+		{
+			return false;
+		}
+
+		if (mOptions.prefault)
+		{
+			// touch every page
+			const std::size_t pageSize = PageSize();
+			for (std::size_t offset = 0; offset < length; offset += pageSize)
+			{
+				((volatile char*)address)[offset] = 0;
+			}
+		}
+#else
+		if (false == mOptions.prefault && 0 != mprotect(address, length, PROT_READ | PROT_WRITE))
+		{
+			return false;
+		}
+#endif
+
+		mCommitted = newCommitted;
+
+		return true;
+	}
+
+	void VirtualMemoryArena::Decommit()
+	{
+		if (nullptr == mBase || 0 == mCommitted)
+		{
+			return;
+		}
+
+#ifdef _WIN32
+		VirtualFree(mBase, mCommitted, MEM_DECOMMIT);
+		mCommitted = 0;
+#else
+		// the pages are dropped, they come back zeroed on the next touch
+		madvise(mBase, mCommitted, MADV_DONTNEED);
+
+		// a prefaulted arena stays mapped, otherwise we have to commit again
+		if (false == mOptions.prefault)
+		{
+			mprotect(mBase, mCommitted, PROT_NONE);
+			mCommitted = 0;
+		}
+#endif
+	}
+
+	void* VirtualMemoryArena::Base() const
+	{
+		return mBase;
+	}
+
+	std::size_t VirtualMemoryArena::Reserved() const
+	{
+		return mReserved;
+	}
+
+	std::size_t VirtualMemoryArena::Committed() const
+	{
+		return mCommitted;
+	}
+
+	const VirtualMemoryOptions& VirtualMemoryArena::Options() const
+	{
+		return mOptions;
+	}
+
+	std::size_t VirtualMemoryArena::PageSize()
+	{
+#ifdef _WIN32
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+
+		return info.dwPageSize;
+#else
+		return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+}
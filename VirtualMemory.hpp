@@ -0,0 +1,69 @@
+#ifndef VIRTUAL_MEMORY_HPP
+#define VIRTUAL_MEMORY_HPP
+
+#include "ClassHelper.h"
+#include <cstddef> // size_t
+
+/*
+VirtualMemoryArena - a buffer backed directly by virtual memory (mmap() / VirtualAlloc()).
+The address space is reserved once and the pages are committed lazily as the arena grows,
+so a big arena costs physical memory only for what is really used.
+
+OPTIONS:
+- useHugePages - madvise(MADV_HUGEPAGE), fewer TLB misses for big arenas (Linux only)
+- prefault - commit and touch all the pages at once (MAP_POPULATE), no page faults later
+- releaseOnReset - Decommit() gives the pages back to the OS (MADV_DONTNEED)
+- commitGranularity - how much is committed at once when the arena grows
+*/
+
+namespace SDA
+{
+	struct VirtualMemoryOptions
+	{
+		VirtualMemoryOptions()
+			: useHugePages(false), prefault(false), releaseOnReset(false), commitGranularity(DEFAULT_COMMIT_GRANULARITY)
+		{}
+
+		bool useHugePages;
+		bool prefault;
+		bool releaseOnReset;
+		std::size_t commitGranularity;
+
+		static const std::size_t DEFAULT_COMMIT_GRANULARITY = 64 * 1024;
+	};
+
+	class VirtualMemoryArena
+	{
+	public:
+		VirtualMemoryArena();
+		virtual ~VirtualMemoryArena();
+
+		// reserves the address space, returns false if it fails
+		bool Reserve(const std::size_t size, const VirtualMemoryOptions& options);
+		void Release();
+
+		// makes sure the first size bytes can be used, returns false if it fails
+		bool Commit(const std::size_t size);
+		// gives all the committed pages back to the OS, the next use sees zeroed memory
+		void Decommit();
+
+		void* Base() const;
+		std::size_t Reserved() const;
+		std::size_t Committed() const;
+		const VirtualMemoryOptions& Options() const;
+
+		static std::size_t PageSize();
+
+	private:
+		NON_COPY_AND_MOVE(VirtualMemoryArena)
+
+		void* mBase;
+		std::size_t mReserved;
+		std::size_t mCommitted;
+		VirtualMemoryOptions mOptions;
+
+		static const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+	};
+}
+
+#endif /* VIRTUAL_MEMORY_HPP */
\ No newline at end of file